@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fmt/format.h>
+#include <omp.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "deposit.h"
+#include "vector.h"
+
+/*!
+ * particle trajectories shared by all strategies in units of voxels
+ * @note trajectories are grouped by the tile of their start position like sorted particles
+ */
+struct Trajectories {
+  /// positions at the start of the step
+  std::vector<std::array<fp_t, 3>> r0;
+
+  /// positions at the end of the step
+  std::vector<std::array<fp_t, 3>> r1;
+
+  /// index of the first trajectory of each tile followed by the total number of trajectories
+  std::vector<ui_t> tile_offsets;
+
+  /// number of voxels along each tile edge
+  ui_t tile = 0;
+
+  /// number of tiles along each axis
+  ui_t nt = 0;
+};
+
+/*!
+ * deposits all trajectories with one strategy
+ * @tparam O shape order
+ * @param reduce {true, false} for {tile-private buffers added onto the shared buffer, atomic updates of shared buffer}
+ * @param j current density
+ * @param tcs thread-private tile current densities
+ * @param t trajectories
+ * @param extent electric field voxel dimensions
+ * @return (s) wall time
+ */
+template <ui_t O>
+double run(const bool reduce, const Vector3<fp_t> &j, std::vector<TileCurrent> &tcs, const Trajectories &t,
+           const std::array<ui_t, 3> &extent) {
+  const std::array<fp_t, 3> coef = {1.0, 1.0, 1.0};
+  const std::array<ui_t, 3> walls = {0, 0, 0};
+  const auto start = std::chrono::high_resolution_clock::now();
+
+  if (reduce) {
+    const auto halo = static_cast<si_t>((tcs[0].j.x.extent(0) - t.tile - 1) / 2);
+
+#pragma omp parallel for schedule(dynamic)
+    for (ui_t tile = 0; tile < t.nt * t.nt * t.nt; ++tile) {
+      TileCurrent &tc = tcs[omp_get_thread_num()];
+      const std::array<ui_t, 3> ti = {tile / (t.nt * t.nt), tile / t.nt % t.nt, tile % t.nt};
+      for (ui_t a = 0; a < 3; ++a) {
+        tc.origin[a] = static_cast<si_t>(ti[a] * t.tile) - halo;
+      }
+
+      for (ui_t n = t.tile_offsets[tile]; n < t.tile_offsets[tile + 1]; ++n) {
+        if (!deposit_tile<O>(tc, t.r0[n], t.r1[n], coef)) {
+          deposit_esirkepov<O, true>(j, extent, walls, t.r0[n], t.r1[n], coef);
+        }
+      }
+      flush_tile(tc, j, extent, walls);
+    }
+  } else {
+#pragma omp parallel for schedule(static)
+    for (ui_t n = 0; n < t.r0.size(); ++n) {
+      deposit_esirkepov<O, true>(j, extent, walls, t.r0[n], t.r1[n], coef);
+    }
+  }
+
+  return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/*!
+ * benchmarks both strategies for one shape order and reports their rates and largest disagreement
+ * @tparam O shape order
+ * @param t trajectories
+ * @param n electric field voxels along each axis
+ * @param reps number of repetitions
+ * @return {0, 1} for {success, failure}
+ */
+template <ui_t O> int bench(const Trajectories &t, const ui_t n, const ui_t reps) {
+  const ui_t num = n * n * n;
+  const std::array<ui_t, 3> extent = {n, n, n};
+
+  // trajectories move at most one voxel and their stencils reach a further O / 2 + 2 voxels past their tile
+  const ui_t dim = t.tile + 2 * (1 + O / 2 + 2) + 1;
+
+  Vector3<fp_t> j_atomic, j_reduce;
+  std::vector<TileCurrent> tcs(static_cast<ui_t>(omp_get_max_threads()));
+  if (!j_atomic.init({n, n, n}, 0.0).has_value() || !j_reduce.init({n, n, n}, 0.0).has_value()) {
+    return 1;
+  }
+  for (auto &tc : tcs) {
+    if (!tc.j.init({dim, dim, dim}, 0.0).has_value()) {
+      return 1;
+    }
+  }
+
+  double t_atomic = 0.0, t_reduce = 0.0;
+  for (ui_t r = 0; r < reps; ++r) {
+    t_atomic += run<O>(false, j_atomic, tcs, t, extent);
+    t_reduce += run<O>(true, j_reduce, tcs, t, extent);
+  }
+
+  fp_t diff = 0.0, scale = 0.0;
+  for (ui_t idx = 0; idx < num; ++idx) {
+    diff = std::max({diff, std::abs(j_atomic.x_data[idx] - j_reduce.x_data[idx]),
+                     std::abs(j_atomic.y_data[idx] - j_reduce.y_data[idx]),
+                     std::abs(j_atomic.z_data[idx] - j_reduce.z_data[idx])});
+    scale = std::max({scale, std::abs(j_atomic.x_data[idx]), std::abs(j_atomic.y_data[idx]),
+                      std::abs(j_atomic.z_data[idx])});
+  }
+
+  const auto pushes = static_cast<double>(t.r0.size() * reps);
+  fmt::print("order {}  atomic {:.3e} particles/s  reduce {:.3e} particles/s  max relative difference {:.3e}\n", O,
+             pushes / t_atomic, pushes / t_reduce, scale > 0.0 ? diff / scale : 0.0);
+
+  j_atomic.reset();
+  j_reduce.reset();
+  for (auto &tc : tcs) {
+    tc.j.reset();
+  }
+
+  return 0;
+}
+
+/*!
+ * compares current deposition strategies on random trajectories
+ *
+ * usage: deposit_bench [voxels per axis] [particles per voxel] [repetitions] [tile size]
+ */
+int main(const int argc, char *argv[]) {
+  const ui_t n = argc > 1 ? std::stoull(argv[1]) : 64;
+  const ui_t ppc = argc > 2 ? std::stoull(argv[2]) : 8;
+  const ui_t reps = argc > 3 ? std::stoull(argv[3]) : 5;
+  const ui_t tile = argc > 4 ? std::stoull(argv[4]) : 8;
+
+  fmt::print("{} voxels per axis, {} particles per voxel, {} repetitions, {} voxel tiles, {} threads\n", n, ppc, reps,
+             tile, omp_get_max_threads());
+
+  // particles start in the interior and move at most half a voxel like a typical CFL limited step
+  std::mt19937_64 gen(0);
+  std::uniform_real_distribution<fp_t> pos(2.0, static_cast<fp_t>(n) - 3.0);
+  std::uniform_real_distribution<fp_t> step(-0.5, 0.5);
+
+  const ui_t num_particles = (n - 1) * (n - 1) * (n - 1) * ppc;
+  std::vector<std::array<fp_t, 3>> r0(num_particles), r1(num_particles);
+  for (ui_t p = 0; p < num_particles; ++p) {
+    r0[p] = {pos(gen), pos(gen), pos(gen)};
+    r1[p] = {r0[p][0] + step(gen), r0[p][1] + step(gen), r0[p][2] + step(gen)};
+  }
+
+  // counting sort by the tile of the start position
+  Trajectories t;
+  t.tile = tile;
+  t.nt = (n + tile - 1) / tile;
+  const auto tile_of = [&](const std::array<fp_t, 3> &r) {
+    return (static_cast<ui_t>(r[0]) / tile * t.nt + static_cast<ui_t>(r[1]) / tile) * t.nt +
+           static_cast<ui_t>(r[2]) / tile;
+  };
+  t.tile_offsets.assign(t.nt * t.nt * t.nt + 1, 0);
+  for (const auto &r : r0) {
+    ++t.tile_offsets[tile_of(r) + 1];
+  }
+  for (ui_t c = 1; c < t.tile_offsets.size(); ++c) {
+    t.tile_offsets[c] += t.tile_offsets[c - 1];
+  }
+  std::vector<ui_t> next(t.tile_offsets.begin(), t.tile_offsets.end() - 1);
+  t.r0.resize(num_particles);
+  t.r1.resize(num_particles);
+  for (ui_t p = 0; p < num_particles; ++p) {
+    const ui_t dst = next[tile_of(r0[p])]++;
+    t.r0[dst] = r0[p];
+    t.r1[dst] = r1[p];
+  }
+
+  return bench<0>(t, n, reps) | bench<1>(t, n, reps) | bench<2>(t, n, reps) | bench<3>(t, n, reps);
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "collision.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+std::expected<void, std::string> CrossSections::init(const std::filesystem::path &path) noexcept {
+  SPDLOG_TRACE("enter CrossSections::init");
+
+  reset();
+
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    const auto error = fmt::format("unable to open cross-section table `{}`", path.string());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  std::string line;
+  ui_t line_num = 0;
+  while (std::getline(file, line)) {
+    ++line_num;
+
+    const auto first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos || line[first] == '#') {
+      continue;
+    }
+
+    std::istringstream row(line);
+    fp_t e = 0.0;
+    std::array<fp_t, 3> s = {0.0, 0.0, 0.0};
+    if (!(row >> e >> s[0] >> s[1] >> s[2])) {
+      const auto error = fmt::format("line {} of cross-section table `{}` does not hold an energy and three "
+                                     "cross-sections",
+                                     line_num, path.string());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    if (e < 0.0 || (!energy.empty() && e <= energy.back()) || std::ranges::any_of(s, [](fp_t v) { return v < 0.0; })) {
+      const auto error = fmt::format("line {} of cross-section table `{}` has a negative value or an energy that is "
+                                     "not increasing",
+                                     line_num, path.string());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    energy.push_back(e);
+    sigma.push_back(s);
+  }
+
+  if (energy.empty()) {
+    const auto error = fmt::format("cross-section table `{}` is empty", path.string());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  SPDLOG_DEBUG("loaded {} cross-section rows from `{}` spanning (eV) {:.3e} to {:.3e}", energy.size(), path.string(),
+               energy.front(), energy.back());
+
+  SPDLOG_TRACE("exit CrossSections::init");
+  return {};
+}
+
+void CrossSections::reset() noexcept {
+  SPDLOG_TRACE("enter CrossSections::reset");
+
+  energy.clear();
+  sigma.clear();
+
+  SPDLOG_TRACE("exit CrossSections::reset");
+}
+
+std::array<fp_t, 3> CrossSections::at(const fp_t e) const noexcept {
+  if (e <= energy.front()) {
+    return sigma.front();
+  }
+  if (e >= energy.back()) {
+    return sigma.back();
+  }
+
+  const auto hi = static_cast<ui_t>(std::ranges::upper_bound(energy, e) - energy.begin());
+  const ui_t lo = hi - 1;
+  const fp_t t = (e - energy[lo]) / (energy[hi] - energy[lo]);
+
+  return {sigma[lo][0] + t * (sigma[hi][0] - sigma[lo][0]), sigma[lo][1] + t * (sigma[hi][1] - sigma[lo][1]),
+          sigma[lo][2] + t * (sigma[hi][2] - sigma[lo][2])};
+}
+
+fp_t CrossSections::max_frequency(const fp_t mass, const fp_t density) const noexcept {
+  SPDLOG_TRACE("enter CrossSections::max_frequency");
+
+  // cross-sections are linear between tabulated energies and speed increases with energy, so the larger end point
+  // cross-section times the speed at the upper energy of every interval bounds sigma v over that interval
+  fp_t nu_max = 0.0;
+  for (ui_t r = 0; r < energy.size(); ++r) {
+    const ui_t next = std::min(r + 1, static_cast<ui_t>(energy.size() - 1));
+    const fp_t sig =
+        std::max(sigma[r][0] + sigma[r][1] + sigma[r][2], sigma[next][0] + sigma[next][1] + sigma[next][2]);
+    const fp_t u = proper_speed(energy[next] * ELEC_CHARGE, mass);
+    const fp_t v = u / std::sqrt(static_cast<fp_t>(1.0) + u * u / (VAC_SPEED_OF_LIGHT * VAC_SPEED_OF_LIGHT));
+    nu_max = std::max(nu_max, density * sig * v);
+  }
+
+  SPDLOG_TRACE("exit CrossSections::max_frequency");
+  return nu_max;
+}
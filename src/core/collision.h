@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CORE_COLLISION_H
+#define CORE_COLLISION_H
+
+#include <array>
+#include <cmath>
+#include <expected>
+#include <filesystem>
+#include <numbers>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+#include "physical.h"
+#include "type.h"
+
+/*!
+ * tabulated electron-neutral cross-sections
+ *
+ * cross-sections are read from a whitespace separated text file with one row per energy in
+ * {energy (eV), elastic (m^2), excitation (m^2), ionization (m^2)} order, lines starting with `#` are ignored
+ *
+ * @note cross-sections are interpolated linearly and held constant outside of the tabulated energy range
+ */
+struct CrossSections {
+  /// (eV) tabulated energies in increasing order
+  std::vector<fp_t> energy;
+
+  /// (m^2) cross-sections at every tabulated energy in {elastic, excitation, ionization} order
+  std::vector<std::array<fp_t, 3>> sigma;
+
+  /*!
+   * initializes CrossSections from a file
+   * @param path path to cross-section table
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init(const std::filesystem::path &path) noexcept;
+
+  /*!
+   * resets CrossSections to default state
+   */
+  void reset() noexcept;
+
+  /*!
+   * interpolates cross-sections at a given energy
+   * @param e (eV) energy
+   * @return (m^2) cross-sections in {elastic, excitation, ionization} order
+   */
+  [[nodiscard]] std::array<fp_t, 3> at(fp_t e) const noexcept;
+
+  /*!
+   * upper bound of the total collision frequency used by the null-collision method
+   * @param mass (kg) mass of colliding particles
+   * @param density (m^-3) density of background gas
+   * @return (1/s) maximum total collision frequency over the tabulated energy range
+   * @note collision frequencies of particles above the tabulated range must be evaluated at the last tabulated energy
+   * for this bound to hold
+   */
+  [[nodiscard]] fp_t max_frequency(fp_t mass, fp_t density) const noexcept;
+};
+
+/*!
+ * kinetic energy of a particle
+ * @param ux (m/s) x-component of proper velocity
+ * @param uy (m/s) y-component of proper velocity
+ * @param uz (m/s) z-component of proper velocity
+ * @param mass (kg) mass of particle
+ * @return (J) kinetic energy
+ */
+inline fp_t kinetic_energy(const fp_t ux, const fp_t uy, const fp_t uz, const fp_t mass) noexcept {
+  constexpr fp_t c_sq = VAC_SPEED_OF_LIGHT * VAC_SPEED_OF_LIGHT;
+
+  // (gamma - 1) rewritten as u^2 / (c^2 (gamma + 1)) to avoid cancellation at low energies
+  const fp_t u_sq = ux * ux + uy * uy + uz * uz;
+  const fp_t gamma = std::sqrt(static_cast<fp_t>(1.0) + u_sq / c_sq);
+  return mass * u_sq / (gamma + static_cast<fp_t>(1.0));
+}
+
+/*!
+ * magnitude of proper velocity of a particle with a given kinetic energy
+ * @param energy (J) kinetic energy
+ * @param mass (kg) mass of particle
+ * @return (m/s) magnitude of proper velocity
+ */
+inline fp_t proper_speed(const fp_t energy, const fp_t mass) noexcept {
+  constexpr fp_t c_sq = VAC_SPEED_OF_LIGHT * VAC_SPEED_OF_LIGHT;
+
+  // u^2 = (gamma^2 - 1) c^2 with gamma - 1 = energy / (m c^2)
+  const fp_t g1 = energy / (mass * c_sq);
+  return VAC_SPEED_OF_LIGHT * std::sqrt(g1 * (g1 + static_cast<fp_t>(2.0)));
+}
+
+/*!
+ * isotropically oriented vector
+ * @param mag magnitude of vector
+ * @param r0 uniform random number in (0, 1] selecting the polar angle
+ * @param r1 uniform random number in (0, 1] selecting the azimuthal angle
+ * @return vector of magnitude mag pointing in a direction uniformly distributed over the unit sphere
+ */
+inline std::array<fp_t, 3> isotropic(const fp_t mag, const fp_t r0, const fp_t r1) noexcept {
+  const fp_t cos_t = static_cast<fp_t>(1.0) - static_cast<fp_t>(2.0) * r0;
+  const fp_t sin_t = std::sqrt(std::max(static_cast<fp_t>(1.0) - cos_t * cos_t, static_cast<fp_t>(0.0)));
+  const fp_t phi = static_cast<fp_t>(2.0) * std::numbers::pi_v<fp_t> * r1;
+
+  return {mag * sin_t * std::cos(phi), mag * sin_t * std::sin(phi), mag * cos_t};
+}
+
+/*!
+ * velocity change of a binary Coulomb collision following Takizuka and Abe (1977)
+ * @param u (m/s) relative velocity of the pair
+ * @param var variance of tan(theta / 2) of the scattering angle theta
+ * @param g standard normal random number
+ * @param r uniform random number in (0, 1] selecting the azimuthal angle
+ * @return (m/s) change of relative velocity, the first particle changes by m_r / m_1 and the second by -m_r / m_2 times
+ * this where m_r is the reduced mass
+ */
+inline std::array<fp_t, 3> coulomb_delta(const std::array<fp_t, 3> &u, const fp_t var, const fp_t g,
+                                         const fp_t r) noexcept {
+  const fp_t delta = g * std::sqrt(var);
+  const fp_t sin_t = static_cast<fp_t>(2.0) * delta / (static_cast<fp_t>(1.0) + delta * delta);
+  const fp_t one_cos = static_cast<fp_t>(2.0) * delta * delta / (static_cast<fp_t>(1.0) + delta * delta);
+  const fp_t phi = static_cast<fp_t>(2.0) * std::numbers::pi_v<fp_t> * r;
+  const fp_t cos_p = std::cos(phi);
+  const fp_t sin_p = std::sin(phi);
+
+  const fp_t u_perp = std::sqrt(u[0] * u[0] + u[1] * u[1]);
+  const fp_t u_mag = std::sqrt(u_perp * u_perp + u[2] * u[2]);
+
+  if (u_perp > 0.0) {
+    return {u[0] / u_perp * u[2] * sin_t * cos_p - u[1] / u_perp * u_mag * sin_t * sin_p - u[0] * one_cos,
+            u[1] / u_perp * u[2] * sin_t * cos_p + u[0] / u_perp * u_mag * sin_t * sin_p - u[1] * one_cos,
+            -u_perp * sin_t * cos_p - u[2] * one_cos};
+  }
+
+  return {u_mag * sin_t * cos_p, u_mag * sin_t * sin_p, -u_mag * one_cos};
+}
+
+#endif // CORE_COLLISION_H
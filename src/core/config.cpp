@@ -17,11 +17,55 @@
 
 #include "config.h"
 
+#include <algorithm>
 #include <expected>
 
+#include "physical.h"
+
 std::expected<void, std::string> Config::init(const std::string &input_file_path) noexcept {
   SPDLOG_TRACE("enter Config::init");
 
+  const auto config = read(input_file_path);
+  if (!config.has_value()) {
+    SPDLOG_CRITICAL(config.error());
+    return std::unexpected(config.error());
+  }
+
+  if (const auto result = init(config.value()); !result.has_value()) {
+    SPDLOG_CRITICAL(result.error());
+    return std::unexpected(result.error());
+  }
+
+  SPDLOG_TRACE("exit Config::init");
+  return {};
+}
+
+std::expected<void, std::string> Config::init(const toml::basic_value<toml::type_config> &config) noexcept {
+  SPDLOG_TRACE("enter Config::init");
+
+  if (const auto result = parse_from_toml(config); !result.has_value()) {
+    const std::string error = fmt::format("failed to parse configuration file: {}", result.error());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  if (const auto result = validate(); !result.has_value()) {
+    const std::string error = fmt::format("failed to validate initial state: {}", result.error());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  SPDLOG_INFO("configuration summary");
+  summarize();
+
+  SPDLOG_TRACE("exit Config::init");
+  return {};
+}
+
+std::expected<toml::basic_value<toml::type_config>, std::string>
+Config::read(const std::string &input_file_path) noexcept {
+  SPDLOG_TRACE("enter Config::read");
+
   std::filesystem::path input_file;
   try {
     input_file = std::filesystem::canonical(input_file_path);
@@ -50,35 +94,17 @@ std::expected<void, std::string> Config::init(const std::string &input_file_path
   }
   SPDLOG_DEBUG("input file path `{}` successfully verified", input_file.string());
 
-  if (const auto parse_result = toml::try_parse(input_file); parse_result.is_ok()) {
-    SPDLOG_DEBUG("input file `{}` is valid toml", input_file.string());
-
-    const auto &config = parse_result.unwrap();
-
-    if (const auto result = parse_from_toml(config); !result.has_value()) {
-      const std::string error = fmt::format("failed to parse configuration file: {}", result.error());
-      SPDLOG_CRITICAL(error);
-      return std::unexpected(error);
-    }
-
-  } else {
+  auto parse_result = toml::try_parse(input_file);
+  if (!parse_result.is_ok()) {
     const std::string error =
         fmt::format("failed to parse config file `{}` ... provided file contains invalid toml", input_file.string());
     SPDLOG_CRITICAL(error);
     return std::unexpected(error);
   }
+  SPDLOG_DEBUG("input file `{}` is valid toml", input_file.string());
 
-  if (const auto result = validate(); !result.has_value()) {
-    const std::string error = fmt::format("failed to validate initial state: {}", result.error());
-    SPDLOG_CRITICAL(error);
-    return std::unexpected(error);
-  }
-
-  SPDLOG_INFO("configuration summary");
-  summarize();
-
-  SPDLOG_TRACE("exit Config::init");
-  return {};
+  SPDLOG_TRACE("exit Config::read with success");
+  return std::move(parse_result.unwrap());
 }
 
 void Config::reset() noexcept {
@@ -87,6 +113,8 @@ void Config::reset() noexcept {
 
   end_time = 0.0;
   len = {0.0, 0.0, 0.0};
+  mode = Mode::D3;
+  num_modes = 0;
   max_frequency = 0.0;
   num_vox_min_wavelength = 0;
   num_vox_min_feature = 0;
@@ -95,6 +123,45 @@ void Config::reset() noexcept {
   sigma = 0.0;
   out = std::filesystem::path("/dev/null");
   log_period = 0.0;
+  engine = Engine::YEE;
+  pusher = Pusher::BORIS;
+  shape_order = 0;
+  deposit = Deposit::REDUCE;
+  sort_period = 0;
+  tile_size = 0;
+  task_graph = false;
+  resample_period = 0;
+  poisson_tolerance = 0.0;
+  poisson_cycles = 0;
+  clean_period = 0;
+  balance_period = 0;
+  balance_threshold = 0.0;
+  activity_period = 0;
+  activity_threshold = 0.0;
+  window_velocity = 0.0;
+  window_spare = 0;
+  converge_period = 0;
+  converge_criterion = Criterion::DECAY;
+  converge_threshold = 0.0;
+  converge_checks = 0;
+  sampling = Sampling::NONE;
+  max_samples = 0;
+  bins = 0;
+  u_max = 0.0;
+  energy_max = 0.0;
+  merge_above = 0;
+  split_below = 0;
+  boundary.fill(Boundary::PEC);
+  bloch_phase = {0.0, 0.0, 0.0};
+  species.clear();
+  mcc = MccConfig();
+  coulomb.clear();
+  material_file.clear();
+  material_dataset.clear();
+  materials.clear();
+  objects.clear();
+  dispersive.clear();
+  ensemble.clear();
 
   summarize();
 
@@ -106,6 +173,12 @@ void Config::summarize() noexcept {
 
   SPDLOG_INFO("end time (s): {:.3e}", end_time);
   SPDLOG_INFO("bounding box (m): {:.3e} x {:.3e} x {:.3e}", len.x, len.y, len.z);
+  SPDLOG_INFO("dimensionality: {}", mode == Mode::D3      ? "3d"
+                                    : mode == Mode::D2_TE ? "2d_te"
+                                    : mode == Mode::D2_TM ? "2d_tm"
+                                    : mode == Mode::D1    ? "1d"
+                                                          : "rz");
+  SPDLOG_INFO("number of azimuthal modes: {}", num_modes);
   SPDLOG_INFO("maximum frequency to resolve (Hz): {:.3e}", max_frequency);
   SPDLOG_INFO("number of voxels to resolve minimum wavelength: {}", num_vox_min_wavelength);
   SPDLOG_INFO("number of voxels to resolve minimum feature size: {}", num_vox_min_feature);
@@ -114,10 +187,104 @@ void Config::summarize() noexcept {
   SPDLOG_INFO("bounding box conductivity (S / m): {:.3e}", sigma);
   SPDLOG_INFO("path to store output data: {}", out.string());
   SPDLOG_INFO("period between logging steps {:.3e}", log_period);
+  SPDLOG_INFO("field solver: {}", engine == Engine::PSATD ? "psatd" : "yee");
+  SPDLOG_INFO("particle pusher: {}", pusher == Pusher::HIGUERA_CARY ? "higuera_cary" : "boris");
+  SPDLOG_INFO("particle shape order: {}", shape_order);
+  SPDLOG_INFO("current deposition: {}", deposit == Deposit::ATOMIC    ? "atomic"
+                                        : deposit == Deposit::COLORED ? "colored"
+                                                                      : "reduce");
+  SPDLOG_INFO("steps between particle sorts: {}", sort_period);
+  SPDLOG_INFO("particle tile size (voxels): {}", tile_size);
+  SPDLOG_INFO("field task graph: {}", task_graph ? "enabled" : "disabled");
+  SPDLOG_INFO("steps between particle resampling: {}", resample_period);
+  SPDLOG_INFO("particles per voxel to merge above: {}", merge_above);
+  SPDLOG_INFO("particles per voxel to split below: {}", split_below);
+  SPDLOG_INFO("poisson relative tolerance: {:.3e}", poisson_tolerance);
+  SPDLOG_INFO("maximum poisson multigrid cycles: {}", poisson_cycles);
+  SPDLOG_INFO("steps between divergence cleaning: {}", clean_period);
+  SPDLOG_INFO("steps between load balance checks: {}", balance_period);
+  SPDLOG_INFO("load imbalance threshold: {:.3e}", balance_threshold);
+  SPDLOG_INFO("steps between field activity updates: {}", activity_period);
+  SPDLOG_INFO("field activity threshold: {:.3e}", activity_threshold);
+  SPDLOG_INFO("moving window velocity (m/s): {:.3e}", window_velocity);
+  SPDLOG_INFO("moving window spare planes: {}", window_spare);
+  SPDLOG_INFO("steps between field energy reductions: {}", converge_period);
+  SPDLOG_INFO("early termination criterion: {}", converge_criterion == Criterion::PLATEAU ? "plateau" : "decay");
+  SPDLOG_INFO("early termination threshold: {:.3e}", converge_threshold);
+  SPDLOG_INFO("consecutive reductions to meet early termination criterion: {}", converge_checks);
+  SPDLOG_INFO("particle sampling: {}", sampling == Sampling::STRIDE   ? "stride"
+                                       : sampling == Sampling::RANDOM ? "random"
+                                                                      : "none");
+  SPDLOG_INFO("maximum particle samples per species: {}", max_samples);
+  SPDLOG_INFO("particle histogram bins: {}", bins);
+  SPDLOG_INFO("phase-space proper velocity bound (m/s): {:.3e}", u_max);
+  SPDLOG_INFO("energy spectrum bound (eV): {:.3e}", energy_max);
+  for (ui_t f = 0; f < boundary.size(); ++f) {
+    SPDLOG_INFO("{} boundary: {}", FACE_NAMES[f], boundary[f] == Boundary::PMC        ? "pmc"
+                                                  : boundary[f] == Boundary::PERIODIC ? "periodic"
+                                                  : boundary[f] == Boundary::BLOCH    ? "bloch"
+                                                                                      : "pec");
+  }
+  SPDLOG_INFO("bloch phase shifts (rad): {:.3e} x {:.3e} x {:.3e}", bloch_phase[0], bloch_phase[1], bloch_phase[2]);
+  SPDLOG_INFO("number of particle species: {}", species.size());
+  for (const auto &s : species) {
+    SPDLOG_INFO("species `{}`: charge (C) {:.3e}, mass (kg) {:.3e}, density (m^-3) {:.3e}, temperature (eV) {:.3e}, "
+                "particles per voxel {}",
+                s.name, s.charge, s.mass, s.density, s.temperature, s.ppc);
+  }
+  if (!mcc.species.empty()) {
+    SPDLOG_INFO("monte carlo collisions of species `{}` with ions into `{}` using cross-sections from {}", mcc.species,
+                mcc.ion_species, mcc.cross_sections.string());
+    SPDLOG_INFO("background gas: density (m^-3) {:.3e}, mass (kg) {:.3e}, temperature (eV) {:.3e}", mcc.gas_density,
+                mcc.gas_mass, mcc.gas_temperature);
+    SPDLOG_INFO("collision energy losses (eV): excitation {:.3e}, ionization {:.3e}", mcc.excitation_energy,
+                mcc.ionization_energy);
+    SPDLOG_INFO("collision random seed: {}", mcc.seed);
+  }
+  if (!material_file.empty()) {
+    SPDLOG_INFO("material ID volume: dataset `{}` of {}", material_dataset, material_file.string());
+  }
+  for (const auto &mc : materials) {
+    SPDLOG_INFO("material `{}`: relative permittivity {:.3e}, conductivity (S/m) {:.3e}", mc.name, mc.ep_r, mc.sigma);
+  }
+  for (const auto &oc : objects) {
+    SPDLOG_INFO("{} of material `{}`: corners (m) ({:.3e}, {:.3e}, {:.3e}) to ({:.3e}, {:.3e}, {:.3e}), center (m) "
+                "({:.3e}, {:.3e}, {:.3e}), radius (m) {:.3e}, mesh `{}` scale (m) {:.3e}",
+                oc.shape == Shape::SPHERE     ? "sphere"
+                : oc.shape == Shape::CYLINDER ? "cylinder"
+                : oc.shape == Shape::STL      ? "stl"
+                                              : "box",
+                oc.material, oc.lo.x, oc.lo.y, oc.lo.z, oc.hi.x, oc.hi.y, oc.hi.z, oc.center.x, oc.center.y,
+                oc.center.z, oc.radius, oc.path.string(), oc.scale);
+  }
+  for (const auto &dc : dispersive) {
+    SPDLOG_INFO("{} pole over box (m) [{:.3e}, {:.3e}] x [{:.3e}, {:.3e}] x [{:.3e}, {:.3e}]: delta_ep {:.3e}, "
+                "omega_p (rad/s) {:.3e}, omega_0 (rad/s) {:.3e}, gamma (1/s) {:.3e}, tau (s) {:.3e}",
+                dc.pole == Pole::LORENTZ ? "lorentz"
+                : dc.pole == Pole::DEBYE ? "debye"
+                                         : "drude",
+                dc.lo.x, dc.hi.x, dc.lo.y, dc.hi.y, dc.lo.z, dc.hi.z, dc.delta_ep, dc.omega_p, dc.omega_0, dc.gamma,
+                dc.tau);
+  }
+  for (const auto &ec : ensemble) {
+    SPDLOG_INFO("ensemble member: relative permittivity {:.3e}, relative permeability {:.3e}, conductivity (S/m) "
+                "{:.3e}, source amplitude (A/m^2) {:.3e} at (m) {:.3e} x {:.3e} x {:.3e}",
+                ec.ep_r, ec.mu_r, ec.sigma, ec.amplitude, ec.source.x, ec.source.y, ec.source.z);
+  }
+  for (const auto &c : coulomb) {
+    SPDLOG_INFO("coulomb collisions of species `{}` and `{}`: coulomb logarithm {:.3e}, steps between collisions {}",
+                c.species_a, c.species_b, c.coulomb_log, c.period);
+  }
 
   SPDLOG_DEBUG("exit Config::summarize");
 }
 
+bool Config::wraps(const bool bloch) const noexcept {
+  return std::ranges::any_of(boundary, [bloch](const Boundary b) {
+    return b == Boundary::BLOCH || (!bloch && b == Boundary::PERIODIC);
+  });
+}
+
 std::expected<void, std::string> Config::parse_from_toml(const toml::basic_value<toml::type_config> &config) noexcept {
   SPDLOG_TRACE("enter Config::parse_from");
 
@@ -150,6 +317,34 @@ std::expected<void, std::string> Config::parse_from_toml(const toml::basic_value
 
   len = {x_len, y_len, z_len};
 
+  if (auto result = parse_optional<std::string>(config, "geometry", "mode", "3d"); result.has_value()) {
+    if (result.value() == "3d") {
+      mode = Mode::D3;
+    } else if (result.value() == "2d_te") {
+      mode = Mode::D2_TE;
+    } else if (result.value() == "2d_tm") {
+      mode = Mode::D2_TM;
+    } else if (result.value() == "1d") {
+      mode = Mode::D1;
+    } else if (result.value() == "rz") {
+      mode = Mode::RZ;
+    } else {
+      const std::string error = fmt::format(
+          "`[geometry] mode` has unknown value `{}` ... expected one of `3d`, `2d_te`, `2d_tm`, `1d`, or `rz`",
+          result.value());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  } else {
+    return std::unexpected(result.error());
+  }
+
+  if (auto result = parse_optional<ui_t>(config, "geometry", "num_modes", static_cast<ui_t>(1)); result.has_value()) {
+    num_modes = result.value();
+  } else {
+    return std::unexpected(result.error());
+  }
+
   if (auto result = parse_item<fp_t>(config, "geometry", "max_frequency"); result.has_value()) {
     max_frequency = result.value();
   } else {
@@ -168,24 +363,39 @@ std::expected<void, std::string> Config::parse_from_toml(const toml::basic_value
     return std::unexpected(result.error());
   }
 
-  if (auto result = parse_item<fp_t>(config, "geometry", "ep_r"); result.has_value()) {
+  if (auto result = parse_item<fp_t>(config, "material", "ep_r"); result.has_value()) {
     ep_r = result.value();
   } else {
     return std::unexpected(result.error());
   }
 
-  if (auto result = parse_item<fp_t>(config, "geometry", "mu_r"); result.has_value()) {
+  if (auto result = parse_item<fp_t>(config, "material", "mu_r"); result.has_value()) {
     mu_r = result.value();
   } else {
     return std::unexpected(result.error());
   }
 
-  if (auto result = parse_item<fp_t>(config, "geometry", "sigma"); result.has_value()) {
+  if (auto result = parse_item<fp_t>(config, "material", "sigma"); result.has_value()) {
     sigma = result.value();
   } else {
     return std::unexpected(result.error());
   }
 
+  // a precomputed material ID volume is optional but needs both its file and dataset
+  if (config.at("geometry").contains("material_file")) {
+    if (auto result = parse_item<std::string>(config, "geometry", "material_file"); result.has_value()) {
+      material_file = std::filesystem::path(result.value());
+    } else {
+      return std::unexpected(result.error());
+    }
+
+    if (auto result = parse_item<std::string>(config, "geometry", "material_dataset"); result.has_value()) {
+      material_dataset = result.value();
+    } else {
+      return std::unexpected(result.error());
+    }
+  }
+
   std::string out_dir_str;
   if (auto result = parse_item<std::string>(config, "data", "out_dir"); result.has_value()) {
     out_dir_str = result.value();
@@ -200,112 +410,1342 @@ std::expected<void, std::string> Config::parse_from_toml(const toml::basic_value
     return std::unexpected(result.error());
   }
 
-  SPDLOG_TRACE("exit Config::parse_from");
-  return {};
-}
+  if (auto result = parse_optional<std::string>(config, "solver", "engine", "yee"); result.has_value()) {
+    if (result.value() == "yee") {
+      engine = Engine::YEE;
+    } else if (result.value() == "psatd") {
+      engine = Engine::PSATD;
+    } else {
+      const std::string error =
+          fmt::format("`[solver] engine` has unknown value `{}` ... expected one of `yee` or `psatd`", result.value());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  } else {
+    return std::unexpected(result.error());
+  }
 
-std::expected<void, std::string> Config::validate() noexcept {
-  SPDLOG_TRACE("enter Config::validate");
+  if (auto result = parse_optional<std::string>(config, "solver", "pusher", "boris"); result.has_value()) {
+    if (result.value() == "boris") {
+      pusher = Pusher::BORIS;
+    } else if (result.value() == "higuera_cary") {
+      pusher = Pusher::HIGUERA_CARY;
+    } else {
+      const std::string error = fmt::format(
+          "`[solver] pusher` has unknown value `{}` ... expected one of `boris` or `higuera_cary`", result.value());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  } else {
+    return std::unexpected(result.error());
+  }
 
-  if (!in_range(end_time, 0.0, std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
-    const std::string error = fmt::format("`end_time` is not within accepted range ... please correct and rerun");
-    SPDLOG_CRITICAL(error);
-    return std::unexpected(error);
+  if (auto result = parse_optional<ui_t>(config, "solver", "shape_order", static_cast<ui_t>(1)); result.has_value()) {
+    shape_order = result.value();
+  } else {
+    return std::unexpected(result.error());
   }
-  SPDLOG_DEBUG("`end_time` passed all checks");
 
-  if (!in_range(len.x, 0.0, std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
-    const std::string error = fmt::format("`x_len` is not within accepted range ... please correct and rerun");
-    SPDLOG_CRITICAL(error);
-    return std::unexpected(error);
+  if (auto result = parse_optional<ui_t>(config, "solver", "sort_period", static_cast<ui_t>(0)); result.has_value()) {
+    sort_period = result.value();
+  } else {
+    return std::unexpected(result.error());
   }
-  SPDLOG_DEBUG("`x_len` passed all checks");
 
-  if (!in_range(len.y, 0.0, std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
-    const std::string error = fmt::format("`y_len` is not within accepted range ... please correct and rerun");
-    SPDLOG_CRITICAL(error);
-    return std::unexpected(error);
+  if (auto result = parse_optional<ui_t>(config, "solver", "tile_size", static_cast<ui_t>(8)); result.has_value()) {
+    tile_size = result.value();
+  } else {
+    return std::unexpected(result.error());
   }
-  SPDLOG_DEBUG("`y_len` passed all checks");
 
-  if (!in_range(len.z, 0.0, std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
-    const std::string error = fmt::format("`z_len` is not within accepted range ... please correct and rerun");
-    SPDLOG_CRITICAL(error);
-    return std::unexpected(error);
+  if (auto result = parse_optional<bool>(config, "solver", "task_graph", false); result.has_value()) {
+    task_graph = result.value();
+  } else {
+    return std::unexpected(result.error());
   }
-  SPDLOG_DEBUG("`z_len` passed all checks");
 
-  if (!in_range(max_frequency, 0.0, std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
-    const std::string error = fmt::format("`max_frequency` is not within accepted range ... please correct and rerun");
-    SPDLOG_CRITICAL(error);
-    return std::unexpected(error);
+  if (auto result = parse_optional<fp_t>(config, "poisson", "tolerance", POISSON_TOLERANCE); result.has_value()) {
+    poisson_tolerance = result.value();
+  } else {
+    return std::unexpected(result.error());
   }
-  SPDLOG_DEBUG("`max_frequency` passed all checks");
 
-  if (!in_range(num_vox_min_wavelength, static_cast<ui_t>(0), std::numeric_limits<ui_t>::max(), Bounds::EXCL_INCL)) {
-    const std::string error =
-        fmt::format("`num_vox_min_wavelength` is not within accepted range ... please correct and rerun");
-    SPDLOG_CRITICAL(error);
-    return std::unexpected(error);
+  if (auto result = parse_optional<ui_t>(config, "poisson", "max_cycles", static_cast<ui_t>(50)); result.has_value()) {
+    poisson_cycles = result.value();
+  } else {
+    return std::unexpected(result.error());
   }
-  SPDLOG_DEBUG("`num_vox_min_wavelength` passed all checks");
 
-  if (!in_range(num_vox_min_feature, static_cast<ui_t>(0), std::numeric_limits<ui_t>::max(), Bounds::EXCL_INCL)) {
-    const std::string error =
-        fmt::format("`num_vox_min_feature` is not within accepted range ... please correct and rerun");
-    SPDLOG_CRITICAL(error);
-    return std::unexpected(error);
+  if (auto result = parse_optional<ui_t>(config, "poisson", "clean_period", static_cast<ui_t>(0)); result.has_value()) {
+    clean_period = result.value();
+  } else {
+    return std::unexpected(result.error());
   }
-  SPDLOG_DEBUG("`num_vox_min_feature` passed all checks");
 
-  if (!in_range(ep_r, 0.0, std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
-    const std::string error = fmt::format("`ep_r` is not within accepted range ... please correct and rerun");
-    SPDLOG_CRITICAL(error);
-    return std::unexpected(error);
+  if (auto result = parse_optional<ui_t>(config, "balance", "period", static_cast<ui_t>(0)); result.has_value()) {
+    balance_period = result.value();
+  } else {
+    return std::unexpected(result.error());
   }
-  SPDLOG_DEBUG("`ep_r` passed all checks");
 
-  if (!in_range(mu_r, 0.0, std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
-    const std::string error = fmt::format("`mu_r` is not within accepted range ... please correct and rerun");
-    SPDLOG_CRITICAL(error);
-    return std::unexpected(error);
+  if (auto result = parse_optional<fp_t>(config, "balance", "threshold", static_cast<fp_t>(1.2)); result.has_value()) {
+    balance_threshold = result.value();
+  } else {
+    return std::unexpected(result.error());
   }
-  SPDLOG_DEBUG("`mu_r` passed all checks");
 
-  if (!in_range(sigma, 0.0, std::numeric_limits<fp_t>::max(), Bounds::INCL)) {
-    const std::string error = fmt::format("`sigma` is not within accepted range ... please correct and rerun");
-    SPDLOG_CRITICAL(error);
-    return std::unexpected(error);
+  if (auto result = parse_optional<ui_t>(config, "activity", "period", static_cast<ui_t>(0)); result.has_value()) {
+    activity_period = result.value();
+  } else {
+    return std::unexpected(result.error());
   }
-  SPDLOG_DEBUG("`sigma` passed all checks");
 
-  const auto out_str = out.string();
-  try {
-    out = std::filesystem::canonical(out);
-    SPDLOG_DEBUG("`out_dir` successfully canonicalized with value`{}`", out.string());
-  } catch (const std::filesystem::filesystem_error &err) {
-    const std::string error =
-        fmt::format("unable to canonicalize `out_dir` with path `{}`: {} ... please ensure you are using either an "
-                    "absolute path or the appropriate relative path from your current working directory",
-                    out.string(), err.what());
-    SPDLOG_CRITICAL(error);
-    return std::unexpected(error);
+  if (auto result = parse_optional<fp_t>(config, "activity", "threshold", static_cast<fp_t>(0.0)); result.has_value()) {
+    activity_threshold = result.value();
+  } else {
+    return std::unexpected(result.error());
   }
 
-  if (!std::filesystem::is_directory(out)) {
-    const std::string error =
-        fmt::format("path `out_dir` with path `{}`: is not a directory on this filesystem ... please correct and rerun",
-                    out.string());
-    SPDLOG_CRITICAL(error);
-    return std::unexpected(error);
+  if (auto result = parse_optional<fp_t>(config, "window", "velocity", static_cast<fp_t>(0.0)); result.has_value()) {
+    window_velocity = result.value();
+  } else {
+    return std::unexpected(result.error());
   }
 
-  if (!in_range(log_period, static_cast<fp_t>(0), std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
-    const std::string error = fmt::format("`log_period` is not within accepted range ... please correct and rerun");
-    SPDLOG_CRITICAL(error);
-    return std::unexpected(error);
+  if (auto result = parse_optional<ui_t>(config, "window", "spare_planes", static_cast<ui_t>(64)); result.has_value()) {
+    window_spare = result.value();
+  } else {
+    return std::unexpected(result.error());
   }
-  SPDLOG_DEBUG("`log_period` passed all checks");
+
+  if (auto result = parse_optional<ui_t>(config, "convergence", "period", static_cast<ui_t>(0)); result.has_value()) {
+    converge_period = result.value();
+  } else {
+    return std::unexpected(result.error());
+  }
+
+  if (auto result = parse_optional<std::string>(config, "convergence", "criterion", "decay"); result.has_value()) {
+    if (result.value() == "decay") {
+      converge_criterion = Criterion::DECAY;
+    } else if (result.value() == "plateau") {
+      converge_criterion = Criterion::PLATEAU;
+    } else {
+      const std::string error = fmt::format(
+          "`[convergence] criterion` has unknown value `{}` ... expected one of `decay` or `plateau`", result.value());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  } else {
+    return std::unexpected(result.error());
+  }
+
+  if (auto result = parse_optional<fp_t>(config, "convergence", "threshold", static_cast<fp_t>(1e-6));
+      result.has_value()) {
+    converge_threshold = result.value();
+  } else {
+    return std::unexpected(result.error());
+  }
+
+  if (auto result = parse_optional<ui_t>(config, "convergence", "checks", static_cast<ui_t>(3)); result.has_value()) {
+    converge_checks = result.value();
+  } else {
+    return std::unexpected(result.error());
+  }
+
+  if (auto result = parse_optional<std::string>(config, "diagnostics", "sampling", "none"); result.has_value()) {
+    if (result.value() == "none") {
+      sampling = Sampling::NONE;
+    } else if (result.value() == "stride") {
+      sampling = Sampling::STRIDE;
+    } else if (result.value() == "random") {
+      sampling = Sampling::RANDOM;
+    } else {
+      const std::string error = fmt::format(
+          "`[diagnostics] sampling` has unknown value `{}` ... expected one of `none`, `stride`, or `random`",
+          result.value());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  } else {
+    return std::unexpected(result.error());
+  }
+
+  if (auto result = parse_optional<ui_t>(config, "diagnostics", "max_samples", static_cast<ui_t>(0));
+      result.has_value()) {
+    max_samples = result.value();
+  } else {
+    return std::unexpected(result.error());
+  }
+
+  if (auto result = parse_optional<ui_t>(config, "diagnostics", "bins", static_cast<ui_t>(64)); result.has_value()) {
+    bins = result.value();
+  } else {
+    return std::unexpected(result.error());
+  }
+
+  if (auto result = parse_optional<fp_t>(config, "diagnostics", "u_max", static_cast<fp_t>(3e6)); result.has_value()) {
+    u_max = result.value();
+  } else {
+    return std::unexpected(result.error());
+  }
+
+  if (auto result = parse_optional<fp_t>(config, "diagnostics", "energy_max", static_cast<fp_t>(20.0));
+      result.has_value()) {
+    energy_max = result.value();
+  } else {
+    return std::unexpected(result.error());
+  }
+
+  if (auto result = parse_optional<ui_t>(config, "resample", "period", static_cast<ui_t>(0)); result.has_value()) {
+    resample_period = result.value();
+  } else {
+    return std::unexpected(result.error());
+  }
+
+  if (auto result = parse_optional<ui_t>(config, "resample", "merge_above", static_cast<ui_t>(64));
+      result.has_value()) {
+    merge_above = result.value();
+  } else {
+    return std::unexpected(result.error());
+  }
+
+  if (auto result = parse_optional<ui_t>(config, "resample", "split_below", static_cast<ui_t>(2)); result.has_value()) {
+    split_below = result.value();
+  } else {
+    return std::unexpected(result.error());
+  }
+
+  if (auto result = parse_optional<std::string>(config, "solver", "deposit", "reduce"); result.has_value()) {
+    if (result.value() == "reduce") {
+      deposit = Deposit::REDUCE;
+    } else if (result.value() == "atomic") {
+      deposit = Deposit::ATOMIC;
+    } else if (result.value() == "colored") {
+      deposit = Deposit::COLORED;
+    } else {
+      const std::string error = fmt::format(
+          "`[solver] deposit` has unknown value `{}` ... expected one of `reduce`, `atomic`, or `colored`",
+          result.value());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  } else {
+    return std::unexpected(result.error());
+  }
+
+  // the spectral advance of the psatd engine always wraps the domain so its faces default to what it does
+  const std::string default_face = engine == Engine::PSATD ? "periodic" : "pec";
+  for (ui_t f = 0; f < boundary.size(); ++f) {
+    if (auto result = parse_optional<std::string>(config, "boundary", FACE_NAMES[f], default_face);
+        result.has_value()) {
+      if (result.value() == "pec") {
+        boundary[f] = Boundary::PEC;
+      } else if (result.value() == "pmc") {
+        boundary[f] = Boundary::PMC;
+      } else if (result.value() == "periodic") {
+        boundary[f] = Boundary::PERIODIC;
+      } else if (result.value() == "bloch") {
+        boundary[f] = Boundary::BLOCH;
+      } else {
+        const std::string error = fmt::format("`[boundary] {}` has unknown value `{}` ... expected one of `pec`, "
+                                              "`pmc`, `periodic`, or `bloch`",
+                                              FACE_NAMES[f], result.value());
+        SPDLOG_CRITICAL(error);
+        return std::unexpected(error);
+      }
+    } else {
+      return std::unexpected(result.error());
+    }
+  }
+
+  for (ui_t a = 0; a < bloch_phase.size(); ++a) {
+    if (boundary[2 * a] != Boundary::BLOCH) {
+      continue;
+    }
+    const std::string key = fmt::format("{}_phase", "xyz"[a]);
+    if (auto result = parse_item<fp_t>(config, "boundary", key); result.has_value()) {
+      bloch_phase[a] = result.value();
+    } else {
+      return std::unexpected(result.error());
+    }
+  }
+
+  // particles are optional so a missing `[[species]]` array simply leaves the simulation field only
+  if (config.contains("species")) {
+    if (!config.at("species").is_array()) {
+      const std::string error = fmt::format("`species` must be an array of tables ... please use `[[species]]`");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    for (const auto &table : config.at("species").as_array()) {
+      if (!table.is_table()) {
+        const std::string error = fmt::format("`species` must be an array of tables ... please use `[[species]]`");
+        SPDLOG_CRITICAL(error);
+        return std::unexpected(error);
+      }
+
+      SpeciesConfig s;
+
+      if (auto result = parse_entry<std::string>(table, "[species]", "name"); result.has_value()) {
+        s.name = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[species]", "charge"); result.has_value()) {
+        s.charge = result.value() * ELEC_CHARGE;
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[species]", "mass"); result.has_value()) {
+        s.mass = result.value() * AMU;
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[species]", "density"); result.has_value()) {
+        s.density = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[species]", "temperature"); result.has_value()) {
+        s.temperature = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<ui_t>(table, "[species]", "ppc"); result.has_value()) {
+        s.ppc = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      species.push_back(std::move(s));
+    }
+  }
+
+  // collisions are optional so a missing `[mcc]` table leaves particles collisionless
+  if (config.contains("mcc")) {
+    if (auto result = parse_item<std::string>(config, "mcc", "species"); result.has_value()) {
+      mcc.species = result.value();
+    } else {
+      return std::unexpected(result.error());
+    }
+
+    if (auto result = parse_item<std::string>(config, "mcc", "ion_species"); result.has_value()) {
+      mcc.ion_species = result.value();
+    } else {
+      return std::unexpected(result.error());
+    }
+
+    if (auto result = parse_item<std::string>(config, "mcc", "cross_sections"); result.has_value()) {
+      mcc.cross_sections = std::filesystem::path(result.value());
+    } else {
+      return std::unexpected(result.error());
+    }
+
+    if (auto result = parse_item<fp_t>(config, "mcc", "gas_density"); result.has_value()) {
+      mcc.gas_density = result.value();
+    } else {
+      return std::unexpected(result.error());
+    }
+
+    if (auto result = parse_item<fp_t>(config, "mcc", "gas_mass"); result.has_value()) {
+      mcc.gas_mass = result.value() * AMU;
+    } else {
+      return std::unexpected(result.error());
+    }
+
+    if (auto result = parse_item<fp_t>(config, "mcc", "gas_temperature"); result.has_value()) {
+      mcc.gas_temperature = result.value();
+    } else {
+      return std::unexpected(result.error());
+    }
+
+    if (auto result = parse_item<fp_t>(config, "mcc", "excitation_energy"); result.has_value()) {
+      mcc.excitation_energy = result.value();
+    } else {
+      return std::unexpected(result.error());
+    }
+
+    if (auto result = parse_item<fp_t>(config, "mcc", "ionization_energy"); result.has_value()) {
+      mcc.ionization_energy = result.value();
+    } else {
+      return std::unexpected(result.error());
+    }
+
+    if (auto result = parse_item<ui_t>(config, "mcc", "seed"); result.has_value()) {
+      mcc.seed = result.value();
+    } else {
+      return std::unexpected(result.error());
+    }
+  }
+
+  // binary collisions are optional as well
+  if (config.contains("coulomb")) {
+    if (!config.at("coulomb").is_array()) {
+      const std::string error = fmt::format("`coulomb` must be an array of tables ... please use `[[coulomb]]`");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    for (const auto &table : config.at("coulomb").as_array()) {
+      if (!table.is_table()) {
+        const std::string error = fmt::format("`coulomb` must be an array of tables ... please use `[[coulomb]]`");
+        SPDLOG_CRITICAL(error);
+        return std::unexpected(error);
+      }
+
+      CoulombConfig c;
+
+      if (auto result = parse_entry<std::string>(table, "[coulomb]", "species_a"); result.has_value()) {
+        c.species_a = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<std::string>(table, "[coulomb]", "species_b"); result.has_value()) {
+        c.species_b = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[coulomb]", "coulomb_log"); result.has_value()) {
+        c.coulomb_log = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<ui_t>(table, "[coulomb]", "period"); result.has_value()) {
+        c.period = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      coulomb.push_back(std::move(c));
+    }
+  }
+
+  // materials are optional as well
+  if (config.contains("materials")) {
+    if (!config.at("materials").is_array()) {
+      const std::string error = fmt::format("`materials` must be an array of tables ... please use `[[materials]]`");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    for (const auto &table : config.at("materials").as_array()) {
+      if (!table.is_table()) {
+        const std::string error = fmt::format("`materials` must be an array of tables ... please use `[[materials]]`");
+        SPDLOG_CRITICAL(error);
+        return std::unexpected(error);
+      }
+
+      MaterialConfig mc;
+
+      if (auto result = parse_entry<std::string>(table, "[materials]", "name"); result.has_value()) {
+        mc.name = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[materials]", "ep_r"); result.has_value()) {
+        mc.ep_r = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[materials]", "sigma"); result.has_value()) {
+        mc.sigma = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      materials.push_back(std::move(mc));
+    }
+  }
+
+  // objects are optional as well
+  if (config.contains("objects")) {
+    if (!config.at("objects").is_array()) {
+      const std::string error = fmt::format("`objects` must be an array of tables ... please use `[[objects]]`");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    for (const auto &table : config.at("objects").as_array()) {
+      if (!table.is_table()) {
+        const std::string error = fmt::format("`objects` must be an array of tables ... please use `[[objects]]`");
+        SPDLOG_CRITICAL(error);
+        return std::unexpected(error);
+      }
+
+      ObjectConfig oc;
+
+      if (auto result = parse_entry<std::string>(table, "[objects]", "material"); result.has_value()) {
+        oc.material = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<std::string>(table, "[objects]", "shape"); result.has_value()) {
+        if (result.value() == "box") {
+          oc.shape = Shape::BOX;
+        } else if (result.value() == "sphere") {
+          oc.shape = Shape::SPHERE;
+        } else if (result.value() == "cylinder") {
+          oc.shape = Shape::CYLINDER;
+        } else if (result.value() == "stl") {
+          oc.shape = Shape::STL;
+        } else {
+          const std::string error = fmt::format(
+              "`[objects] shape` has unknown value `{}` ... expected one of `box`, `sphere`, `cylinder`, or `stl`",
+              result.value());
+          SPDLOG_CRITICAL(error);
+          return std::unexpected(error);
+        }
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      switch (oc.shape) {
+      case Shape::BOX:
+        if (auto result = parse_entry<fp_t>(table, "[objects]", "x_lo"); result.has_value()) {
+          oc.lo.x = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+
+        if (auto result = parse_entry<fp_t>(table, "[objects]", "x_hi"); result.has_value()) {
+          oc.hi.x = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+
+        if (auto result = parse_entry<fp_t>(table, "[objects]", "y_lo"); result.has_value()) {
+          oc.lo.y = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+
+        if (auto result = parse_entry<fp_t>(table, "[objects]", "y_hi"); result.has_value()) {
+          oc.hi.y = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+
+        if (auto result = parse_entry<fp_t>(table, "[objects]", "z_lo"); result.has_value()) {
+          oc.lo.z = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+
+        if (auto result = parse_entry<fp_t>(table, "[objects]", "z_hi"); result.has_value()) {
+          oc.hi.z = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+        break;
+      case Shape::SPHERE:
+        if (auto result = parse_entry<fp_t>(table, "[objects]", "x_c"); result.has_value()) {
+          oc.center.x = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+
+        if (auto result = parse_entry<fp_t>(table, "[objects]", "y_c"); result.has_value()) {
+          oc.center.y = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+
+        if (auto result = parse_entry<fp_t>(table, "[objects]", "z_c"); result.has_value()) {
+          oc.center.z = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+
+        if (auto result = parse_entry<fp_t>(table, "[objects]", "radius"); result.has_value()) {
+          oc.radius = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+        break;
+      case Shape::CYLINDER:
+        if (auto result = parse_entry<fp_t>(table, "[objects]", "x_c"); result.has_value()) {
+          oc.center.x = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+
+        if (auto result = parse_entry<fp_t>(table, "[objects]", "y_c"); result.has_value()) {
+          oc.center.y = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+
+        if (auto result = parse_entry<fp_t>(table, "[objects]", "radius"); result.has_value()) {
+          oc.radius = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+
+        if (auto result = parse_entry<fp_t>(table, "[objects]", "z_lo"); result.has_value()) {
+          oc.lo.z = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+
+        if (auto result = parse_entry<fp_t>(table, "[objects]", "z_hi"); result.has_value()) {
+          oc.hi.z = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+        break;
+      case Shape::STL:
+        if (auto result = parse_entry<std::string>(table, "[objects]", "path"); result.has_value()) {
+          oc.path = std::filesystem::path(result.value());
+        } else {
+          return std::unexpected(result.error());
+        }
+
+        if (auto result = parse_entry<fp_t>(table, "[objects]", "scale"); result.has_value()) {
+          oc.scale = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+        break;
+      }
+
+      objects.push_back(std::move(oc));
+    }
+  }
+
+  // dispersive materials are optional as well
+  if (config.contains("dispersive")) {
+    if (!config.at("dispersive").is_array()) {
+      const std::string error = fmt::format("`dispersive` must be an array of tables ... please use `[[dispersive]]`");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    for (const auto &table : config.at("dispersive").as_array()) {
+      if (!table.is_table()) {
+        const std::string error =
+            fmt::format("`dispersive` must be an array of tables ... please use `[[dispersive]]`");
+        SPDLOG_CRITICAL(error);
+        return std::unexpected(error);
+      }
+
+      DispersiveConfig dc;
+
+      if (auto result = parse_entry<std::string>(table, "[dispersive]", "pole"); result.has_value()) {
+        if (result.value() == "drude") {
+          dc.pole = Pole::DRUDE;
+        } else if (result.value() == "lorentz") {
+          dc.pole = Pole::LORENTZ;
+        } else if (result.value() == "debye") {
+          dc.pole = Pole::DEBYE;
+        } else {
+          const std::string error = fmt::format(
+              "`[dispersive] pole` has unknown value `{}` ... expected one of `drude`, `lorentz`, or `debye`",
+              result.value());
+          SPDLOG_CRITICAL(error);
+          return std::unexpected(error);
+        }
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[dispersive]", "x_lo"); result.has_value()) {
+        dc.lo.x = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[dispersive]", "x_hi"); result.has_value()) {
+        dc.hi.x = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[dispersive]", "y_lo"); result.has_value()) {
+        dc.lo.y = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[dispersive]", "y_hi"); result.has_value()) {
+        dc.hi.y = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[dispersive]", "z_lo"); result.has_value()) {
+        dc.lo.z = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[dispersive]", "z_hi"); result.has_value()) {
+        dc.hi.z = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (dc.pole != Pole::DRUDE) {
+        if (auto result = parse_entry<fp_t>(table, "[dispersive]", "delta_ep"); result.has_value()) {
+          dc.delta_ep = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+      }
+
+      if (dc.pole == Pole::DRUDE) {
+        if (auto result = parse_entry<fp_t>(table, "[dispersive]", "omega_p"); result.has_value()) {
+          dc.omega_p = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+      }
+
+      if (dc.pole == Pole::LORENTZ) {
+        if (auto result = parse_entry<fp_t>(table, "[dispersive]", "omega_0"); result.has_value()) {
+          dc.omega_0 = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+      }
+
+      if (dc.pole != Pole::DEBYE) {
+        if (auto result = parse_entry<fp_t>(table, "[dispersive]", "gamma"); result.has_value()) {
+          dc.gamma = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+      }
+
+      if (dc.pole == Pole::DEBYE) {
+        if (auto result = parse_entry<fp_t>(table, "[dispersive]", "tau"); result.has_value()) {
+          dc.tau = result.value();
+        } else {
+          return std::unexpected(result.error());
+        }
+      }
+
+      dispersive.push_back(dc);
+    }
+  }
+
+  // ensembles are optional as well
+  if (config.contains("ensemble")) {
+    if (!config.at("ensemble").is_array()) {
+      const std::string error = fmt::format("`ensemble` must be an array of tables ... please use `[[ensemble]]`");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    for (const auto &table : config.at("ensemble").as_array()) {
+      if (!table.is_table()) {
+        const std::string error = fmt::format("`ensemble` must be an array of tables ... please use `[[ensemble]]`");
+        SPDLOG_CRITICAL(error);
+        return std::unexpected(error);
+      }
+
+      EnsembleConfig ec;
+
+      if (auto result = parse_entry<fp_t>(table, "[ensemble]", "ep_r"); result.has_value()) {
+        ec.ep_r = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[ensemble]", "mu_r"); result.has_value()) {
+        ec.mu_r = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[ensemble]", "sigma"); result.has_value()) {
+        ec.sigma = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[ensemble]", "amplitude"); result.has_value()) {
+        ec.amplitude = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[ensemble]", "x"); result.has_value()) {
+        ec.source.x = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[ensemble]", "y"); result.has_value()) {
+        ec.source.y = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      if (auto result = parse_entry<fp_t>(table, "[ensemble]", "z"); result.has_value()) {
+        ec.source.z = result.value();
+      } else {
+        return std::unexpected(result.error());
+      }
+
+      ensemble.push_back(ec);
+    }
+  }
+
+  SPDLOG_TRACE("exit Config::parse_from");
+  return {};
+}
+
+std::expected<void, std::string> Config::validate() noexcept {
+  SPDLOG_TRACE("enter Config::validate");
+
+  if (!in_range(end_time, 0.0, std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
+    const std::string error = fmt::format("`end_time` is not within accepted range ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`end_time` passed all checks");
+
+  if (!in_range(len.x, 0.0, std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
+    const std::string error = fmt::format("`x_len` is not within accepted range ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`x_len` passed all checks");
+
+  if (!in_range(len.y, 0.0, std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
+    const std::string error = fmt::format("`y_len` is not within accepted range ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`y_len` passed all checks");
+
+  if (!in_range(len.z, 0.0, std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
+    const std::string error = fmt::format("`z_len` is not within accepted range ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`z_len` passed all checks");
+
+  if (mode == Mode::RZ &&
+      !in_range(num_modes, static_cast<ui_t>(0), std::numeric_limits<ui_t>::max(), Bounds::EXCL_INCL)) {
+    const std::string error = fmt::format("`num_modes` is not within accepted range ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`num_modes` passed all checks");
+
+  if (!in_range(max_frequency, 0.0, std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
+    const std::string error = fmt::format("`max_frequency` is not within accepted range ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`max_frequency` passed all checks");
+
+  if (!in_range(num_vox_min_wavelength, static_cast<ui_t>(0), std::numeric_limits<ui_t>::max(), Bounds::EXCL_INCL)) {
+    const std::string error =
+        fmt::format("`num_vox_min_wavelength` is not within accepted range ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`num_vox_min_wavelength` passed all checks");
+
+  if (!in_range(num_vox_min_feature, static_cast<ui_t>(0), std::numeric_limits<ui_t>::max(), Bounds::EXCL_INCL)) {
+    const std::string error =
+        fmt::format("`num_vox_min_feature` is not within accepted range ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`num_vox_min_feature` passed all checks");
+
+  if (!in_range(ep_r, 0.0, std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
+    const std::string error = fmt::format("`ep_r` is not within accepted range ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`ep_r` passed all checks");
+
+  if (!in_range(mu_r, 0.0, std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
+    const std::string error = fmt::format("`mu_r` is not within accepted range ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`mu_r` passed all checks");
+
+  if (!in_range(sigma, 0.0, std::numeric_limits<fp_t>::max(), Bounds::INCL)) {
+    const std::string error = fmt::format("`sigma` is not within accepted range ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`sigma` passed all checks");
+
+  const auto out_str = out.string();
+  try {
+    out = std::filesystem::canonical(out);
+    SPDLOG_DEBUG("`out_dir` successfully canonicalized with value`{}`", out.string());
+  } catch (const std::filesystem::filesystem_error &err) {
+    const std::string error =
+        fmt::format("unable to canonicalize `out_dir` with path `{}`: {} ... please ensure you are using either an "
+                    "absolute path or the appropriate relative path from your current working directory",
+                    out.string(), err.what());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  if (!std::filesystem::is_directory(out)) {
+    const std::string error =
+        fmt::format("path `out_dir` with path `{}`: is not a directory on this filesystem ... please correct and rerun",
+                    out.string());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  if (!in_range(log_period, static_cast<fp_t>(0), std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
+    const std::string error = fmt::format("`log_period` is not within accepted range ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`log_period` passed all checks");
+
+  if (engine == Engine::PSATD && !EPPIC_USE_PSATD) {
+    const std::string error = fmt::format("`engine` is `psatd` but EPPIC was built without PSATD support ... please "
+                                          "reconfigure with `EPPIC_USE_PSATD=ON`");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  if (engine == Engine::PSATD && sigma != 0.0) {
+    const std::string error =
+        fmt::format("`engine` is `psatd` which does not support a conductive background ... please set `sigma` to 0");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  if (engine == Engine::PSATD && mode != Mode::D3) {
+    const std::string error =
+        fmt::format("`engine` is `psatd` which only supports `3d` mode ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`engine` passed all checks");
+
+  for (ui_t f = 0; f < boundary.size(); ++f) {
+    if (engine == Engine::PSATD && boundary[f] != Boundary::PERIODIC) {
+      const std::string error = fmt::format("`{}` must be `periodic` as the `psatd` engine wraps the domain along "
+                                            "every axis ... please correct and rerun",
+                                            FACE_NAMES[f]);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+    if (engine == Engine::YEE && boundary[f] != Boundary::PEC && mode != Mode::D3) {
+      const std::string error = fmt::format("`{}` is not `pec` which the `yee` engine only supports in `3d` mode "
+                                            "... please correct and rerun",
+                                            FACE_NAMES[f]);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+
+  for (ui_t a = 0; a < bloch_phase.size(); ++a) {
+    const bool lo_wraps = boundary[2 * a] == Boundary::PERIODIC || boundary[2 * a] == Boundary::BLOCH;
+    const bool hi_wraps = boundary[2 * a + 1] == Boundary::PERIODIC || boundary[2 * a + 1] == Boundary::BLOCH;
+    if ((lo_wraps || hi_wraps) && boundary[2 * a] != boundary[2 * a + 1]) {
+      const std::string error = fmt::format("`{}` and `{}` must both be `periodic` or both be `bloch` ... please "
+                                            "correct and rerun",
+                                            FACE_NAMES[2 * a], FACE_NAMES[2 * a + 1]);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+
+  if (wraps(true) && std::ranges::find(boundary, Boundary::PMC) != boundary.end()) {
+    const std::string error =
+        fmt::format("`bloch` boundaries cannot be combined with `pmc` faces ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`boundary` passed all checks");
+
+  for (const auto &s : species) {
+    if (s.name.empty() || std::ranges::count(species, s.name, &SpeciesConfig::name) > 1) {
+      const std::string error =
+          fmt::format("species name `{}` is empty or not unique ... please correct and rerun", s.name);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    if (!in_range(s.mass, static_cast<fp_t>(0.0), std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
+      const std::string error = fmt::format("species `{}` mass `{:.3e}` is not positive ... please correct and rerun",
+                                            s.name, s.mass);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    if (!in_range(s.density, static_cast<fp_t>(0.0), std::numeric_limits<fp_t>::max(), Bounds::INCL) ||
+        !in_range(s.temperature, static_cast<fp_t>(0.0), std::numeric_limits<fp_t>::max(), Bounds::INCL)) {
+      const std::string error = fmt::format(
+          "species `{}` density or temperature is negative ... please correct and rerun", s.name);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    if (s.ppc == 0) {
+      const std::string error =
+          fmt::format("species `{}` must load at least one particle per voxel ... please correct and rerun", s.name);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+
+  if (!species.empty() && (mode != Mode::D3 || engine != Engine::YEE || wraps(true))) {
+    const std::string error = fmt::format("particle species are only supported in `3d` mode with the `yee` engine "
+                                          "and without `bloch` boundaries ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`species` passed all checks");
+
+  if (!mcc.species.empty()) {
+    const auto named = [this](const std::string &name) {
+      return std::ranges::count(species, name, &SpeciesConfig::name) == 1;
+    };
+
+    if (!named(mcc.species) || (!mcc.ion_species.empty() && !named(mcc.ion_species))) {
+      const std::string error = fmt::format("`[mcc] species` or `[mcc] ion_species` does not name a species ... please "
+                                            "correct and rerun");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    if (mcc.ion_species == mcc.species) {
+      const std::string error =
+          fmt::format("`[mcc] ion_species` must differ from `[mcc] species` ... please correct and rerun");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    if (!in_range(mcc.gas_density, static_cast<fp_t>(0.0), std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL) ||
+        !in_range(mcc.gas_mass, static_cast<fp_t>(0.0), std::numeric_limits<fp_t>::max(), Bounds::EXCL_INCL)) {
+      const std::string error =
+          fmt::format("`[mcc] gas_density` and `[mcc] gas_mass` must be positive ... please correct and rerun");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    if (mcc.gas_temperature < 0.0 || mcc.excitation_energy < 0.0 || mcc.ionization_energy < 0.0) {
+      const std::string error = fmt::format("`[mcc] gas_temperature`, `[mcc] excitation_energy`, and "
+                                            "`[mcc] ionization_energy` must not be negative ... please correct and "
+                                            "rerun");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    // ionization creates an ion alongside every secondary electron so it needs a species to place them in
+    if (mcc.ionization_energy > 0.0 && mcc.ion_species.empty()) {
+      const std::string error = fmt::format("`[mcc] ionization_energy` of {} (eV) requires `[mcc] ion_species` ... "
+                                            "please correct and rerun",
+                                            mcc.ionization_energy);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+  SPDLOG_DEBUG("`[mcc]` passed all checks");
+
+  for (const auto &c : coulomb) {
+    const auto named = [this](const std::string &name) {
+      return std::ranges::count(species, name, &SpeciesConfig::name) == 1;
+    };
+
+    if (!named(c.species_a) || !named(c.species_b)) {
+      const std::string error = fmt::format("`[coulomb]` species `{}` or `{}` does not name a species ... please "
+                                            "correct and rerun",
+                                            c.species_a, c.species_b);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    if (c.coulomb_log <= 0.0 || c.period == 0) {
+      const std::string error = fmt::format("`[coulomb]` of `{}` and `{}` requires a positive `coulomb_log` and "
+                                            "`period` ... please correct and rerun",
+                                            c.species_a, c.species_b);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+  SPDLOG_DEBUG("`[[coulomb]]` passed all checks");
+
+  if (materials.size() > std::numeric_limits<uint8_t>::max()) {
+    const std::string error = fmt::format("at most {} `[[materials]]` are supported ... please correct and rerun",
+                                          std::numeric_limits<uint8_t>::max());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  for (const auto &mc : materials) {
+    // the time step follows from the bounding box material so no material may carry waves faster than it
+    if (mc.name.empty() || std::ranges::count(materials, mc.name, &MaterialConfig::name) != 1 || mc.ep_r < ep_r ||
+        mc.sigma < 0.0) {
+      const std::string error = fmt::format("`[materials]` `{}` requires a unique name, a relative permittivity of at "
+                                            "least `[material] ep_r`, and a non-negative conductivity ... please "
+                                            "correct and rerun",
+                                            mc.name);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+  SPDLOG_DEBUG("`[[materials]]` passed all checks");
+
+  for (const auto &oc : objects) {
+    if (std::ranges::count(materials, oc.material, &MaterialConfig::name) != 1) {
+      const std::string error =
+          fmt::format("`[objects]` material `{}` does not name a material ... please correct and rerun", oc.material);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    const bool valid = oc.shape == Shape::BOX      ? oc.lo.x < oc.hi.x && oc.lo.y < oc.hi.y && oc.lo.z < oc.hi.z
+                       : oc.shape == Shape::STL    ? oc.scale > 0.0
+                       : oc.shape == Shape::SPHERE ? oc.radius > 0.0
+                                                   : oc.radius > 0.0 && oc.lo.z < oc.hi.z;
+    if (!valid) {
+      const std::string error = fmt::format("`[objects]` of material `{}` has empty extents or a non-positive radius "
+                                            "or scale ... please correct and rerun",
+                                            oc.material);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    // per-voxel update coefficients are only applied by the vector field kernels of the 3d yee engine and are fixed
+    // to the grid rather than a moving window
+    if (mode != Mode::D3 || engine != Engine::YEE || window_velocity > 0.0) {
+      const std::string error = fmt::format("`[objects]` requires `3d` mode, the `yee` engine, and no moving window "
+                                            "... please correct and rerun");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+  SPDLOG_DEBUG("`[[objects]]` passed all checks");
+
+  if (!material_file.empty() && (mode != Mode::D3 || engine != Engine::YEE || window_velocity > 0.0)) {
+    const std::string error = fmt::format("`[geometry] material_file` requires `3d` mode, the `yee` engine, and no "
+                                          "moving window ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`[geometry] material_file` passed all checks");
+
+  for (const auto &dc : dispersive) {
+    if (dc.lo.x >= dc.hi.x || dc.lo.y >= dc.hi.y || dc.lo.z >= dc.hi.z) {
+      const std::string error =
+          fmt::format("`[dispersive]` box lower corners must lie below upper corners ... please correct and rerun");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    if (dc.delta_ep < 0.0 || dc.omega_p < 0.0 || dc.omega_0 < 0.0 || dc.gamma < 0.0 || dc.tau < 0.0 ||
+        (dc.pole == Pole::DEBYE && dc.tau == 0.0)) {
+      const std::string error = fmt::format("`[dispersive]` parameters must not be negative and `tau` of debye poles "
+                                            "must be positive ... please correct and rerun");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    // polarization currents are stored for vector fields of the 3d yee engine only
+    if (mode != Mode::D3 || engine != Engine::YEE || wraps(true) || window_velocity > 0.0) {
+      const std::string error = fmt::format("`[dispersive]` requires `3d` mode, the `yee` engine, no bloch boundaries, "
+                                            "and no moving window ... please correct and rerun");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+  SPDLOG_DEBUG("`[[dispersive]]` passed all checks");
+
+  if (!ensemble.empty()) {
+    // members share everything but their material and source, so particles and anything voxelized or shifted in
+    // between field updates stays with the regular fields
+    if (ensemble.size() > ENSEMBLE_WIDTH || mode != Mode::D3 || engine != Engine::YEE || !species.empty() ||
+        std::ranges::any_of(boundary, [](const Boundary b) { return b != Boundary::PEC; }) || !objects.empty() ||
+        !material_file.empty() || !dispersive.empty() || window_velocity > 0.0 || activity_period > 0 || task_graph) {
+      const std::string error = fmt::format("`[[ensemble]]` allows at most {} members and requires `3d` mode, the "
+                                            "`yee` engine, `pec` boundaries, and no species, geometry, dispersive "
+                                            "materials, moving window, activity mask, or task graph ... please correct "
+                                            "and rerun",
+                                            ENSEMBLE_WIDTH);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+
+  for (const auto &ec : ensemble) {
+    if (ec.ep_r <= 0.0 || ec.mu_r <= 0.0 || ec.sigma < 0.0) {
+      const std::string error = fmt::format("`[ensemble]` members must have a positive `ep_r` and `mu_r` and a "
+                                            "non-negative `sigma` ... please correct and rerun");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    if (!in_range(ec.source.x, static_cast<fp_t>(0.0), len.x, Bounds::INCL) ||
+        !in_range(ec.source.y, static_cast<fp_t>(0.0), len.y, Bounds::INCL) ||
+        !in_range(ec.source.z, static_cast<fp_t>(0.0), len.z, Bounds::INCL)) {
+      const std::string error =
+          fmt::format("`[ensemble]` sources must lie within the bounding box ... please correct and rerun");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+  SPDLOG_DEBUG("`[[ensemble]]` passed all checks");
+
+  if (!in_range(shape_order, static_cast<ui_t>(0), static_cast<ui_t>(3), Bounds::INCL)) {
+    const std::string error =
+        fmt::format("`shape_order` `{}` is not one of 0, 1, 2, or 3 ... please correct and rerun", shape_order);
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`shape_order` passed all checks");
+
+  if (tile_size == 0) {
+    const std::string error = fmt::format("`tile_size` must be at least one voxel ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`tile_size` passed all checks");
+
+  if (task_graph) {
+    // tasks are built from the tiled yee kernels, bloch fields swap their imaginary parts in between kernel calls
+    if (mode != Mode::D3 || engine != Engine::YEE || wraps(true)) {
+      const std::string error = fmt::format("`task_graph` requires `3d` mode and the `yee` engine without bloch "
+                                            "boundaries ... please correct and rerun");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+  SPDLOG_DEBUG("`task_graph` passed all checks");
+
+  if (deposit == Deposit::COLORED) {
+    // particles drift at most one voxel per step away from the tile they were sorted into and their stencils reach a
+    // further shape_order / 2 + 2 voxels, tiles of one color are a full tile apart so twice that reach must fit
+    const ui_t reach = sort_period + shape_order / 2 + 2;
+    if (sort_period == 0 || tile_size < 2 * reach) {
+      const std::string error = fmt::format("`deposit` is `colored` which requires sorting and `tile_size` of at least "
+                                            "{} for the configured `sort_period` and `shape_order` ... please correct "
+                                            "and rerun",
+                                            2 * reach);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+  SPDLOG_DEBUG("`deposit` passed all checks");
+
+  if (!in_range(poisson_tolerance, static_cast<fp_t>(0.0), static_cast<fp_t>(1.0), Bounds::EXCL) ||
+      poisson_cycles == 0) {
+    const std::string error = fmt::format("`[poisson] tolerance` `{:.3e}` must lie in (0, 1) and "
+                                          "`[poisson] max_cycles` must be positive ... please correct and rerun",
+                                          poisson_tolerance);
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  // the initial field of particle loadings and cleaning both solve Gauss's law with the permittivity of the bounding
+  // box material
+  const bool varying_ep = std::ranges::any_of(materials, [this](const MaterialConfig &mc) { return mc.ep_r != ep_r; });
+  if ((clean_period > 0 || !species.empty()) && varying_ep && (!objects.empty() || !material_file.empty())) {
+    const std::string error = fmt::format("`[[species]]` and `[poisson] clean_period` require every `[[materials]]` "
+                                          "`ep_r` to match `[material] ep_r` ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`[poisson]` passed all checks");
+
+  if (balance_threshold < 1.0) {
+    const std::string error = fmt::format("`[balance] threshold` `{:.3e}` is below one ... please correct and rerun",
+                                          balance_threshold);
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`[balance]` passed all checks");
+
+  if (!in_range(activity_threshold, static_cast<fp_t>(0.0), static_cast<fp_t>(1.0), Bounds::INCL_EXCL)) {
+    const std::string error = fmt::format(
+        "`[activity] threshold` `{:.3e}` must lie in [0, 1) ... please correct and rerun", activity_threshold);
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  if (activity_period > 0) {
+    // fields spread by less than a voxel per step so a mask dilated by one tile stays ahead of the wavefront for up
+    // to tile_size steps
+    if (activity_period > tile_size || mode != Mode::D3 || engine != Engine::YEE) {
+      const std::string error = fmt::format("`[activity] period` must not exceed `tile_size` `{}` and requires `3d` "
+                                            "mode and the `yee` engine ... please correct and rerun",
+                                            tile_size);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+  SPDLOG_DEBUG("`[activity]` passed all checks");
+
+  if (window_velocity < 0.0 || window_velocity > VAC_SPEED_OF_LIGHT) {
+    const std::string error =
+        fmt::format("`[window] velocity` `{:.3e}` must lie in [0, c] ... please correct and rerun", window_velocity);
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  if (window_velocity > 0.0) {
+    // windows shift e, h, and their imaginary bloch parts along x, wrapping x faces would need the discarded planes and
+    // the remaining solvers do not hold their fields in Vector3
+    if (mode != Mode::D3 || engine != Engine::YEE || boundary[0] == Boundary::PERIODIC ||
+        boundary[0] == Boundary::BLOCH) {
+      const std::string error = fmt::format("`[window]` requires `3d` mode, the `yee` engine, and non-wrapping x "
+                                            "boundaries ... please correct and rerun");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+  SPDLOG_DEBUG("`[window]` passed all checks");
+
+  if (converge_period > 0) {
+    if (!in_range(converge_threshold, static_cast<fp_t>(0.0), static_cast<fp_t>(1.0), Bounds::EXCL) ||
+        converge_checks == 0) {
+      const std::string error = fmt::format("`[convergence]` requires a `threshold` in (0, 1) and at least one check "
+                                            "... please correct and rerun");
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+  SPDLOG_DEBUG("`[convergence]` passed all checks");
+
+  if ((sampling != Sampling::NONE && max_samples == 0) || bins == 0 || u_max <= 0.0 || energy_max <= 0.0) {
+    const std::string error = fmt::format("`[diagnostics]` requires positive `bins`, `u_max`, and `energy_max` and a "
+                                          "positive `max_samples` when sampling ... please correct and rerun");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`[diagnostics]` passed all checks");
+
+  if (resample_period > 0) {
+    // merging reduces a momentum octant of at least three particles to a pair, splitting stops at split_below so a
+    // freshly split voxel is never merged again
+    if (merge_above < 3 || split_below >= merge_above) {
+      const std::string error =
+          fmt::format("`[resample]` requires `merge_above` of at least 3 and `split_below` below `merge_above`, got "
+                      "`{}` and `{}` ... please correct and rerun",
+                      merge_above, split_below);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+  SPDLOG_DEBUG("`[resample]` passed all checks");
 
   SPDLOG_TRACE("exit Config::validate");
   return {};
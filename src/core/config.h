@@ -18,6 +18,7 @@
 #ifndef CORE_CONFIG_H
 #define CORE_CONFIG_H
 
+#include <array>
 #include <cstdint>
 #include <cxxabi.h>
 #include <expected>
@@ -32,6 +33,7 @@
 #include <toml11/serializer.hpp>
 #include <type_traits>
 #include <typeinfo>
+#include <vector>
 
 #include "coordinate.h"
 #include "type.h"
@@ -43,6 +45,253 @@
  */
 enum class Bounds { INCL, EXCL, INCL_EXCL, EXCL_INCL };
 
+/*!
+ * available field solvers
+ * @note YEE is the finite-difference time-domain leapfrog, PSATD is the pseudo-spectral analytical time-domain solver
+ * whose domain is periodic so it requires `periodic` on every face
+ */
+enum class Engine { YEE, PSATD };
+
+/*!
+ * available particle pushers
+ * @note BORIS is the relativistic Boris rotation, HIGUERA_CARY is the volume preserving variant with correct E x B
+ * drifts at relativistic velocities
+ */
+enum class Pusher { BORIS, HIGUERA_CARY };
+
+/*!
+ * available current deposition strategies
+ * @note REDUCE accumulates each tile of sorted particles into a thread-private buffer that is added onto the shared
+ * current density once per tile, ATOMIC accumulates into the shared current density with atomic updates and is kept as
+ * a reference, COLORED processes tiles of sorted particles in eight passes of non-adjacent tiles that accumulate into
+ * the shared current density without atomics
+ */
+enum class Deposit { REDUCE, ATOMIC, COLORED };
+
+/*!
+ * particle sub-sampling strategies for diagnostics
+ * @note STRIDE keeps evenly spaced particles, RANDOM keeps every particle with equal probability, NONE disables
+ * sampling while histograms are still written
+ */
+enum class Sampling { NONE, STRIDE, RANDOM };
+
+/*!
+ * early termination criteria applied to the total field energy
+ * @note DECAY stops once the energy has fallen to a fraction of its peak, PLATEAU stops once the relative change of the
+ * energy between reductions stays below a fraction
+ */
+enum class Criterion { DECAY, PLATEAU };
+
+/*!
+ * simulation dimensionality
+ * @note D2_TE allocates {ex, ey, hz} and D2_TM allocates {ez, hx, hy} on the x-y plane assuming invariance along z, D1
+ * allocates {ez, hy} along x assuming invariance along y and z, RZ solves azimuthal Fourier modes on an (r, z) grid
+ * with r along x and z along z
+ */
+enum class Mode { D3, D2_TE, D2_TM, D1, RZ };
+
+/*!
+ * outer boundary conditions applied per face of the bounding box
+ * @note PEC zeroes tangential electric fields on the face, PMC zeroes tangential magnetic fields on the face which
+ * makes it an even symmetry plane for tangential electric fields, PERIODIC and BLOCH wrap the domain along an axis
+ * (BLOCH with a complex phase shift) and must be set on both faces of that axis
+ * @note particles are absorbed by PEC faces, mirrored by PMC faces, and wrapped by PERIODIC and BLOCH faces
+ */
+enum class Boundary { PEC, PMC, PERIODIC, BLOCH };
+
+/// names of bounding box faces in {x_lo, x_hi, y_lo, y_hi, z_lo, z_hi} order
+inline constexpr std::array<const char *, 6> FACE_NAMES = {"x_lo", "x_hi", "y_lo", "y_hi", "z_lo", "z_hi"};
+
+/// default relative residual of multigrid solves, single precision round-off stalls residuals not far below 1e-5
+inline constexpr fp_t POISSON_TOLERANCE = std::is_same_v<fp_t, float> ? 1e-5 : 1e-8;
+
+/*!
+ * particle species configuration
+ */
+struct SpeciesConfig {
+  /// species name
+  std::string name;
+
+  /// (C) charge of a single physical particle
+  /// NOTE: given in elementary charges in the input deck
+  fp_t charge = 0.0;
+
+  /// (kg) mass of a single physical particle
+  /// NOTE: given in atomic mass units in the input deck
+  fp_t mass = 0.0;
+
+  /// (m^-3) initial uniform number density
+  fp_t density = 0.0;
+
+  /// (eV) initial temperature
+  fp_t temperature = 0.0;
+
+  /// number of macroparticles initially loaded per voxel
+  ui_t ppc = 0;
+};
+
+/*!
+ * electron-neutral Monte Carlo collision configuration
+ */
+struct MccConfig {
+  /// name of colliding species
+  /// NOTE: empty if collisions are disabled
+  std::string species;
+
+  /// name of species receiving ions created by ionization
+  /// NOTE: empty if ions are not tracked
+  std::string ion_species;
+
+  /// path to cross-section table
+  std::filesystem::path cross_sections;
+
+  /// (m^-3) uniform density of background gas
+  fp_t gas_density = 0.0;
+
+  /// (kg) mass of a background gas atom
+  /// NOTE: given in atomic mass units in the input deck
+  fp_t gas_mass = 0.0;
+
+  /// (eV) temperature of background gas
+  fp_t gas_temperature = 0.0;
+
+  /// (eV) excitation energy loss
+  fp_t excitation_energy = 0.0;
+
+  /// (eV) ionization energy loss
+  fp_t ionization_energy = 0.0;
+
+  /// seed of the counter-based random number generator
+  ui_t seed = 0;
+};
+
+/*!
+ * binary Coulomb collision configuration of a pair of species
+ */
+struct CoulombConfig {
+  /// name of first species
+  std::string species_a;
+
+  /// name of second species, equal to species_a for intra-species collisions
+  std::string species_b;
+
+  /// Coulomb logarithm
+  fp_t coulomb_log = 0.0;
+
+  /// number of steps between collisions, each collision covers this many steps
+  ui_t period = 0;
+};
+
+/*!
+ * dispersive pole models of auxiliary differential equation materials
+ */
+enum class Pole { DRUDE, LORENTZ, DEBYE };
+
+/*!
+ * dispersive material pole filling an axis-aligned box
+ */
+struct DispersiveConfig {
+  /// pole model
+  Pole pole = Pole::DRUDE;
+
+  /// (m) lower corner of box
+  Coord3<fp_t> lo = {0.0, 0.0, 0.0};
+
+  /// (m) upper corner of box
+  Coord3<fp_t> hi = {0.0, 0.0, 0.0};
+
+  /// change in relative permittivity from infinite to zero frequency
+  /// NOTE: only parsed for LORENTZ and DEBYE poles
+  fp_t delta_ep = 0.0;
+
+  /// (rad/s) plasma frequency
+  /// NOTE: only parsed for DRUDE poles
+  fp_t omega_p = 0.0;
+
+  /// (rad/s) resonance frequency
+  /// NOTE: only parsed for LORENTZ poles
+  fp_t omega_0 = 0.0;
+
+  /// (1/s) damping rate
+  /// NOTE: only parsed for DRUDE and LORENTZ poles
+  fp_t gamma = 0.0;
+
+  /// (s) relaxation time
+  /// NOTE: only parsed for DEBYE poles
+  fp_t tau = 0.0;
+};
+
+/*!
+ * non-dispersive material referenced by geometry objects
+ */
+struct MaterialConfig {
+  /// material name
+  std::string name;
+
+  /// relative permittivity
+  fp_t ep_r = 0.0;
+
+  /// (S/m) conductivity
+  fp_t sigma = 0.0;
+};
+
+/*!
+ * shapes of geometry objects
+ */
+enum class Shape { BOX, SPHERE, CYLINDER, STL };
+
+/*!
+ * geometry object voxelized into a material, later objects overwrite earlier ones
+ */
+struct ObjectConfig {
+  /// name of material filling the object
+  std::string material;
+
+  /// object shape
+  Shape shape = Shape::BOX;
+
+  /// (m) lower corner of BOX shapes and lower z-extent of CYLINDER shapes
+  Coord3<fp_t> lo = {0.0, 0.0, 0.0};
+
+  /// (m) upper corner of BOX shapes and upper z-extent of CYLINDER shapes
+  Coord3<fp_t> hi = {0.0, 0.0, 0.0};
+
+  /// (m) center of SPHERE shapes and axis of z-aligned CYLINDER shapes
+  Coord3<fp_t> center = {0.0, 0.0, 0.0};
+
+  /// (m) radius of SPHERE and CYLINDER shapes
+  fp_t radius = 0.0;
+
+  /// path to closed STL surface mesh (ASCII or binary)
+  std::filesystem::path path;
+
+  /// (m) size of one STL length unit
+  fp_t scale = 0.0;
+};
+
+/// number of ensemble members advanced together, i.e. the number of fp_t lanes in a 64 byte SIMD register
+constexpr ui_t ENSEMBLE_WIDTH = 64 / sizeof(fp_t);
+
+/*!
+ * field-only simulation sharing the geometry and time step of every other ensemble member
+ */
+struct EnsembleConfig {
+  /// relative permittivity
+  fp_t ep_r = 0.0;
+
+  /// relative permeability
+  fp_t mu_r = 0.0;
+
+  /// (S/m) conductivity
+  fp_t sigma = 0.0;
+
+  /// (A/m^2) peak current density of the z-directed point source
+  fp_t amplitude = 0.0;
+
+  /// (m) position of the point source
+  Coord3<fp_t> source = {0.0, 0.0, 0.0};
+};
+
 /*!
  * EPPIC configuration
  */
@@ -51,8 +300,15 @@ struct Config {
   fp_t end_time = 0.0;
 
   /// (m) size of bounding box in all directions
+  /// NOTE: lengths along invariant axes of reduced dimensionality modes are ignored
   Coord3<fp_t> len = {0.0, 0.0, 0.0};
 
+  /// simulation dimensionality
+  Mode mode = Mode::D3;
+
+  /// number of azimuthal Fourier modes in RZ mode
+  ui_t num_modes = 0;
+
   /// (Hz) maximum frequency to resolve with FDTD engine
   fp_t max_frequency = 0.0;
 
@@ -78,6 +334,129 @@ struct Config {
   /// first and last timestep will always be logged
   fp_t log_period = 0.0;
 
+  /// field solver used to advance electromagnetic fields
+  Engine engine = Engine::YEE;
+
+  /// particle pusher used to advance particle momenta
+  Pusher pusher = Pusher::BORIS;
+
+  /// current deposition strategy
+  Deposit deposit = Deposit::REDUCE;
+
+  /// number of steps between particle sorts where 0 disables sorting
+  ui_t sort_period = 0;
+
+  /// number of voxels along each edge of a particle tile
+  ui_t tile_size = 0;
+
+  /// whether field components run per tile as a dependency-driven task graph rather than one after another
+  bool task_graph = false;
+
+  /// number of steps between particle resampling where 0 disables resampling
+  ui_t resample_period = 0;
+
+  /// number of particles in a voxel above which they are merged
+  ui_t merge_above = 0;
+
+  /// number of particles in a voxel below which they are split
+  ui_t split_below = 0;
+
+  /// relative residual at which multigrid solves of Gauss's law stop
+  fp_t poisson_tolerance = 0.0;
+
+  /// maximum number of multigrid cycles per solve of Gauss's law
+  ui_t poisson_cycles = 0;
+
+  /// number of steps between divergence cleaning solves of Gauss's law where 0 disables cleaning
+  ui_t clean_period = 0;
+
+  /// number of steps between particle load balance checks where 0 disables balancing
+  ui_t balance_period = 0;
+
+  /// ratio of slowest to mean thread time above which tiles are repartitioned
+  fp_t balance_threshold = 0.0;
+
+  /// number of steps between field activity mask updates where 0 updates every tile every step
+  ui_t activity_period = 0;
+
+  /// fraction of the largest tile field energy at or below which tiles without particles are quiescent
+  fp_t activity_threshold = 0.0;
+
+  /// (m/s) velocity of the moving window along x where 0 disables the window
+  fp_t window_velocity = 0.0;
+
+  /// number of spare x-planes allocated per field component so window shifts rarely copy
+  ui_t window_spare = 0;
+
+  /// number of steps between total field energy reductions where 0 disables early termination
+  ui_t converge_period = 0;
+
+  /// early termination criterion applied to the total field energy
+  Criterion converge_criterion = Criterion::DECAY;
+
+  /// fraction of the peak energy or relative change of energy between reductions at which the criterion is met
+  fp_t converge_threshold = 0.0;
+
+  /// number of consecutive reductions that must meet the criterion before the run stops
+  ui_t converge_checks = 0;
+
+  /// particle sub-sampling strategy of diagnostics
+  Sampling sampling = Sampling::NONE;
+
+  /// maximum number of particles sampled per species and logging event
+  ui_t max_samples = 0;
+
+  /// number of bins along every axis of particle histograms
+  ui_t bins = 0;
+
+  /// (m/s) bound of proper velocity in x-ux phase-space histograms which span [-u_max, u_max]
+  fp_t u_max = 0.0;
+
+  /// (eV) bound of kinetic energy spectra which span [0, energy_max]
+  fp_t energy_max = 0.0;
+
+  /// order of particle shape functions as {0, 1, 2, 3} for {NGP, CIC, TSC, cubic}
+  ui_t shape_order = 0;
+
+  /// outer boundary conditions in {x_lo, x_hi, y_lo, y_hi, z_lo, z_hi} order
+  std::array<Boundary, 6> boundary = {Boundary::PEC, Boundary::PEC, Boundary::PEC,
+                                      Boundary::PEC, Boundary::PEC, Boundary::PEC};
+
+  /// (rad) Bloch phase shift across the bounding box along {x, y, z} (i.e., k_bloch * len)
+  /// NOTE: only parsed for axes with BLOCH boundaries
+  std::array<fp_t, 3> bloch_phase = {0.0, 0.0, 0.0};
+
+  /// particle species from optional `[[species]]` tables
+  std::vector<SpeciesConfig> species;
+
+  /// electron-neutral collisions from optional `[mcc]` table
+  MccConfig mcc;
+
+  /// binary Coulomb collisions from optional `[[coulomb]]` tables
+  std::vector<CoulombConfig> coulomb;
+
+  /// path to HDF5 file holding a precomputed material ID volume
+  /// NOTE: empty if no volume is loaded
+  std::filesystem::path material_file;
+
+  /// path of material ID dataset within material_file
+  std::string material_dataset;
+
+  /// materials from optional `[[materials]]` tables
+  /// NOTE: material IDs are 1 + table index, ID 0 is the bounding box material
+  std::vector<MaterialConfig> materials;
+
+  /// geometry objects from optional `[[objects]]` tables
+  std::vector<ObjectConfig> objects;
+
+  /// dispersive material poles from optional `[[dispersive]]` tables
+  /// NOTE: the bounding box material sets the infinite frequency permittivity of every pole
+  std::vector<DispersiveConfig> dispersive;
+
+  /// field-only ensemble members from optional `[[ensemble]]` tables
+  /// NOTE: members replace the bounding box material and are advanced in place of the regular fields
+  std::vector<EnsembleConfig> ensemble;
+
   /*!
    * initializes configuration from input deck
    * @param input_file_path path to input configuration file
@@ -85,11 +464,34 @@ struct Config {
    */
   [[nodiscard]] std::expected<void, std::string> init(const std::string &input_file_path) noexcept;
 
+  /*!
+   * initializes configuration from an already parsed input deck
+   * @param config toml configuration
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   * @note lets sweeps apply per-run overrides to a deck that is only read from disk once
+   */
+  [[nodiscard]] std::expected<void, std::string> init(const toml::basic_value<toml::type_config> &config) noexcept;
+
+  /*!
+   * reads and parses an input deck without interpreting it
+   * @param input_file_path path to input configuration file
+   * @return std::expected<toml::basic_value<toml::type_config>, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] static std::expected<toml::basic_value<toml::type_config>, std::string>
+  read(const std::string &input_file_path) noexcept;
+
   /*!
    * resets Config to default state
    */
   void reset() noexcept;
 
+  /*!
+   * checks if any axis has periodic or Bloch boundaries
+   * @param bloch {true, false} to only consider {BLOCH, both PERIODIC and BLOCH} boundaries respectively
+   * @return true if any axis wraps
+   */
+  [[nodiscard]] bool wraps(bool bloch) const noexcept;
+
   /*!
    * logs internal state summary
    */
@@ -131,6 +533,56 @@ struct Config {
     }
   }
 
+  /*!
+   * parses item of type T from toml configuration at a given table and key that may be absent
+   * @tparam T type to be parsed
+   * @param config toml configuration
+   * @param table table to parse from
+   * @param key item key in table
+   * @param fallback value if either the table or the key is absent
+   * @return std::expected<T, std::string> for {success, error} cases respectively
+   * @note lets features added after an input deck was written default to disabled instead of rejecting the deck
+   */
+  template <typename T>
+  std::expected<T, std::string> parse_optional(const toml::basic_value<toml::type_config> &config,
+                                               const std::string table, const std::string key,
+                                               const T fallback) noexcept {
+    if (!config.contains(table) || (config.at(table).is_table() && !config.at(table).contains(key))) {
+      SPDLOG_DEBUG("`[{}] {}` is absent and defaults to `{}`", table, key, fallback);
+      return fallback;
+    }
+
+    return parse_item<T>(config, table, key);
+  }
+
+  /*!
+   * parses item of type T from a table that is not addressable by name (e.g., an entry of an array of tables)
+   * @tparam T type to be parsed
+   * @param table toml table
+   * @param name table name for diagnostics
+   * @param key item key in table
+   * @return std::expected<T, std::string> for {success, error} cases respectively
+   */
+  template <typename T>
+  std::expected<T, std::string> parse_entry(const toml::basic_value<toml::type_config> &table, const std::string name,
+                                            const std::string key) noexcept {
+    SPDLOG_TRACE("enter Config::parse_entry");
+
+    const auto type = type_name<T>();
+
+    try {
+      const T value = toml::find<T>(table, key);
+      SPDLOG_DEBUG("`[{}] {}` successfully parsed as {} with value `{}`", name, key, type, value);
+      SPDLOG_TRACE("exit Config::parse_entry with success");
+      return value;
+    } catch (const std::exception &err) {
+      const std::string error = fmt::format("parsing `[{}] {}` as {} failed: {}", name, key, type, err.what());
+      SPDLOG_CRITICAL(error);
+      SPDLOG_TRACE("exit Config::parse_entry with failure");
+      return std::unexpected(error);
+    }
+  }
+
   /*!
    * validates internal state against preconfigured value ranges
    * @return std::expected<void, std::string> for {success, error} cases respectively
@@ -0,0 +1,295 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "cylindrical.h"
+
+#include <cmath>
+#include <numbers>
+
+std::expected<void, std::string> Cylindrical::init(const ui_t modes, const Coord2<ui_t> &dims,
+                                                   const Coord2<fp_t> &spacing) noexcept {
+  SPDLOG_TRACE("enter Cylindrical::init");
+
+  num_modes = modes;
+  n = dims;
+  d = spacing;
+
+  // the +1 is a result of the convention that all magnetic field points are wrapped by an electric field
+  const Coord3<ui_t> dims_e = {num_modes, n.x + 1, n.y + 1};
+  const Coord3<ui_t> dims_h = {num_modes, n.x, n.y};
+
+  ModeField<fp_t> *fields[6] = {&er, &et, &ez, &hr, &ht, &hz};
+  constexpr const char *names[6] = {"er", "et", "ez", "hr", "ht", "hz"};
+
+  for (ui_t c = 0; c < 6; ++c) {
+    if (const auto result = fields[c]->init(c < 3 ? dims_e : dims_h, static_cast<fp_t>(0.0)); !result.has_value()) {
+      const auto error = fmt::format("failed to initialize `{}`: {}", names[c], result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+
+  SPDLOG_TRACE("exit Cylindrical::init");
+  return {};
+}
+
+void Cylindrical::reset() noexcept {
+  SPDLOG_TRACE("enter Cylindrical::reset");
+
+  num_modes = 0;
+  n = {0, 0};
+  d = {0.0, 0.0};
+  er.reset();
+  et.reset();
+  ez.reset();
+  hr.reset();
+  ht.reset();
+  hz.reset();
+
+  e_space = HDF5Obj();
+  h_space = HDF5Obj();
+  for (auto &set : sets) {
+    set = HDF5Obj();
+  }
+
+  SPDLOG_TRACE("exit Cylindrical::reset");
+}
+
+fp_t Cylindrical::max_dt(const fp_t c) const noexcept {
+  SPDLOG_TRACE("enter Cylindrical::max_dt");
+
+  const auto m_max = static_cast<fp_t>(num_modes - 1);
+  const fp_t dt = static_cast<fp_t>(1.0) /
+                  (c * std::sqrt((static_cast<fp_t>(1.0) + m_max * m_max) / (d.x * d.x) +
+                                 static_cast<fp_t>(1.0) / (d.y * d.y)));
+
+  SPDLOG_TRACE("exit Cylindrical::max_dt");
+  return dt;
+}
+
+void Cylindrical::update_e(const fp_t ea, const fp_t eb) const {
+  SPDLOG_TRACE("enter Cylindrical::update_e");
+
+  const fp_t dr_inv = static_cast<fp_t>(1.0) / d.x;
+  const fp_t dz_inv = static_cast<fp_t>(1.0) / d.y;
+
+  for (ui_t m = 0; m < num_modes; ++m) {
+    const auto mf = static_cast<fp_t>(m);
+
+    // radial component, tangential to the PEC z ends
+    for (ui_t i = 0; i < n.x; ++i) {
+      const fp_t r_half = (static_cast<fp_t>(i) + ONE_OVER_TWO) * d.x;
+      for (ui_t j = 1; j < n.y; ++j) {
+        er.re.v[m, i, j] = ea * (eb * er.re.v[m, i, j] - mf * hz.im.v[m, i, j] / r_half -
+                                 dz_inv * (ht.re.v[m, i, j] - ht.re.v[m, i, j - 1]));
+        er.im.v[m, i, j] = ea * (eb * er.im.v[m, i, j] + mf * hz.re.v[m, i, j] / r_half -
+                                 dz_inv * (ht.im.v[m, i, j] - ht.im.v[m, i, j - 1]));
+      }
+    }
+
+    // azimuthal component, only mode 1 is non-zero on axis where hz(-dr / 2) = -hz(dr / 2)
+    for (ui_t j = 1; j < n.y; ++j) {
+      if (m == 1) {
+        et.re.v[m, 0, j] = ea * (eb * et.re.v[m, 0, j] + dz_inv * (hr.re.v[m, 0, j] - hr.re.v[m, 0, j - 1]) -
+                                 static_cast<fp_t>(2.0) * dr_inv * hz.re.v[m, 0, j]);
+        et.im.v[m, 0, j] = ea * (eb * et.im.v[m, 0, j] + dz_inv * (hr.im.v[m, 0, j] - hr.im.v[m, 0, j - 1]) -
+                                 static_cast<fp_t>(2.0) * dr_inv * hz.im.v[m, 0, j]);
+      }
+
+      for (ui_t i = 1; i < n.x; ++i) {
+        et.re.v[m, i, j] = ea * (eb * et.re.v[m, i, j] + dz_inv * (hr.re.v[m, i, j] - hr.re.v[m, i, j - 1]) -
+                                 dr_inv * (hz.re.v[m, i, j] - hz.re.v[m, i - 1, j]));
+        et.im.v[m, i, j] = ea * (eb * et.im.v[m, i, j] + dz_inv * (hr.im.v[m, i, j] - hr.im.v[m, i, j - 1]) -
+                                 dr_inv * (hz.im.v[m, i, j] - hz.im.v[m, i - 1, j]));
+      }
+    }
+
+    // axial component, only mode 0 is non-zero on axis where the curl reduces to the circulation of ht around a
+    // disk of radius dr / 2
+    for (ui_t j = 0; j < n.y; ++j) {
+      if (m == 0) {
+        ez.re.v[m, 0, j] = ea * (eb * ez.re.v[m, 0, j] + static_cast<fp_t>(4.0) * dr_inv * ht.re.v[m, 0, j]);
+        ez.im.v[m, 0, j] = ea * (eb * ez.im.v[m, 0, j] + static_cast<fp_t>(4.0) * dr_inv * ht.im.v[m, 0, j]);
+      }
+
+      for (ui_t i = 1; i < n.x; ++i) {
+        const auto r = static_cast<fp_t>(i) * d.x;
+        const fp_t r_lo = r - ONE_OVER_TWO * d.x;
+        const fp_t r_hi = r + ONE_OVER_TWO * d.x;
+
+        ez.re.v[m, i, j] =
+            ea * (eb * ez.re.v[m, i, j] + (r_hi * ht.re.v[m, i, j] - r_lo * ht.re.v[m, i - 1, j]) * dr_inv / r +
+                  mf * hr.im.v[m, i, j] / r);
+        ez.im.v[m, i, j] =
+            ea * (eb * ez.im.v[m, i, j] + (r_hi * ht.im.v[m, i, j] - r_lo * ht.im.v[m, i - 1, j]) * dr_inv / r -
+                  mf * hr.re.v[m, i, j] / r);
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit Cylindrical::update_e");
+}
+
+void Cylindrical::update_h(const fp_t ha) const {
+  SPDLOG_TRACE("enter Cylindrical::update_h");
+
+  const fp_t dr_inv = static_cast<fp_t>(1.0) / d.x;
+  const fp_t dz_inv = static_cast<fp_t>(1.0) / d.y;
+
+  for (ui_t m = 0; m < num_modes; ++m) {
+    const auto mf = static_cast<fp_t>(m);
+
+    // radial component, only mode 1 is non-zero on axis where i m ez / r tends to i dez/dr
+    for (ui_t j = 0; j < n.y; ++j) {
+      if (m == 1) {
+        hr.re.v[m, 0, j] -= ha * (-dr_inv * ez.im.v[m, 1, j] - dz_inv * (et.re.v[m, 0, j + 1] - et.re.v[m, 0, j]));
+        hr.im.v[m, 0, j] -= ha * (dr_inv * ez.re.v[m, 1, j] - dz_inv * (et.im.v[m, 0, j + 1] - et.im.v[m, 0, j]));
+      }
+
+      for (ui_t i = 1; i < n.x; ++i) {
+        const auto r = static_cast<fp_t>(i) * d.x;
+        hr.re.v[m, i, j] -= ha * (-mf * ez.im.v[m, i, j] / r - dz_inv * (et.re.v[m, i, j + 1] - et.re.v[m, i, j]));
+        hr.im.v[m, i, j] -= ha * (mf * ez.re.v[m, i, j] / r - dz_inv * (et.im.v[m, i, j + 1] - et.im.v[m, i, j]));
+      }
+    }
+
+    // azimuthal component
+    for (ui_t i = 0; i < n.x; ++i) {
+      for (ui_t j = 0; j < n.y; ++j) {
+        ht.re.v[m, i, j] -= ha * (dz_inv * (er.re.v[m, i, j + 1] - er.re.v[m, i, j]) -
+                                  dr_inv * (ez.re.v[m, i + 1, j] - ez.re.v[m, i, j]));
+        ht.im.v[m, i, j] -= ha * (dz_inv * (er.im.v[m, i, j + 1] - er.im.v[m, i, j]) -
+                                  dr_inv * (ez.im.v[m, i + 1, j] - ez.im.v[m, i, j]));
+      }
+    }
+
+    // axial component
+    for (ui_t i = 0; i < n.x; ++i) {
+      const auto r = static_cast<fp_t>(i) * d.x;
+      const fp_t r_half = r + ONE_OVER_TWO * d.x;
+      const fp_t r_next = r + d.x;
+      for (ui_t j = 0; j < n.y; ++j) {
+        hz.re.v[m, i, j] -= ha * ((r_next * et.re.v[m, i + 1, j] - r * et.re.v[m, i, j]) * dr_inv / r_half +
+                                  mf * er.im.v[m, i, j] / r_half);
+        hz.im.v[m, i, j] -= ha * ((r_next * et.im.v[m, i + 1, j] - r * et.im.v[m, i, j]) * dr_inv / r_half -
+                                  mf * er.re.v[m, i, j] / r_half);
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit Cylindrical::update_h");
+}
+
+ui_t Cylindrical::num_field_points() const noexcept {
+  return 2 * 3 * num_modes * ((n.x + 1) * (n.y + 1) + n.x * n.y);
+}
+
+fp_t Cylindrical::field_energy(const fp_t ep, const fp_t mu) const {
+  SPDLOG_TRACE("enter Cylindrical::field_energy");
+
+  // (m) radius of nodes on integer and half-integer radial indices, axis nodes use the centroid weight of their disc
+  const auto r_node = [&](const ui_t i) {
+    return i == 0 ? static_cast<double>(d.x) / 8.0 : static_cast<double>(i) * d.x;
+  };
+  const auto r_half = [&](const ui_t i) { return (static_cast<double>(i) + 0.5) * d.x; };
+
+  const ModeField<fp_t> *fields[6] = {&er, &et, &ez, &hr, &ht, &hz};
+  const bool half[6] = {true, false, false, false, true, true};
+
+  double energy = 0.0;
+  for (ui_t c = 0; c < 6; ++c) {
+    const auto &f = *fields[c];
+    const ui_t nr = f.re.v.extent(1);
+    const ui_t nz = f.re.v.extent(2);
+    const double material = c < 3 ? ep : mu;
+
+    double sum = 0.0;
+#pragma omp parallel for collapse(2) reduction(+ : sum)
+    for (ui_t m = 0; m < num_modes; ++m) {
+      for (ui_t i = 0; i < nr; ++i) {
+        const double azimuth = m == 0 ? 2.0 * std::numbers::pi : std::numbers::pi;
+        const double r = half[c] ? r_half(i) : r_node(i);
+        double ring = 0.0;
+        for (ui_t j = 0; j < nz; ++j) {
+          const double re = f.re.v[m, i, j];
+          const double im = f.im.v[m, i, j];
+          ring += re * re + im * im;
+        }
+        sum += azimuth * r * ring;
+      }
+    }
+    energy += 0.5 * material * sum * d.x * d.y;
+  }
+
+  SPDLOG_TRACE("exit Cylindrical::field_energy");
+  return static_cast<fp_t>(energy);
+}
+
+void Cylindrical::setup_datasets(const HDF5Obj &group, const ui_t num, const bool shrinkable) {
+  SPDLOG_TRACE("enter Cylindrical::setup_datasets");
+
+  const hsize_t dims_e[4] = {static_cast<hsize_t>(num), static_cast<hsize_t>(num_modes), static_cast<hsize_t>(n.x + 1),
+                             static_cast<hsize_t>(n.y + 1)};
+  const hsize_t dims_h[4] = {static_cast<hsize_t>(num), static_cast<hsize_t>(num_modes), static_cast<hsize_t>(n.x),
+                             static_cast<hsize_t>(n.y)};
+
+  e_space = HDF5Obj(H5Screate_simple(4, dims_e, nullptr), H5Sclose);
+  h_space = HDF5Obj(H5Screate_simple(4, dims_h, nullptr), H5Sclose);
+
+  constexpr const char *names[12] = {"er_re", "er_im", "et_re", "et_im", "ez_re", "ez_im",
+                                     "hr_re", "hr_im", "ht_re", "ht_im", "hz_re", "hz_im"};
+
+  const auto e_props = row_props(e_space, shrinkable);
+  const auto h_props = row_props(h_space, shrinkable);
+
+  for (ui_t c = 0; c < 12; ++c) {
+    const auto &space = c < 6 ? e_space : h_space;
+    const auto &props = c < 6 ? e_props : h_props;
+    sets[c] = HDF5Obj(
+        H5Dcreate(group.get(), names[c], h5_fp_t<fp_t>(), space.get(), H5P_DEFAULT, props.get(), H5P_DEFAULT),
+        H5Dclose);
+  }
+
+  SPDLOG_TRACE("exit Cylindrical::setup_datasets");
+}
+
+void Cylindrical::log(const ui_t hyperslab) const {
+  SPDLOG_TRACE("enter Cylindrical::log");
+
+  const hsize_t e_count[4] = {1, static_cast<hsize_t>(num_modes), static_cast<hsize_t>(n.x + 1),
+                              static_cast<hsize_t>(n.y + 1)};
+  const hsize_t h_count[4] = {1, static_cast<hsize_t>(num_modes), static_cast<hsize_t>(n.x),
+                              static_cast<hsize_t>(n.y)};
+  const hsize_t offset[4] = {hyperslab, 0, 0, 0};
+
+  H5Sselect_hyperslab(e_space.get(), H5S_SELECT_SET, offset, nullptr, e_count, nullptr);
+  H5Sselect_hyperslab(h_space.get(), H5S_SELECT_SET, offset, nullptr, h_count, nullptr);
+
+  const auto e_memspace = HDF5Obj(H5Screate_simple(4, e_count, nullptr), H5Sclose);
+  const auto h_memspace = HDF5Obj(H5Screate_simple(4, h_count, nullptr), H5Sclose);
+
+  const fp_t *data[12] = {er.re.data, er.im.data, et.re.data, et.im.data, ez.re.data, ez.im.data,
+                          hr.re.data, hr.im.data, ht.re.data, ht.im.data, hz.re.data, hz.im.data};
+
+  for (ui_t c = 0; c < 12; ++c) {
+    const auto &memspace = c < 6 ? e_memspace : h_memspace;
+    const auto &space = c < 6 ? e_space : h_space;
+    H5Dwrite(sets[c].get(), h5_fp_t<fp_t>(), memspace.get(), space.get(), H5P_DEFAULT, data[c]);
+  }
+
+  SPDLOG_TRACE("exit Cylindrical::log");
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_CYLINDRICAL_H
+#define CORE_CYLINDRICAL_H
+
+#include <expected>
+#include <spdlog/spdlog.h>
+#include <string>
+
+#include "coordinate.h"
+#include "io.h"
+#include "numeric.h"
+#include "scalar.h"
+#include "type.h"
+
+/*!
+ * complex azimuthal mode field component on an (m, r, z) grid
+ * @tparam T numeric type
+ */
+template <numeric T> struct ModeField {
+  /// real part
+  Scalar3<T> re;
+
+  /// imaginary part
+  Scalar3<T> im;
+
+  /*!
+   * initializes ModeField
+   * @param dims field dimensions as {modes, r, z}
+   * @param val initial value of both real and imaginary parts
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init(const Coord3<ui_t> &dims, const T val) noexcept {
+    SPDLOG_TRACE("enter ModeField::init");
+
+    if (const auto result = re.init(dims, val); !result.has_value()) {
+      return std::unexpected(fmt::format("real part: {}", result.error()));
+    }
+
+    if (const auto result = im.init(dims, val); !result.has_value()) {
+      return std::unexpected(fmt::format("imaginary part: {}", result.error()));
+    }
+
+    SPDLOG_TRACE("exit ModeField::init");
+    return {};
+  }
+
+  /*!
+   * resets ModeField to default state
+   */
+  void reset() noexcept {
+    SPDLOG_TRACE("enter ModeField::reset");
+
+    re.reset();
+    im.reset();
+
+    SPDLOG_TRACE("exit ModeField::reset");
+  }
+};
+
+/*!
+ * cylindrical (r, z) finite-difference solver with azimuthal Fourier mode decomposition
+ *
+ * fields are represented as sum_m F_m(r, z) exp(i m theta) for m in [0, num_modes) on a staggered (r, z) Yee grid:
+ * er (i + 1/2, j), et (i, j), ez (i, j + 1/2), hr (i, j + 1/2), ht (i + 1/2, j + 1/2), hz (i + 1/2, j)
+ *
+ * @note r = 0 lies on the first electric field node, the outer radius and both z ends are PEC
+ */
+struct Cylindrical {
+  /// number of azimuthal modes
+  ui_t num_modes = 0;
+
+  /// number of magnetic field voxels along {r, z}
+  Coord2<ui_t> n = {0, 0};
+
+  /// (m) spatial increments along {r, z}
+  Coord2<fp_t> d = {0.0, 0.0};
+
+  /// (V/m) radial electric field
+  ModeField<fp_t> er;
+
+  /// (V/m) azimuthal electric field
+  ModeField<fp_t> et;
+
+  /// (V/m) axial electric field
+  ModeField<fp_t> ez;
+
+  /// (A/m) radial magnetic field
+  ModeField<fp_t> hr;
+
+  /// (A/m) azimuthal magnetic field
+  ModeField<fp_t> ht;
+
+  /// (A/m) axial magnetic field
+  ModeField<fp_t> hz;
+
+  /// dataspace for electric field data
+  HDF5Obj e_space;
+
+  /// dataspace for magnetic field data
+  HDF5Obj h_space;
+
+  /// datasets in {er, et, ez, hr, ht, hz} order with real and imaginary parts interleaved
+  HDF5Obj sets[12];
+
+  /*!
+   * initializes Cylindrical
+   * @param modes number of azimuthal modes
+   * @param dims number of magnetic field voxels along {r, z}
+   * @param spacing (m) spatial increments along {r, z}
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init(ui_t modes, const Coord2<ui_t> &dims,
+                                                      const Coord2<fp_t> &spacing) noexcept;
+
+  /*!
+   * resets Cylindrical to default state
+   */
+  void reset() noexcept;
+
+  /*!
+   * calculates the maximum stable time step
+   * @param c (m/s) speed of light in the background material
+   * @return (s) maximum stable time step
+   * @note the azimuthal derivative i m / r adds m / dr to the radial stencil so higher modes tighten the limit
+   */
+  [[nodiscard]] fp_t max_dt(fp_t c) const noexcept;
+
+  /*!
+   * advances electric field state by one time step
+   * @param ea electric field a loop constant
+   * @param eb electric field b loop constant
+   */
+  void update_e(fp_t ea, fp_t eb) const;
+
+  /*!
+   * advances magnetic field state by one time step
+   * @param ha magnetic field a loop constant (dt / mu)
+   */
+  void update_h(fp_t ha) const;
+
+  /*!
+   * number of field points advanced every time step
+   * @return number of field points across all modes, components, and real and imaginary parts
+   */
+  [[nodiscard]] ui_t num_field_points() const noexcept;
+
+  /*!
+   * reduces the electromagnetic field energy summed over all modes
+   * @param ep (F/m) permittivity
+   * @param mu (H/m) permeability
+   * @return (J) field energy
+   * @note mode 0 fills the full azimuth while higher modes average cos^2 over it, nodes on axis weigh the disc of
+   * radius dr / 2 around it
+   */
+  [[nodiscard]] fp_t field_energy(fp_t ep, fp_t mu) const;
+
+  /*!
+   * sets up dataspaces and datasets for logging
+   *
+   * todo improve error handling
+   *
+   * @param group group to create datasets within
+   * @param num number of logged steps
+   * @param shrinkable chunks datasets by logged step so that runs stopping early can shrink them
+   */
+  void setup_datasets(const HDF5Obj &group, ui_t num, bool shrinkable);
+
+  /*!
+   * logs field data
+   *
+   * todo improve error handling
+   *
+   * @param hyperslab hyperslab index to write to
+   */
+  void log(ui_t hyperslab) const;
+};
+
+#endif // CORE_CYLINDRICAL_H
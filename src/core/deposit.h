@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_DEPOSIT_H
+#define CORE_DEPOSIT_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "coordinate.h"
+#include "numeric.h"
+#include "shape.h"
+#include "type.h"
+#include "vector.h"
+
+/*!
+ * current density accumulation buffer private to one particle tile and a halo around it
+ */
+struct TileCurrent {
+  /// (A/m^2) current density with electric field layout
+  Vector3<fp_t> j;
+
+  /// voxel index of the first buffer element along each axis which may lie outside of the grid
+  std::array<si_t, 3> origin = {0, 0, 0};
+
+  /// first buffer element along each axis touched since the last flush
+  std::array<ui_t, 3> lo = {std::numeric_limits<ui_t>::max(), std::numeric_limits<ui_t>::max(),
+                            std::numeric_limits<ui_t>::max()};
+
+  /// one past the last buffer element along each axis touched since the last flush
+  std::array<ui_t, 3> hi = {0, 0, 0};
+};
+
+/*!
+ * adds a value to a current density element
+ * @tparam ATOMIC {true, false} to {use, not use} an atomic update
+ * @param dst destination element
+ * @param val value to add
+ */
+template <bool ATOMIC> inline void accumulate(fp_t &dst, const fp_t val) noexcept {
+  if constexpr (ATOMIC) {
+#pragma omp atomic
+    dst += val;
+  } else {
+    dst += val;
+  }
+}
+
+/*!
+ * deposits the current of one particle with the charge conserving scheme of Esirkepov (2001)
+ * @tparam O shape order as {0, 1, 2, 3} for {NGP, CIC, TSC, cubic}
+ * @tparam ATOMIC {true, false} to {use, not use} atomic updates which is required when threads share j
+ * @param j (A/m^2) current density vector with electric field layout
+ * @param extent electric field voxel dimensions
+ * @param period number of voxels along each periodic axis and 0 along axes bounded by walls
+ * @param r0 particle position at the start of the step in units of voxels
+ * @param r1 particle position at the end of the step in units of voxels
+ * @param coef (A/m^2) -q w d / (dt V) along each axis so the running sums of the Esirkepov weights are currents
+ * @note particles may move at most one voxel per step along each axis, points wrap around periodic axes so charge is
+ * conserved across them and fold onto the outermost node next to walls
+ */
+template <ui_t O, bool ATOMIC>
+inline void deposit_esirkepov(const Vector3<fp_t> &j, const std::array<ui_t, 3> &extent,
+                              const std::array<ui_t, 3> &period, const std::array<fp_t, 3> &r0,
+                              const std::array<fp_t, 3> &r1, const std::array<fp_t, 3> &coef) noexcept {
+  // the stencil of the old and new positions both fit in one extra point
+  constexpr ui_t N = Stencil<O>::N;
+  constexpr ui_t M = N + 1;
+  constexpr fp_t one_third = static_cast<fp_t>(1.0 / 3.0);
+
+  std::array<std::array<fp_t, M>, 3> s0{};
+  std::array<std::array<fp_t, M>, 3> ds{};
+  std::array<std::array<ui_t, M>, 3> at{};
+
+  unroll<3>([&](auto a) {
+    // the running sums need a contiguous window so stencils are combined before wrapping or folding
+    const auto st0 = stencil<O>(r0[a], extent[a], period[a]);
+    const auto st1 = stencil<O>(r1[a], extent[a], period[a]);
+    const si_t start = std::min(st0.base, st1.base);
+    const auto o0 = static_cast<ui_t>(std::min(st0.base - start, static_cast<si_t>(1)));
+    const auto o1 = static_cast<ui_t>(std::min(st1.base - start, static_cast<si_t>(1)));
+    unroll<N>([&](auto n) {
+      s0[a][o0 + n] = st0.w[n];
+      ds[a][o1 + n] = st1.w[n];
+    });
+    unroll<M>([&](auto m) {
+      ds[a][m] -= s0[a][m];
+      at[a][m] = fold(start + static_cast<si_t>(m), extent[a], period[a]);
+    });
+  });
+
+  // x-component accumulates along x
+  for (ui_t b = 0; b < M; ++b) {
+    for (ui_t c = 0; c < M; ++c) {
+      const fp_t yz = s0[1][b] * s0[2][c] + ONE_OVER_TWO * (ds[1][b] * s0[2][c] + s0[1][b] * ds[2][c]) +
+                      one_third * ds[1][b] * ds[2][c];
+      fp_t acc = 0.0;
+      for (ui_t a = 0; a + 1 < M; ++a) {
+        acc += coef[0] * ds[0][a] * yz;
+        accumulate<ATOMIC>(j.x[at[0][a], at[1][b], at[2][c]], acc);
+      }
+    }
+  }
+
+  // y-component accumulates along y
+  for (ui_t a = 0; a < M; ++a) {
+    for (ui_t c = 0; c < M; ++c) {
+      const fp_t xz = s0[0][a] * s0[2][c] + ONE_OVER_TWO * (ds[0][a] * s0[2][c] + s0[0][a] * ds[2][c]) +
+                      one_third * ds[0][a] * ds[2][c];
+      fp_t acc = 0.0;
+      for (ui_t b = 0; b + 1 < M; ++b) {
+        acc += coef[1] * ds[1][b] * xz;
+        accumulate<ATOMIC>(j.y[at[0][a], at[1][b], at[2][c]], acc);
+      }
+    }
+  }
+
+  // z-component accumulates along z
+  for (ui_t a = 0; a < M; ++a) {
+    for (ui_t b = 0; b < M; ++b) {
+      const fp_t xy = s0[0][a] * s0[1][b] + ONE_OVER_TWO * (ds[0][a] * s0[1][b] + s0[0][a] * ds[1][b]) +
+                      one_third * ds[0][a] * ds[1][b];
+      fp_t acc = 0.0;
+      for (ui_t c = 0; c + 1 < M; ++c) {
+        acc += coef[2] * ds[2][c] * xy;
+        accumulate<ATOMIC>(j.z[at[0][a], at[1][b], at[2][c]], acc);
+      }
+    }
+  }
+}
+
+/*!
+ * deposits the current of one particle into a tile-private buffer
+ * @tparam O shape order as {0, 1, 2, 3} for {NGP, CIC, TSC, cubic}
+ * @param tc tile-private current density
+ * @param r0 particle position at the start of the step in units of voxels
+ * @param r1 particle position at the end of the step in units of voxels
+ * @param coef (A/m^2) -q w d / (dt V) along each axis
+ * @return true if the particle was deposited, false if its stencils leave the buffer and nothing was deposited
+ */
+template <ui_t O>
+[[nodiscard]] inline bool deposit_tile(TileCurrent &tc, const std::array<fp_t, 3> &r0, const std::array<fp_t, 3> &r1,
+                                       const std::array<fp_t, 3> &coef) noexcept {
+  // the Esirkepov window spans [floor(r) - 1, floor(r) + O / 2 + 3) around the old and new positions
+  constexpr ui_t reach = O / 2 + 2;
+
+  const std::array<ui_t, 3> dims = {tc.j.x.extent(0), tc.j.x.extent(1), tc.j.x.extent(2)};
+  std::array<fp_t, 3> l0{}, l1{};
+  for (ui_t a = 0; a < 3; ++a) {
+    l0[a] = r0[a] - static_cast<fp_t>(tc.origin[a]);
+    l1[a] = r1[a] - static_cast<fp_t>(tc.origin[a]);
+    const fp_t lo = std::min(l0[a], l1[a]);
+    const fp_t hi = std::max(l0[a], l1[a]);
+    if (lo < static_cast<fp_t>(reach) || hi >= static_cast<fp_t>(dims[a] - reach)) {
+      return false;
+    }
+  }
+
+  for (ui_t a = 0; a < 3; ++a) {
+    tc.lo[a] = std::min(tc.lo[a], static_cast<ui_t>(std::floor(std::min(l0[a], l1[a]))) - 1);
+    tc.hi[a] = std::max(tc.hi[a], static_cast<ui_t>(std::floor(std::max(l0[a], l1[a]))) + reach + 1);
+  }
+
+  deposit_esirkepov<O, false>(tc.j, dims, {0, 0, 0}, l0, l1, coef);
+  return true;
+}
+
+/*!
+ * adds the touched elements of a tile-private buffer onto a shared current density and zeroes them
+ * @param tc tile-private current density
+ * @param j (A/m^2) shared current density vector with electric field layout
+ * @param extent electric field voxel dimensions
+ * @param period number of voxels along each periodic axis and 0 along axes bounded by walls
+ * @note atomic updates are only issued once per touched element of a tile instead of once per particle
+ */
+inline void flush_tile(TileCurrent &tc, const Vector3<fp_t> &j, const std::array<ui_t, 3> &extent,
+                       const std::array<ui_t, 3> &period) noexcept {
+  for (ui_t a = tc.lo[0]; a < tc.hi[0]; ++a) {
+    const ui_t i = fold(tc.origin[0] + static_cast<si_t>(a), extent[0], period[0]);
+    for (ui_t b = tc.lo[1]; b < tc.hi[1]; ++b) {
+      const ui_t k = fold(tc.origin[1] + static_cast<si_t>(b), extent[1], period[1]);
+      for (ui_t c = tc.lo[2]; c < tc.hi[2]; ++c) {
+        const ui_t l = fold(tc.origin[2] + static_cast<si_t>(c), extent[2], period[2]);
+        accumulate<true>(j.x[i, k, l], tc.j.x[a, b, c]);
+        accumulate<true>(j.y[i, k, l], tc.j.y[a, b, c]);
+        accumulate<true>(j.z[i, k, l], tc.j.z[a, b, c]);
+        tc.j.x[a, b, c] = 0.0;
+        tc.j.y[a, b, c] = 0.0;
+        tc.j.z[a, b, c] = 0.0;
+      }
+    }
+  }
+
+  tc.lo = {std::numeric_limits<ui_t>::max(), std::numeric_limits<ui_t>::max(), std::numeric_limits<ui_t>::max()};
+  tc.hi = {0, 0, 0};
+}
+
+#endif // CORE_DEPOSIT_H
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "dispersive.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "numeric.h"
+#include "physical.h"
+
+void PoleCells::reset() noexcept {
+  pole = DispersiveConfig();
+  for (ui_t c = 0; c < 3; ++c) {
+    cells[c].clear();
+    j[c].clear();
+    p[c].clear();
+  }
+}
+
+std::expected<void, std::string> Dispersive::init(const std::vector<DispersiveConfig> &configs,
+                                                  const Coord3<ui_t> &dims, const Coord3<fp_t> &spacing) noexcept {
+  SPDLOG_TRACE("enter Dispersive::init");
+
+  reset();
+
+  const std::array<ui_t, 3> n = {dims.x, dims.y, dims.z};
+  const std::array<fp_t, 3> ds = {spacing.x, spacing.y, spacing.z};
+
+  for (ui_t l = 0; l < configs.size(); ++l) {
+    const auto &pc = configs[l];
+    const std::array<fp_t, 3> lo = {pc.lo.x, pc.lo.y, pc.lo.z};
+    const std::array<fp_t, 3> hi = {pc.hi.x, pc.hi.y, pc.hi.z};
+
+    PoleCells pole;
+    pole.pole = pc;
+
+    try {
+      // component c sits half a voxel along axis c and on nodes along the others
+      for (ui_t c = 0; c < 3; ++c) {
+        std::array<ui_t, 3> first = {0, 0, 0};
+        std::array<ui_t, 3> last = {0, 0, 0};
+        for (ui_t a = 0; a < 3; ++a) {
+          const fp_t shift = a == c ? static_cast<fp_t>(0.5) : static_cast<fp_t>(0.0);
+          const fp_t f = std::ceil(lo[a] / ds[a] - shift);
+          const fp_t b = std::floor(hi[a] / ds[a] - shift) + 1;
+          first[a] = f > 1 ? static_cast<ui_t>(f) : 1;
+          last[a] = std::min(b > 0 ? static_cast<ui_t>(b) : 0, n[a] - 1);
+        }
+
+        for (ui_t i = first[0]; i < last[0]; ++i) {
+          for (ui_t jj = first[1]; jj < last[1]; ++jj) {
+            for (ui_t k = first[2]; k < last[2]; ++k) {
+              pole.cells[c].push_back((i * n[1] + jj) * n[2] + k);
+            }
+          }
+        }
+
+        pole.j[c].assign(pole.cells[c].size(), static_cast<fp_t>(0.0));
+        if (pc.pole != Pole::DRUDE) {
+          pole.p[c].assign(pole.cells[c].size(), static_cast<fp_t>(0.0));
+        }
+      }
+    } catch (const std::bad_alloc &err) {
+      const auto error = fmt::format("unable to allocate memory for dispersive pole {}: {}", l, err.what());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    if (pole.cells[0].empty() && pole.cells[1].empty() && pole.cells[2].empty()) {
+      const auto error = fmt::format("dispersive pole {} does not cover any interior electric field node", l);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    SPDLOG_DEBUG("dispersive pole {} covers {} x {} x {} electric field nodes", l, pole.cells[0].size(),
+                 pole.cells[1].size(), pole.cells[2].size());
+    poles.push_back(std::move(pole));
+  }
+
+  SPDLOG_TRACE("exit Dispersive::init");
+  return {};
+}
+
+void Dispersive::reset() noexcept {
+  SPDLOG_TRACE("enter Dispersive::reset");
+
+  poles.clear();
+
+  SPDLOG_TRACE("exit Dispersive::reset");
+}
+
+void Dispersive::update_current(const Vector3<fp_t> &e, const fp_t dt) {
+  SPDLOG_TRACE("enter Dispersive::update_current");
+
+  const std::array<const fp_t *, 3> ec = {e.x.data_handle(), e.y.data_handle(), e.z.data_handle()};
+
+  for (auto &pole : poles) {
+    const auto &pc = pole.pole;
+
+    // central differences of the damping terms about the half step, debye poles relax exactly for constant fields
+    const fp_t damp = static_cast<fp_t>(1.0) + ONE_OVER_TWO * pc.gamma * dt;
+    const fp_t kj = (static_cast<fp_t>(1.0) - ONE_OVER_TWO * pc.gamma * dt) / damp;
+    const fp_t bj = pc.pole == Pole::DRUDE ? VAC_PERMITTIVITY * pc.omega_p * pc.omega_p * dt / damp
+                                           : pc.omega_0 * pc.omega_0 * dt / damp;
+    const fp_t ep_s = VAC_PERMITTIVITY * pc.delta_ep;
+    const fp_t relax = pc.pole == Pole::DEBYE ? -std::expm1(-dt / pc.tau) : static_cast<fp_t>(0.0);
+    const fp_t dt_inv = static_cast<fp_t>(1.0) / dt;
+
+    for (ui_t c = 0; c < 3; ++c) {
+      const ui_t *cells = pole.cells[c].data();
+      fp_t *j = pole.j[c].data();
+      fp_t *p = pole.p[c].data();
+      const fp_t *ev = ec[c];
+      const ui_t num = pole.cells[c].size();
+
+      switch (pc.pole) {
+      case Pole::DRUDE:
+#pragma omp parallel for schedule(static)
+        for (ui_t n = 0; n < num; ++n) {
+          j[n] = kj * j[n] + bj * ev[cells[n]];
+        }
+        break;
+      case Pole::LORENTZ:
+#pragma omp parallel for schedule(static)
+        for (ui_t n = 0; n < num; ++n) {
+          j[n] = kj * j[n] + bj * (ep_s * ev[cells[n]] - p[n]);
+          p[n] += dt * j[n];
+        }
+        break;
+      case Pole::DEBYE:
+#pragma omp parallel for schedule(static)
+        for (ui_t n = 0; n < num; ++n) {
+          const fp_t dp = relax * (ep_s * ev[cells[n]] - p[n]);
+          p[n] += dp;
+          j[n] = dp * dt_inv;
+        }
+        break;
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit Dispersive::update_current");
+}
+
+void Dispersive::apply(const Vector3<fp_t> &e, const fp_t ea, const Scalar3<uint8_t> &material,
+                       const std::vector<fp_t> &material_ea) const {
+  SPDLOG_TRACE("enter Dispersive::apply");
+
+  const std::array<fp_t *, 3> ec = {e.x.data_handle(), e.y.data_handle(), e.z.data_handle()};
+
+  // covered nodes are interior electric field nodes whose indices lie inside of the material ID volume as well
+  const bool voxelized = material.data != nullptr;
+  const ui_t ny = e.x.extent(1);
+  const ui_t nz = e.x.extent(2);
+
+  // poles are applied one after another so overlapping boxes never write the same node concurrently
+  for (const auto &pole : poles) {
+    for (ui_t c = 0; c < 3; ++c) {
+      const ui_t *cells = pole.cells[c].data();
+      const fp_t *j = pole.j[c].data();
+      fp_t *ev = ec[c];
+      const ui_t num = pole.cells[c].size();
+
+#pragma omp parallel for schedule(static)
+      for (ui_t n = 0; n < num; ++n) {
+        const ui_t idx = cells[n];
+        const fp_t a = voxelized ? material_ea[material.v[idx / (ny * nz), idx / nz % ny, idx % nz]] : ea;
+        ev[idx] -= a * j[n];
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit Dispersive::apply");
+}
+
+ui_t Dispersive::num_cells() const noexcept {
+  ui_t num = 0;
+  for (const auto &pole : poles) {
+    for (ui_t c = 0; c < 3; ++c) {
+      num += pole.cells[c].size();
+    }
+  }
+  return num;
+}
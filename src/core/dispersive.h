@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_DISPERSIVE_H
+#define CORE_DISPERSIVE_H
+
+#include <array>
+#include <expected>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "coordinate.h"
+#include "scalar.h"
+#include "type.h"
+#include "vector.h"
+
+/*!
+ * auxiliary differential equation state of a single dispersive pole stored only at the electric field nodes it covers
+ */
+struct PoleCells {
+  /// pole parameters
+  DispersiveConfig pole;
+
+  /// linear indices of covered nodes into the {x, y, z} electric field component views
+  std::array<std::vector<ui_t>, 3> cells;
+
+  /// (A/m^2) polarization current of covered nodes at the last half step
+  std::array<std::vector<fp_t>, 3> j;
+
+  /// (C/m^2) polarization of covered nodes at the last integer step
+  /// NOTE: only allocated for LORENTZ and DEBYE poles
+  std::array<std::vector<fp_t>, 3> p;
+
+  /*!
+   * resets PoleCells to default state
+   */
+  void reset() noexcept;
+};
+
+/*!
+ * Drude, Lorentz, and Debye poles integrated with auxiliary differential equations for their polarization currents
+ *
+ * every pole keeps a compact list of the electric field nodes inside its box so memory and work scale with the volume
+ * of dispersive material rather than the grid, polarization currents are advanced from the electric field of the
+ * start of a step and subtracted from the electric field update like particle currents
+ *
+ * @note the outer shell is left to the boundary conditions, Lorentz poles are stable for omega_0 * dt < 2
+ */
+struct Dispersive {
+  /// poles in input deck order
+  std::vector<PoleCells> poles;
+
+  /*!
+   * initializes Dispersive
+   * @param configs pole configurations
+   * @param dims electric field voxel dimensions
+   * @param spacing (m) voxel size along each axis
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init(const std::vector<DispersiveConfig> &configs,
+                                                      const Coord3<ui_t> &dims, const Coord3<fp_t> &spacing) noexcept;
+
+  /*!
+   * resets Dispersive to default state
+   */
+  void reset() noexcept;
+
+  /*!
+   * advances polarization currents by one step
+   * @param e electric field at the start of the step
+   * @param dt (s) time step
+   */
+  void update_current(const Vector3<fp_t> &e, fp_t dt);
+
+  /*!
+   * subtracts polarization currents from an electric field update
+   * @param e electric field after the update without polarization currents
+   * @param ea electric field a loop constant of the bounding box material
+   * @param material material ID of every voxel or an unallocated volume if the grid is not voxelized
+   * @param material_ea electric field a loop constant of every material ID
+   * @note nodes inside of voxelized geometry scale their polarization current with the loop constant of their material
+   * like the electric field update does
+   */
+  void apply(const Vector3<fp_t> &e, fp_t ea, const Scalar3<uint8_t> &material,
+             const std::vector<fp_t> &material_ea) const;
+
+  /*!
+   * number of covered nodes across all poles and components
+   * @return number of covered nodes
+   */
+  [[nodiscard]] ui_t num_cells() const noexcept;
+};
+
+#endif // CORE_DISPERSIVE_H
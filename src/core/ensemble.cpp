@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "ensemble.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include "physical.h"
+
+std::expected<void, std::string> Ensemble::init(const std::vector<EnsembleConfig> &members, const Coord3<ui_t> &dims,
+                                                const Coord3<fp_t> &spacing, const fp_t max_frequency) noexcept {
+  SPDLOG_TRACE("enter Ensemble::init");
+
+  reset();
+
+  num_members = members.size();
+  n = dims;
+  d_inv = {static_cast<fp_t>(1.0) / spacing.x, static_cast<fp_t>(1.0) / spacing.y,
+           static_cast<fp_t>(1.0) / spacing.z};
+
+  // sources are kept off the PEC shell
+  const auto nearest = [](const fp_t pos, const ui_t num) {
+    return std::clamp(static_cast<ui_t>(std::max(pos, static_cast<fp_t>(0.0))), static_cast<ui_t>(1),
+                      std::max(num, static_cast<ui_t>(2)) - 1);
+  };
+
+  // padding lanes are vacuum without a source so they remain zero
+  ep.fill(VAC_PERMITTIVITY);
+  mu.fill(VAC_PERMEABILITY);
+  for (ui_t w = 0; w < num_members; ++w) {
+    ep[w] = members[w].ep_r * VAC_PERMITTIVITY;
+    mu[w] = members[w].mu_r * VAC_PERMEABILITY;
+    sigma[w] = members[w].sigma;
+    amplitude[w] = members[w].amplitude;
+
+    // z-components lie half a voxel above their node along z
+    source[w] = {nearest(std::round(members[w].source.x * d_inv.x), n.x),
+                 nearest(std::round(members[w].source.y * d_inv.y), n.y),
+                 nearest(std::floor(members[w].source.z * d_inv.z), n.z)};
+  }
+
+  // the Gaussian envelope of the pulse spectrum falls by exp(-4) at the maximum frequency
+  tau = static_cast<fp_t>(2.0) / (std::numbers::pi_v<fp_t> * max_frequency);
+
+  const Coord3<ui_t> dims_e = {n.x + 1, n.y + 1, n.z + 1};
+
+  Batch3<fp_t> *fields[6] = {&ex, &ey, &ez, &hx, &hy, &hz};
+  constexpr const char *names[6] = {"ex", "ey", "ez", "hx", "hy", "hz"};
+
+  for (ui_t c = 0; c < 6; ++c) {
+    if (const auto result = fields[c]->init(c < 3 ? dims_e : n, static_cast<fp_t>(0.0)); !result.has_value()) {
+      const auto error = fmt::format("failed to initialize `{}`: {}", names[c], result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+
+  SPDLOG_TRACE("exit Ensemble::init");
+  return {};
+}
+
+void Ensemble::reset() noexcept {
+  SPDLOG_TRACE("enter Ensemble::reset");
+
+  num_members = 0;
+  n = {0, 0, 0};
+  d_inv = {0.0, 0.0, 0.0};
+  ep.fill(0.0);
+  mu.fill(0.0);
+  sigma.fill(0.0);
+  amplitude.fill(0.0);
+  source.fill({0, 0, 0});
+  tau = 0.0;
+  ex.reset();
+  ey.reset();
+  ez.reset();
+  hx.reset();
+  hy.reset();
+  hz.reset();
+
+  e_space = HDF5Obj();
+  h_space = HDF5Obj();
+  for (auto &set : sets) {
+    set = HDF5Obj();
+  }
+
+  SPDLOG_TRACE("exit Ensemble::reset");
+}
+
+void Ensemble::update_h(const fp_t dt) const {
+  SPDLOG_TRACE("enter Ensemble::update_h");
+
+  alignas(64) std::array<fp_t, ENSEMBLE_WIDTH> hxa;
+  alignas(64) std::array<fp_t, ENSEMBLE_WIDTH> hya;
+  alignas(64) std::array<fp_t, ENSEMBLE_WIDTH> hza;
+  for (ui_t w = 0; w < ENSEMBLE_WIDTH; ++w) {
+    hxa[w] = dt * d_inv.x / mu[w];
+    hya[w] = dt * d_inv.y / mu[w];
+    hza[w] = dt * d_inv.z / mu[w];
+  }
+
+  // magnetic components only read electric fields so all three are advanced in one sweep
+#pragma omp parallel for collapse(2)
+  for (ui_t i = 0; i < n.x; ++i) {
+    for (ui_t j = 0; j < n.y; ++j) {
+      for (ui_t k = 0; k < n.z; ++k) {
+#pragma omp simd
+        for (ui_t w = 0; w < ENSEMBLE_WIDTH; ++w) {
+          hx.v[i, j, k, w] += -hya[w] * (ez.v[i, j + 1, k, w] - ez.v[i, j, k, w]) +
+                              hza[w] * (ey.v[i, j, k + 1, w] - ey.v[i, j, k, w]);
+          hy.v[i, j, k, w] += -hza[w] * (ex.v[i, j, k + 1, w] - ex.v[i, j, k, w]) +
+                              hxa[w] * (ez.v[i + 1, j, k, w] - ez.v[i, j, k, w]);
+          hz.v[i, j, k, w] += -hxa[w] * (ey.v[i + 1, j, k, w] - ey.v[i, j, k, w]) +
+                              hya[w] * (ex.v[i, j + 1, k, w] - ex.v[i, j, k, w]);
+        }
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit Ensemble::update_h");
+}
+
+void Ensemble::update_e(const fp_t dt, const fp_t t) const {
+  SPDLOG_TRACE("enter Ensemble::update_e");
+
+  alignas(64) std::array<fp_t, ENSEMBLE_WIDTH> ea;
+  alignas(64) std::array<fp_t, ENSEMBLE_WIDTH> eb;
+  for (ui_t w = 0; w < ENSEMBLE_WIDTH; ++w) {
+    ea[w] = static_cast<fp_t>(1.0) / (ep[w] / dt + sigma[w] / static_cast<fp_t>(2.0));
+    eb[w] = ep[w] / dt - sigma[w] / static_cast<fp_t>(2.0);
+  }
+
+  // the outer shell is never updated and remains zero on PEC faces
+#pragma omp parallel for collapse(2)
+  for (ui_t i = 1; i < n.x; ++i) {
+    for (ui_t j = 1; j < n.y; ++j) {
+      for (ui_t k = 1; k < n.z; ++k) {
+#pragma omp simd
+        for (ui_t w = 0; w < ENSEMBLE_WIDTH; ++w) {
+          ex.v[i, j, k, w] = ea[w] * (eb[w] * ex.v[i, j, k, w] + d_inv.y * (hz.v[i, j, k, w] - hz.v[i, j - 1, k, w]) -
+                                      d_inv.z * (hy.v[i, j, k, w] - hy.v[i, j, k - 1, w]));
+          ey.v[i, j, k, w] = ea[w] * (eb[w] * ey.v[i, j, k, w] + d_inv.z * (hx.v[i, j, k, w] - hx.v[i, j, k - 1, w]) -
+                                      d_inv.x * (hz.v[i, j, k, w] - hz.v[i - 1, j, k, w]));
+          ez.v[i, j, k, w] = ea[w] * (eb[w] * ez.v[i, j, k, w] + d_inv.x * (hy.v[i, j, k, w] - hy.v[i - 1, j, k, w]) -
+                                      d_inv.y * (hx.v[i, j, k, w] - hx.v[i, j - 1, k, w]));
+        }
+      }
+    }
+  }
+
+  // differentiated Gaussian pulses have no DC content and so leave no static charge behind, sqrt(2 e) normalizes
+  // their peak to the amplitude
+  const fp_t x = (t - static_cast<fp_t>(4.0) * tau) / tau;
+  const fp_t pulse = std::sqrt(static_cast<fp_t>(2.0) * std::numbers::e_v<fp_t>) * x * std::exp(-x * x);
+  for (ui_t w = 0; w < num_members; ++w) {
+    const auto &s = source[w];
+    ez.v[s.x, s.y, s.z, w] -= ea[w] * amplitude[w] * pulse;
+  }
+
+  SPDLOG_TRACE("exit Ensemble::update_e");
+}
+
+ui_t Ensemble::num_field_points() const noexcept {
+  const ui_t points_e = ex.v.extent(0) * ex.v.extent(1) * ex.v.extent(2);
+  const ui_t points_h = hx.v.extent(0) * hx.v.extent(1) * hx.v.extent(2);
+  return 3 * (points_e + points_h) * num_members;
+}
+
+fp_t Ensemble::field_energy() const {
+  SPDLOG_TRACE("enter Ensemble::field_energy");
+
+  const ui_t points_e = ex.v.extent(0) * ex.v.extent(1) * ex.v.extent(2);
+  const ui_t points_h = hx.v.extent(0) * hx.v.extent(1) * hx.v.extent(2);
+  const fp_t *e_data[3] = {ex.data, ey.data, ez.data};
+  const fp_t *h_data[3] = {hx.data, hy.data, hz.data};
+
+  // squared fields are summed per lane as every member has its own material
+  double sum_e[ENSEMBLE_WIDTH] = {};
+  double sum_h[ENSEMBLE_WIDTH] = {};
+  for (ui_t c = 0; c < 3; ++c) {
+    const fp_t *fe = e_data[c];
+    const fp_t *fh = h_data[c];
+#pragma omp parallel for reduction(+ : sum_e[ : ENSEMBLE_WIDTH])
+    for (ui_t i = 0; i < points_e; ++i) {
+#pragma omp simd
+      for (ui_t l = 0; l < ENSEMBLE_WIDTH; ++l) {
+        sum_e[l] += static_cast<double>(fe[i * ENSEMBLE_WIDTH + l]) * fe[i * ENSEMBLE_WIDTH + l];
+      }
+    }
+#pragma omp parallel for reduction(+ : sum_h[ : ENSEMBLE_WIDTH])
+    for (ui_t i = 0; i < points_h; ++i) {
+#pragma omp simd
+      for (ui_t l = 0; l < ENSEMBLE_WIDTH; ++l) {
+        sum_h[l] += static_cast<double>(fh[i * ENSEMBLE_WIDTH + l]) * fh[i * ENSEMBLE_WIDTH + l];
+      }
+    }
+  }
+
+  const double dv = 1.0 / (static_cast<double>(d_inv.x) * d_inv.y * d_inv.z);
+  double energy = 0.0;
+  for (ui_t l = 0; l < num_members; ++l) {
+    energy += 0.5 * dv * (ep[l] * sum_e[l] + mu[l] * sum_h[l]);
+  }
+
+  SPDLOG_TRACE("exit Ensemble::field_energy");
+  return static_cast<fp_t>(energy);
+}
+
+std::expected<void, std::string> Ensemble::setup_datasets(const HDF5Obj &group, const ui_t num,
+                                                          const bool shrinkable) {
+  SPDLOG_TRACE("enter Ensemble::setup_datasets");
+
+  // members form a trailing dimension that only holds configured members and not padding lanes
+  const hsize_t dims_e[5] = {static_cast<hsize_t>(num), static_cast<hsize_t>(n.x + 1), static_cast<hsize_t>(n.y + 1),
+                             static_cast<hsize_t>(n.z + 1), static_cast<hsize_t>(num_members)};
+  const hsize_t dims_h[5] = {static_cast<hsize_t>(num), static_cast<hsize_t>(n.x), static_cast<hsize_t>(n.y),
+                             static_cast<hsize_t>(n.z), static_cast<hsize_t>(num_members)};
+
+  e_space = HDF5Obj(H5Screate_simple(5, dims_e, nullptr), H5Sclose);
+  h_space = HDF5Obj(H5Screate_simple(5, dims_h, nullptr), H5Sclose);
+
+  constexpr const char *names[6] = {"ex", "ey", "ez", "hx", "hy", "hz"};
+
+  if (e_space.get() < 0 || h_space.get() < 0) {
+    const auto error = fmt::format("unable to create ensemble dataspaces for `{}` logged steps", num);
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  const auto e_props = row_props(e_space, shrinkable);
+  const auto h_props = row_props(h_space, shrinkable);
+
+  for (ui_t c = 0; c < 6; ++c) {
+    const auto &space = c < 3 ? e_space : h_space;
+    const auto &props = c < 3 ? e_props : h_props;
+    sets[c] = HDF5Obj(
+        H5Dcreate(group.get(), names[c], h5_fp_t<fp_t>(), space.get(), H5P_DEFAULT, props.get(), H5P_DEFAULT),
+        H5Dclose);
+
+    if (sets[c].get() < 0) {
+      const auto error = fmt::format("unable to create ensemble dataset `{}`", names[c]);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+
+  SPDLOG_TRACE("exit Ensemble::setup_datasets");
+  return {};
+}
+
+std::expected<void, std::string> Ensemble::log(const ui_t hyperslab) const {
+  SPDLOG_TRACE("enter Ensemble::log");
+
+  const hsize_t e_count[5] = {1, static_cast<hsize_t>(n.x + 1), static_cast<hsize_t>(n.y + 1),
+                              static_cast<hsize_t>(n.z + 1), static_cast<hsize_t>(num_members)};
+  const hsize_t h_count[5] = {1, static_cast<hsize_t>(n.x), static_cast<hsize_t>(n.y), static_cast<hsize_t>(n.z),
+                              static_cast<hsize_t>(num_members)};
+  const hsize_t offset[5] = {hyperslab, 0, 0, 0, 0};
+  constexpr hsize_t mem_offset[5] = {0, 0, 0, 0, 0};
+
+  if (H5Sselect_hyperslab(e_space.get(), H5S_SELECT_SET, offset, nullptr, e_count, nullptr) < 0 ||
+      H5Sselect_hyperslab(h_space.get(), H5S_SELECT_SET, offset, nullptr, h_count, nullptr) < 0) {
+    const auto error = fmt::format("unable to select hyperslab `{}` of the ensemble dataspaces", hyperslab);
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  // memory holds every lane so only the lanes of configured members are selected
+  hsize_t e_mem[5] = {e_count[0], e_count[1], e_count[2], e_count[3], ENSEMBLE_WIDTH};
+  hsize_t h_mem[5] = {h_count[0], h_count[1], h_count[2], h_count[3], ENSEMBLE_WIDTH};
+  const auto e_memspace = HDF5Obj(H5Screate_simple(5, e_mem, nullptr), H5Sclose);
+  const auto h_memspace = HDF5Obj(H5Screate_simple(5, h_mem, nullptr), H5Sclose);
+
+  if (e_memspace.get() < 0 || h_memspace.get() < 0 ||
+      H5Sselect_hyperslab(e_memspace.get(), H5S_SELECT_SET, mem_offset, nullptr, e_count, nullptr) < 0 ||
+      H5Sselect_hyperslab(h_memspace.get(), H5S_SELECT_SET, mem_offset, nullptr, h_count, nullptr) < 0) {
+    const auto error = fmt::format("unable to select the lanes of `{}` ensemble members in memory", num_members);
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  constexpr const char *names[6] = {"ex", "ey", "ez", "hx", "hy", "hz"};
+  const fp_t *data[6] = {ex.data, ey.data, ez.data, hx.data, hy.data, hz.data};
+
+  for (ui_t c = 0; c < 6; ++c) {
+    const auto &memspace = c < 3 ? e_memspace : h_memspace;
+    const auto &space = c < 3 ? e_space : h_space;
+    if (H5Dwrite(sets[c].get(), h5_fp_t<fp_t>(), memspace.get(), space.get(), H5P_DEFAULT, data[c]) < 0) {
+      const auto error = fmt::format("unable to write hyperslab `{}` of ensemble dataset `{}`", hyperslab, names[c]);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+
+  SPDLOG_TRACE("exit Ensemble::log");
+  return {};
+}
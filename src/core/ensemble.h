@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_ENSEMBLE_H
+#define CORE_ENSEMBLE_H
+
+#include <array>
+#include <cstdlib>
+#include <expected>
+#include <fmt/format.h>
+#include <mdspan/mdspan.hpp>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "coordinate.h"
+#include "io.h"
+#include "numeric.h"
+#include "type.h"
+
+/*!
+ * 3D scalar field holding one value per ensemble member at every point
+ * @tparam T numeric type
+ * @note members are the innermost dimension so the members of one point fill a SIMD register
+ */
+template <numeric T> struct Batch3 {
+  /// data view
+  Kokkos::mdspan<T, Kokkos::extents<ui_t, Kokkos::dynamic_extent, Kokkos::dynamic_extent, Kokkos::dynamic_extent,
+                                    ENSEMBLE_WIDTH>>
+      v;
+
+  /// data container
+  T *data = nullptr;
+
+  /*!
+   * initializes Batch3
+   * @param dims field dimensions
+   * @param val initial field value
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init(const Coord3<ui_t> &dims, const T val) noexcept {
+    SPDLOG_TRACE("enter Batch3::init");
+
+    const ui_t n = dims.x * dims.y * dims.z * ENSEMBLE_WIDTH;
+
+    // every point holds a whole register so allocations are always a whole number of cache lines
+    const ui_t bytes = (n * sizeof(T) + 63) / 64 * 64;
+
+    // aligned_alloc reports failure by returning nullptr rather than throwing
+    data = static_cast<T *>(std::aligned_alloc(64, bytes));
+    if (data == nullptr) {
+      const auto error = fmt::format("unable to allocate memory for `data` with `{}` elements ({} bytes)", n, bytes);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    v = decltype(v)(data, dims.x, dims.y, dims.z);
+
+    for (ui_t i = 0; i < n; ++i) {
+      data[i] = val;
+    }
+
+    SPDLOG_TRACE("exit Batch3::init");
+    return {};
+  }
+
+  /*!
+   * resets Batch3 to default state
+   * @note this frees existing data and resets dataview
+   */
+  void reset() noexcept {
+    SPDLOG_TRACE("enter Batch3::reset");
+
+    v = decltype(v)();
+    std::free(data);
+    data = nullptr;
+
+    SPDLOG_TRACE("exit Batch3::reset");
+  }
+};
+
+/*!
+ * field-only Yee simulations of the same geometry advanced together with one member per SIMD lane
+ *
+ * every member has its own material and z-directed point source driven by a differentiated Gaussian current pulse, a
+ * single sweep of the stencil advances all members for about the memory traffic of one as the lanes of a point share
+ * cache lines
+ *
+ * @note lanes past the number of members hold vacuum without a source and stay zero, all faces are PEC
+ */
+struct Ensemble {
+  /// number of ensemble members
+  ui_t num_members = 0;
+
+  /// number of magnetic field voxels
+  Coord3<ui_t> n = {0, 0, 0};
+
+  /// (m^-1) inverse spatial increments
+  Coord3<fp_t> d_inv = {0.0, 0.0, 0.0};
+
+  /// (F/m) permittivity of every lane
+  alignas(64) std::array<fp_t, ENSEMBLE_WIDTH> ep{};
+
+  /// (H/m) permeability of every lane
+  alignas(64) std::array<fp_t, ENSEMBLE_WIDTH> mu{};
+
+  /// (S/m) conductivity of every lane
+  alignas(64) std::array<fp_t, ENSEMBLE_WIDTH> sigma{};
+
+  /// (A/m^2) peak source current density of every lane
+  alignas(64) std::array<fp_t, ENSEMBLE_WIDTH> amplitude{};
+
+  /// electric field z-component node of the source of every lane
+  std::array<Coord3<ui_t>, ENSEMBLE_WIDTH> source{};
+
+  /// (s) width of the source pulse
+  fp_t tau = 0.0;
+
+  /// (V/m) electric field x-component
+  Batch3<fp_t> ex;
+
+  /// (V/m) electric field y-component
+  Batch3<fp_t> ey;
+
+  /// (V/m) electric field z-component
+  Batch3<fp_t> ez;
+
+  /// (A/m) magnetic field x-component
+  Batch3<fp_t> hx;
+
+  /// (A/m) magnetic field y-component
+  Batch3<fp_t> hy;
+
+  /// (A/m) magnetic field z-component
+  Batch3<fp_t> hz;
+
+  /// dataspace for electric field data
+  HDF5Obj e_space;
+
+  /// dataspace for magnetic field data
+  HDF5Obj h_space;
+
+  /// datasets in {ex, ey, ez, hx, hy, hz} order
+  HDF5Obj sets[6];
+
+  /*!
+   * initializes Ensemble
+   * @param members member configurations
+   * @param dims number of magnetic field voxels
+   * @param spacing (m) voxel size along each axis
+   * @param max_frequency (Hz) highest frequency the source pulse should excite
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init(const std::vector<EnsembleConfig> &members,
+                                                      const Coord3<ui_t> &dims, const Coord3<fp_t> &spacing,
+                                                      fp_t max_frequency) noexcept;
+
+  /*!
+   * resets Ensemble to default state
+   */
+  void reset() noexcept;
+
+  /*!
+   * advances magnetic fields of every member by one time step
+   * @param dt (s) time step
+   */
+  void update_h(fp_t dt) const;
+
+  /*!
+   * advances electric fields of every member by one time step
+   * @param dt (s) time step
+   * @param t (s) time the update is centred on at which source currents are sampled
+   */
+  void update_e(fp_t dt, fp_t t) const;
+
+  /*!
+   * number of field points advanced every time step
+   * @return number of field points across all members and components
+   */
+  [[nodiscard]] ui_t num_field_points() const noexcept;
+
+  /*!
+   * reduces the electromagnetic field energy summed over all members
+   * @return (J) field energy
+   */
+  [[nodiscard]] fp_t field_energy() const;
+
+  /*!
+   * sets up dataspaces and datasets for logging
+   * @param group group to create datasets within
+   * @param num number of logged steps
+   * @param shrinkable chunks datasets by logged step so that runs stopping early can shrink them
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> setup_datasets(const HDF5Obj &group, ui_t num, bool shrinkable);
+
+  /*!
+   * logs field data of every member
+   * @param hyperslab hyperslab index to write to
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> log(ui_t hyperslab) const;
+};
+
+#endif // CORE_ENSEMBLE_H
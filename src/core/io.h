@@ -18,8 +18,10 @@
 #ifndef CORE_IO_H
 #define CORE_IO_H
 
+#include <algorithm>
 #include <hdf5.h>
 #include <utility>
+#include <vector>
 
 /*!
  * RAII HDF5 object wrapper
@@ -141,4 +143,123 @@ struct Datasets {
   HDF5Obj hz;
 };
 
+/*!
+ * dataset container for particle diagnostics of one species
+ * @note every dataset is extendible along its leading dimension which grows by one row per logging event
+ */
+struct ParticleDatasets {
+  /// group holding the datasets of the species
+  HDF5Obj group;
+
+  /// step of every row
+  HDF5Obj step;
+
+  /// number of valid samples in every row
+  HDF5Obj count;
+
+  /// sampled particles with shape {rows, max_samples, 7} in {x, y, z, ux, uy, uz, w} order
+  HDF5Obj samples;
+
+  /// weighted x-ux phase-space histogram with shape {rows, bins, bins}
+  HDF5Obj phase;
+
+  /// weighted kinetic energy spectrum with shape {rows, bins}
+  HDF5Obj spectrum;
+};
+
+/*!
+ * creates a chunked dataset that is extendible along a leading dimension of initial size zero
+ * @param group group to create dataset within
+ * @param name dataset name
+ * @param type HDF5 type of elements
+ * @param row dimensions of a single row
+ * @return dataset handle
+ * @note every row is stored as one chunk
+ */
+inline HDF5Obj create_extendible(const HDF5Obj &group, const char *name, const hid_t type,
+                                 const std::vector<hsize_t> &row) {
+  std::vector<hsize_t> dims = {0};
+  std::vector<hsize_t> max_dims = {H5S_UNLIMITED};
+  std::vector<hsize_t> chunk = {1};
+  for (const hsize_t r : row) {
+    dims.push_back(r);
+    max_dims.push_back(r);
+    chunk.push_back(r);
+  }
+
+  const auto rank = static_cast<int>(dims.size());
+  const auto space = HDF5Obj(H5Screate_simple(rank, dims.data(), max_dims.data()), H5Sclose);
+  const auto props = HDF5Obj(H5Pcreate(H5P_DATASET_CREATE), H5Pclose);
+  H5Pset_chunk(props.get(), rank, chunk.data());
+
+  return {H5Dcreate(group.get(), name, type, space.get(), H5P_DEFAULT, props.get(), H5P_DEFAULT), H5Dclose};
+}
+
+/*!
+ * appends a row to a dataset created by create_extendible
+ * @param set dataset handle
+ * @param type HDF5 type of elements in memory
+ * @param data contiguous row data
+ */
+inline void append_row(const HDF5Obj &set, const hid_t type, const void *data) {
+  auto space = HDF5Obj(H5Dget_space(set.get()), H5Sclose);
+  const int rank = H5Sget_simple_extent_ndims(space.get());
+
+  std::vector<hsize_t> dims(rank);
+  H5Sget_simple_extent_dims(space.get(), dims.data(), nullptr);
+
+  std::vector<hsize_t> offset(rank, 0);
+  offset[0] = dims[0];
+  std::vector<hsize_t> count = dims;
+  count[0] = 1;
+
+  ++dims[0];
+  H5Dset_extent(set.get(), dims.data());
+
+  space = HDF5Obj(H5Dget_space(set.get()), H5Sclose);
+  H5Sselect_hyperslab(space.get(), H5S_SELECT_SET, offset.data(), nullptr, count.data(), nullptr);
+  const auto memspace = HDF5Obj(H5Screate_simple(rank, count.data(), nullptr), H5Sclose);
+
+  H5Dwrite(set.get(), type, memspace.get(), space.get(), H5P_DEFAULT, data);
+}
+
+/*!
+ * creates dataset creation properties for a dataspace with a leading time dimension
+ * @param space dataspace of the dataset to create
+ * @param shrinkable stores every row as one chunk so that truncate_rows can later shrink the dataset
+ * @return dataset creation property list handle
+ * @note datasets that are not shrinkable keep the default contiguous layout
+ */
+inline HDF5Obj row_props(const HDF5Obj &space, const bool shrinkable) {
+  auto props = HDF5Obj(H5Pcreate(H5P_DATASET_CREATE), H5Pclose);
+  if (!shrinkable) {
+    return props;
+  }
+
+  const int rank = H5Sget_simple_extent_ndims(space.get());
+
+  std::vector<hsize_t> chunk(rank);
+  H5Sget_simple_extent_dims(space.get(), chunk.data(), nullptr);
+  chunk[0] = 1;
+
+  H5Pset_chunk(props.get(), rank, chunk.data());
+  return props;
+}
+
+/*!
+ * shrinks the leading dimension of a dataset created with shrinkable row_props
+ * @param set dataset handle
+ * @param rows number of rows to keep
+ */
+inline void truncate_rows(const HDF5Obj &set, const hsize_t rows) {
+  const auto space = HDF5Obj(H5Dget_space(set.get()), H5Sclose);
+  const int rank = H5Sget_simple_extent_ndims(space.get());
+
+  std::vector<hsize_t> dims(rank);
+  H5Sget_simple_extent_dims(space.get(), dims.data(), nullptr);
+  dims[0] = std::min(dims[0], rows);
+
+  H5Dset_extent(set.get(), dims.data());
+}
+
 #endif // CORE_IO_H
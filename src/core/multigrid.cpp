@@ -0,0 +1,479 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "multigrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void MultigridLevel::reset() noexcept {
+  n = {0, 0, 0};
+  phi.reset();
+  f.reset();
+  r.reset();
+  for (ui_t a = 0; a < 3; ++a) {
+    w_lo[a].clear();
+    w_hi[a].clear();
+    lo[a].clear();
+    hi[a].clear();
+    restriction[a].clear();
+    prolongation[a].clear();
+  }
+  first = {0, 0, 0};
+  last = {0, 0, 0};
+}
+
+std::expected<void, std::string> Multigrid::init(const Coord3<ui_t> &cells, const Coord3<fp_t> &spacing,
+                                                 const std::array<Boundary, 6> &boundary) noexcept {
+  SPDLOG_TRACE("enter Multigrid::init");
+
+  reset();
+
+  const std::array<ui_t, 3> n0 = {cells.x, cells.y, cells.z};
+  const std::array<fp_t, 3> d0 = {spacing.x, spacing.y, spacing.z};
+
+  singular = true;
+  for (ui_t a = 0; a < 3; ++a) {
+    periodic[a] = boundary[2 * a] == Boundary::PERIODIC || boundary[2 * a] == Boundary::BLOCH;
+    if (periodic[a] && n0[a] % 2 != 0) {
+      const auto error = fmt::format("multigrid requires an even number of voxels along periodic axis {}", a);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+    if (boundary[2 * a] == Boundary::PEC || boundary[2 * a + 1] == Boundary::PEC) {
+      singular = false;
+    }
+  }
+
+  // (m) node positions along each axis, coarse levels keep a subset of the nodes of the level above them
+  std::array<ui_t, 3> n = n0;
+  std::array<std::vector<fp_t>, 3> x;
+  for (ui_t a = 0; a < 3; ++a) {
+    x[a].resize(n[a] + 1);
+    for (ui_t i = 0; i <= n[a]; ++i) {
+      x[a][i] = static_cast<fp_t>(i) * d0[a];
+    }
+  }
+
+  // control volume of a node along an axis, nodes on non-periodic faces own half of their only interval
+  const auto volume = [&](const std::vector<fp_t> &xa, const ui_t i) {
+    const ui_t m = static_cast<ui_t>(xa.size()) - 1;
+    return (xa[std::min(i + 1, m)] - xa[i > 0 ? i - 1 : 0]) / static_cast<fp_t>(2.0);
+  };
+
+  while (true) {
+    MultigridLevel level;
+    level.n = {n[0], n[1], n[2]};
+
+    const Coord3<ui_t> dims = {n[0] + 1, n[1] + 1, n[2] + 1};
+    for (Scalar3<fp_t> *v : {&level.phi, &level.f, &level.r}) {
+      if (const auto result = v->init(dims, static_cast<fp_t>(0.0)); !result.has_value()) {
+        const auto error = fmt::format("failed to initialize multigrid level {}: {}", levels.size(), result.error());
+        SPDLOG_CRITICAL(error);
+        return std::unexpected(error);
+      }
+    }
+
+    for (ui_t a = 0; a < 3; ++a) {
+      auto &lo = level.lo[a];
+      auto &hi = level.hi[a];
+      lo.resize(n[a] + 1);
+      hi.resize(n[a] + 1);
+      for (ui_t i = 0; i <= n[a]; ++i) {
+        lo[i] = i > 0 ? i - 1 : 0;
+        hi[i] = i < n[a] ? i + 1 : n[a];
+      }
+
+      if (periodic[a]) {
+        // node n duplicates node 0 and is only refreshed by sync
+        lo[0] = n[a] - 1;
+        hi[n[a] - 1] = 0;
+        level.first[a] = 0;
+        level.last[a] = n[a];
+      } else {
+        // grounded faces keep their nodes at zero, symmetry planes mirror their inner neighbor
+        level.first[a] = boundary[2 * a] == Boundary::PEC ? 1 : 0;
+        lo[0] = 1;
+        level.last[a] = boundary[2 * a + 1] == Boundary::PEC ? n[a] : n[a] + 1;
+        hi[n[a]] = n[a] - 1;
+      }
+
+      // three point laplacian on possibly uneven intervals, mirrored neighbors lie as far out as they lie in
+      const auto &xa = x[a];
+      level.w_lo[a].resize(n[a] + 1);
+      level.w_hi[a].resize(n[a] + 1);
+      for (ui_t i = 0; i <= n[a]; ++i) {
+        const fp_t h_lo = i > 0 ? xa[i] - xa[i - 1] : (periodic[a] ? xa[n[a]] - xa[n[a] - 1] : xa[1] - xa[0]);
+        const fp_t h_hi = i < n[a] ? xa[i + 1] - xa[i] : xa[n[a]] - xa[n[a] - 1];
+        level.w_lo[a][i] = static_cast<fp_t>(2.0) / (h_lo * (h_lo + h_hi));
+        level.w_hi[a][i] = static_cast<fp_t>(2.0) / (h_hi * (h_lo + h_hi));
+      }
+    }
+
+    // every axis halves on its own while at least two voxels remain, periodic axes also have to stay even
+    std::array<bool, 3> coarsen{};
+    for (ui_t a = 0; a < 3; ++a) {
+      coarsen[a] = n[a] >= 4 && (!periodic[a] || n[a] % 4 == 0);
+    }
+
+    if (std::ranges::none_of(coarsen, [](bool c) { return c; })) {
+      levels.push_back(std::move(level));
+      break;
+    }
+
+    std::array<std::vector<fp_t>, 3> xc;
+    for (ui_t a = 0; a < 3; ++a) {
+      const auto &xa = x[a];
+
+      // fine index of every coarse node, odd voxel counts also keep the last node which leaves a single fine interval
+      std::vector<ui_t> kept;
+      for (ui_t i = 0; i <= n[a]; i += coarsen[a] ? 2 : 1) {
+        kept.push_back(i);
+      }
+      if (kept.back() != n[a]) {
+        kept.push_back(n[a]);
+      }
+
+      const ui_t nc = static_cast<ui_t>(kept.size()) - 1;
+      xc[a].resize(nc + 1);
+      for (ui_t c = 0; c <= nc; ++c) {
+        xc[a][c] = xa[kept[c]];
+      }
+
+      // every fine node interpolates linearly between the coarse nodes around it
+      auto &spread = level.prolongation[a];
+      spread.resize(n[a] + 1);
+      for (ui_t c = 0, i = 0; i <= n[a]; ++i) {
+        while (c < nc && kept[c + 1] <= i) {
+          ++c;
+        }
+        if (kept[c] == i) {
+          spread[i] = {{c, c}, {1.0, 0.0}};
+        } else {
+          const fp_t t = (xa[i] - xc[a][c]) / (xc[a][c + 1] - xc[a][c]);
+          spread[i] = {{c, c + 1}, {static_cast<fp_t>(1.0) - t, t}};
+        }
+      }
+
+      // restriction is the control volume weighted transpose of prolongation which is full weighting on even
+      // intervals, periodic axes are always even so their wrapped neighbors get the full weighting weights directly
+      auto &gather = level.restriction[a];
+      gather.resize(nc + 1);
+      for (ui_t c = 0; c <= nc; ++c) {
+        const ui_t f = kept[c];
+        if (!coarsen[a]) {
+          gather[c] = {{f, f, f}, {1.0, 0.0, 0.0}};
+          continue;
+        }
+        if (periodic[a]) {
+          gather[c] = {{level.lo[a][f], f, level.hi[a][f] == n[a] ? 0 : level.hi[a][f]}, {0.25, 0.5, 0.25}};
+          continue;
+        }
+
+        Taps<3> taps = {{f, f, f}, {volume(xa, f) / volume(xc[a], c), 0.0, 0.0}};
+        ui_t tap = 1;
+        for (const ui_t j : {f > 0 ? f - 1 : f, f < n[a] ? f + 1 : f}) {
+          if (j != f && spread[j].idx[0] != spread[j].idx[1]) {
+            const fp_t p = spread[j].idx[0] == c ? spread[j].w[0] : spread[j].w[1];
+            taps.idx[tap] = j;
+            taps.w[tap] = p * volume(xa, j) / volume(xc[a], c);
+          }
+          ++tap;
+        }
+        gather[c] = taps;
+      }
+    }
+
+    levels.push_back(std::move(level));
+
+    for (ui_t a = 0; a < 3; ++a) {
+      n[a] = static_cast<ui_t>(xc[a].size()) - 1;
+      x[a] = std::move(xc[a]);
+    }
+  }
+
+  // the coarsest level is only smoothed so its sweeps grow with the square of its largest node count which bounds the
+  // number of Gauss-Seidel sweeps that damp its smoothest mode
+  const ui_t widest = std::ranges::max(n) + 1;
+  coarse_sweeps = std::max<ui_t>(64, 2 * widest * widest);
+
+  SPDLOG_DEBUG("multigrid hierarchy has {} levels with coarsest level {} x {} x {}", levels.size(), n[0], n[1], n[2]);
+
+  SPDLOG_TRACE("exit Multigrid::init");
+  return {};
+}
+
+void Multigrid::reset() noexcept {
+  SPDLOG_TRACE("enter Multigrid::reset");
+
+  for (auto &level : levels) {
+    level.reset();
+  }
+  levels.clear();
+  periodic = {false, false, false};
+  singular = false;
+  coarse_sweeps = 0;
+
+  SPDLOG_TRACE("exit Multigrid::reset");
+}
+
+std::expected<ui_t, std::string> Multigrid::solve(const fp_t tolerance, const ui_t max_cycles) const {
+  SPDLOG_TRACE("enter Multigrid::solve");
+
+  const auto &fine = levels.front();
+
+  if (singular) {
+    // a constant shift of phi does not change its gradient so f is made solvable by a uniform neutralizing background,
+    // nodes on symmetry planes only own half of their control volume along each mirrored axis so the mean is weighted
+    // by control volume which is what the mirrored operator conserves
+    const std::array<ui_t, 3> n = {fine.n.x, fine.n.y, fine.n.z};
+    const auto volume = [&](const ui_t a, const ui_t i) {
+      return !periodic[a] && (i == 0 || i == n[a]) ? static_cast<fp_t>(0.5) : static_cast<fp_t>(1.0);
+    };
+
+    fp_t sum = 0.0;
+    fp_t count = 0.0;
+#pragma omp parallel for collapse(2) reduction(+ : sum, count)
+    for (ui_t i = fine.first[0]; i < fine.last[0]; ++i) {
+      for (ui_t j = fine.first[1]; j < fine.last[1]; ++j) {
+        for (ui_t k = fine.first[2]; k < fine.last[2]; ++k) {
+          const fp_t w = volume(0, i) * volume(1, j) * volume(2, k);
+          sum += w * fine.f.v[i, j, k];
+          count += w;
+        }
+      }
+    }
+
+    const fp_t mean = sum / count;
+#pragma omp parallel for collapse(2)
+    for (ui_t i = fine.first[0]; i < fine.last[0]; ++i) {
+      for (ui_t j = fine.first[1]; j < fine.last[1]; ++j) {
+        for (ui_t k = fine.first[2]; k < fine.last[2]; ++k) {
+          fine.f.v[i, j, k] -= mean;
+        }
+      }
+    }
+  }
+
+  fp_t f_norm = 0.0;
+  const ui_t num = fine.f.v.extent(0) * fine.f.v.extent(1) * fine.f.v.extent(2);
+#pragma omp parallel for reduction(+ : f_norm)
+  for (ui_t i = 0; i < num; ++i) {
+    f_norm += fine.f.data[i] * fine.f.data[i];
+  }
+  f_norm = std::sqrt(f_norm);
+
+  // a vanishing right hand side has the trivial solution
+  if (f_norm == 0.0) {
+    std::fill_n(fine.phi.data, num, static_cast<fp_t>(0.0));
+    SPDLOG_TRACE("exit Multigrid::solve");
+    return 0;
+  }
+
+  // phi only holds fp_t so its round-off divided by the squared spacing bounds the relative residual from below at
+  // roughly machine epsilon times the squared node count of the widest axis
+  const ui_t widest = std::max({fine.n.x, fine.n.y, fine.n.z}) + 1;
+  const fp_t attainable = std::numeric_limits<fp_t>::epsilon() * static_cast<fp_t>(widest * widest);
+  const fp_t target = std::max(tolerance, attainable);
+  if (target > tolerance) {
+    SPDLOG_DEBUG("multigrid tolerance `{:.3e}` lies below round-off and is raised to `{:.3e}`", tolerance, target);
+  }
+
+  fp_t rel = residual(0) / f_norm;
+  ui_t cycles = 0;
+  while (rel > target && cycles < max_cycles) {
+    cycle(0);
+    rel = residual(0) / f_norm;
+    ++cycles;
+    SPDLOG_DEBUG("multigrid cycle {} relative residual: {:.3e}", cycles, rel);
+  }
+
+  if (rel > target) {
+    const auto error = fmt::format("multigrid did not converge to `{:.3e}` within `{}` cycles (relative residual "
+                                   "`{:.3e}`)",
+                                   target, max_cycles, rel);
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  SPDLOG_TRACE("exit Multigrid::solve");
+  return cycles;
+}
+
+void Multigrid::cycle(const ui_t l) const {
+  // the coarsest level is small enough that smoothing alone solves it
+  if (l + 1 == levels.size()) {
+    smooth(l, coarse_sweeps);
+    return;
+  }
+
+  smooth(l, 2);
+  static_cast<void>(residual(l));
+  restrict_residual(l);
+
+  const auto &coarse = levels[l + 1];
+  std::fill_n(coarse.phi.data, coarse.phi.v.extent(0) * coarse.phi.v.extent(1) * coarse.phi.v.extent(2),
+              static_cast<fp_t>(0.0));
+  cycle(l + 1);
+
+  prolong_correction(l);
+  smooth(l, 2);
+}
+
+void Multigrid::smooth(const ui_t l, const ui_t sweeps) const {
+  const auto &lv = levels[l];
+
+  for (ui_t s = 0; s < sweeps; ++s) {
+    for (ui_t color = 0; color < 2; ++color) {
+#pragma omp parallel for collapse(2)
+      for (ui_t i = lv.first[0]; i < lv.last[0]; ++i) {
+        for (ui_t j = lv.first[1]; j < lv.last[1]; ++j) {
+          for (ui_t k = lv.first[2] + ((i + j + lv.first[2] + color) & 1); k < lv.last[2]; k += 2) {
+            const fp_t diag = lv.w_lo[0][i] + lv.w_hi[0][i] + lv.w_lo[1][j] + lv.w_hi[1][j] + lv.w_lo[2][k] +
+                              lv.w_hi[2][k];
+            const fp_t nb = lv.w_lo[0][i] * lv.phi.v[lv.lo[0][i], j, k] + lv.w_hi[0][i] * lv.phi.v[lv.hi[0][i], j, k] +
+                            lv.w_lo[1][j] * lv.phi.v[i, lv.lo[1][j], k] + lv.w_hi[1][j] * lv.phi.v[i, lv.hi[1][j], k] +
+                            lv.w_lo[2][k] * lv.phi.v[i, j, lv.lo[2][k]] + lv.w_hi[2][k] * lv.phi.v[i, j, lv.hi[2][k]];
+            lv.phi.v[i, j, k] = (lv.f.v[i, j, k] + nb) / diag;
+          }
+        }
+      }
+    }
+  }
+
+  sync(l, lv.phi);
+}
+
+fp_t Multigrid::residual(const ui_t l) const {
+  const auto &lv = levels[l];
+
+  fp_t norm = 0.0;
+#pragma omp parallel for collapse(2) reduction(+ : norm)
+  for (ui_t i = 0; i < lv.r.v.extent(0); ++i) {
+    for (ui_t j = 0; j < lv.r.v.extent(1); ++j) {
+      for (ui_t k = 0; k < lv.r.v.extent(2); ++k) {
+        const bool active = i >= lv.first[0] && i < lv.last[0] && j >= lv.first[1] && j < lv.last[1] &&
+                            k >= lv.first[2] && k < lv.last[2];
+        if (!active) {
+          lv.r.v[i, j, k] = 0.0;
+          continue;
+        }
+
+        const fp_t phi = lv.phi.v[i, j, k];
+        const fp_t lap = lv.w_lo[0][i] * (lv.phi.v[lv.lo[0][i], j, k] - phi) +
+                         lv.w_hi[0][i] * (lv.phi.v[lv.hi[0][i], j, k] - phi) +
+                         lv.w_lo[1][j] * (lv.phi.v[i, lv.lo[1][j], k] - phi) +
+                         lv.w_hi[1][j] * (lv.phi.v[i, lv.hi[1][j], k] - phi) +
+                         lv.w_lo[2][k] * (lv.phi.v[i, j, lv.lo[2][k]] - phi) +
+                         lv.w_hi[2][k] * (lv.phi.v[i, j, lv.hi[2][k]] - phi);
+        lv.r.v[i, j, k] = lv.f.v[i, j, k] + lap;
+        norm += lv.r.v[i, j, k] * lv.r.v[i, j, k];
+      }
+    }
+  }
+
+  return std::sqrt(norm);
+}
+
+void Multigrid::restrict_residual(const ui_t l) const {
+  const auto &fine = levels[l];
+  const auto &coarse = levels[l + 1];
+
+  // tensor product of the one dimensional restriction taps of every axis
+#pragma omp parallel for collapse(2)
+  for (ui_t i = 0; i <= coarse.n.x; ++i) {
+    for (ui_t j = 0; j <= coarse.n.y; ++j) {
+      for (ui_t k = 0; k <= coarse.n.z; ++k) {
+        const auto &ti = fine.restriction[0][i];
+        const auto &tj = fine.restriction[1][j];
+        const auto &tk = fine.restriction[2][k];
+
+        fp_t sum = 0.0;
+        for (ui_t a = 0; a < 3; ++a) {
+          for (ui_t b = 0; b < 3; ++b) {
+            for (ui_t c = 0; c < 3; ++c) {
+              sum += ti.w[a] * tj.w[b] * tk.w[c] * fine.r.v[ti.idx[a], tj.idx[b], tk.idx[c]];
+            }
+          }
+        }
+        coarse.f.v[i, j, k] = sum;
+      }
+    }
+  }
+}
+
+void Multigrid::prolong_correction(const ui_t l) const {
+  const auto &fine = levels[l];
+  const auto &coarse = levels[l + 1];
+
+#pragma omp parallel for collapse(2)
+  for (ui_t i = fine.first[0]; i < fine.last[0]; ++i) {
+    for (ui_t j = fine.first[1]; j < fine.last[1]; ++j) {
+      for (ui_t k = fine.first[2]; k < fine.last[2]; ++k) {
+        // nodes kept by the coarse level copy it and every other node lies between two coarse nodes
+        const auto &ti = fine.prolongation[0][i];
+        const auto &tj = fine.prolongation[1][j];
+        const auto &tk = fine.prolongation[2][k];
+
+        fp_t sum = 0.0;
+        for (ui_t a = 0; a < 2; ++a) {
+          for (ui_t b = 0; b < 2; ++b) {
+            for (ui_t c = 0; c < 2; ++c) {
+              sum += ti.w[a] * tj.w[b] * tk.w[c] * coarse.phi.v[ti.idx[a], tj.idx[b], tk.idx[c]];
+            }
+          }
+        }
+        fine.phi.v[i, j, k] += sum;
+      }
+    }
+  }
+
+  sync(l, fine.phi);
+}
+
+void Multigrid::sync(const ui_t l, const Scalar3<fp_t> &v) const {
+  const auto &lv = levels[l];
+
+  if (periodic[0]) {
+#pragma omp parallel for collapse(2)
+    for (ui_t j = 0; j <= lv.n.y; ++j) {
+      for (ui_t k = 0; k <= lv.n.z; ++k) {
+        v.v[lv.n.x, j, k] = v.v[0, j, k];
+      }
+    }
+  }
+
+  if (periodic[1]) {
+#pragma omp parallel for collapse(2)
+    for (ui_t i = 0; i <= lv.n.x; ++i) {
+      for (ui_t k = 0; k <= lv.n.z; ++k) {
+        v.v[i, lv.n.y, k] = v.v[i, 0, k];
+      }
+    }
+  }
+
+  if (periodic[2]) {
+#pragma omp parallel for collapse(2)
+    for (ui_t i = 0; i <= lv.n.x; ++i) {
+      for (ui_t j = 0; j <= lv.n.y; ++j) {
+        v.v[i, j, lv.n.z] = v.v[i, j, 0];
+      }
+    }
+  }
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CORE_MULTIGRID_H
+#define CORE_MULTIGRID_H
+
+#include <array>
+#include <expected>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "coordinate.h"
+#include "scalar.h"
+#include "type.h"
+
+/*!
+ * weighted one dimensional gather used by the grid transfers of the multigrid hierarchy
+ * @tparam N number of taps
+ * @note unused taps repeat a used index with zero weight
+ */
+template <ui_t N> struct Taps {
+  /// node index of every tap
+  std::array<ui_t, N> idx{};
+
+  /// weight of every tap
+  std::array<fp_t, N> w{};
+};
+
+/*!
+ * single level of the multigrid hierarchy on the nodes of a voxel grid
+ */
+struct MultigridLevel {
+  /// number of voxels along each axis, nodes are one more
+  Coord3<ui_t> n = {0, 0, 0};
+
+  /// (1/m^2) laplacian weight of the lower neighbor of every node along each axis
+  std::array<std::vector<fp_t>, 3> w_lo;
+
+  /// (1/m^2) laplacian weight of the upper neighbor of every node along each axis
+  std::array<std::vector<fp_t>, 3> w_hi;
+
+  /// solution
+  Scalar3<fp_t> phi;
+
+  /// right hand side
+  Scalar3<fp_t> f;
+
+  /// residual
+  Scalar3<fp_t> r;
+
+  /// index of lower neighbor of every node along each axis accounting for mirrored and wrapped boundaries
+  std::array<std::vector<ui_t>, 3> lo;
+
+  /// index of upper neighbor of every node along each axis accounting for mirrored and wrapped boundaries
+  std::array<std::vector<ui_t>, 3> hi;
+
+  /// first node updated along each axis
+  std::array<ui_t, 3> first = {0, 0, 0};
+
+  /// one past the last node updated along each axis
+  std::array<ui_t, 3> last = {0, 0, 0};
+
+  /// taps gathering the residual of this level into every node of the next coarser level along each axis
+  std::array<std::vector<Taps<3>>, 3> restriction;
+
+  /// taps interpolating the next coarser level onto every node of this level along each axis
+  std::array<std::vector<Taps<2>>, 3> prolongation;
+
+  /*!
+   * resets MultigridLevel to default state
+   */
+  void reset() noexcept;
+};
+
+/*!
+ * geometric multigrid solver of -laplacian(phi) = f on the nodes of the voxel grid
+ *
+ * V-cycles use red-black Gauss-Seidel smoothing threaded with OpenMP, control volume weighted restriction, and
+ * trilinear prolongation, every axis is coarsened on its own by keeping every other node, odd voxel counts keep their
+ * last node as well so the coarse levels may end in a shorter interval which the operator and transfers account for
+ *
+ * @note PEC faces are grounded (phi = 0), PMC faces are symmetry planes (zero normal derivative), and periodic faces
+ * wrap, which requires an even number of voxels along periodic axes so red-black colors stay independent, periodic
+ * axes therefore only coarsen while they stay even after halving
+ */
+struct Multigrid {
+  /// levels from finest to coarsest
+  std::vector<MultigridLevel> levels;
+
+  /// periodic flags along each axis
+  std::array<bool, 3> periodic = {false, false, false};
+
+  /// true if no face is grounded which leaves phi defined up to a constant
+  bool singular = false;
+
+  /// number of smoothing sweeps that solve the coarsest level
+  ui_t coarse_sweeps = 0;
+
+  /*!
+   * initializes Multigrid
+   * @param cells number of voxels along each axis
+   * @param spacing (m) voxel size along each axis
+   * @param boundary outer boundary conditions in {x_lo, x_hi, y_lo, y_hi, z_lo, z_hi} order
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init(const Coord3<ui_t> &cells, const Coord3<fp_t> &spacing,
+                                                      const std::array<Boundary, 6> &boundary) noexcept;
+
+  /*!
+   * resets Multigrid to default state
+   */
+  void reset() noexcept;
+
+  /*!
+   * solves for phi on the finest level given f on the finest level
+   * @param tolerance relative residual at which to stop
+   * @param max_cycles maximum number of V-cycles
+   * @return std::expected<ui_t, std::string> holding the number of V-cycles for {success, error} cases respectively
+   * @note phi is used as the initial guess, f is made free of its control volume weighted mean first if the problem is
+   * singular, tolerances below the round-off floor of fp_t on this grid are raised to that floor
+   */
+  [[nodiscard]] std::expected<ui_t, std::string> solve(fp_t tolerance, ui_t max_cycles) const;
+
+  /*!
+   * runs one V-cycle starting at a level
+   * @param l level index
+   */
+  void cycle(ui_t l) const;
+
+  /*!
+   * red-black Gauss-Seidel sweeps
+   * @param l level index
+   * @param sweeps number of sweeps
+   */
+  void smooth(ui_t l, ui_t sweeps) const;
+
+  /*!
+   * calculates the residual of a level
+   * @param l level index
+   * @return L2 norm of residual
+   */
+  [[nodiscard]] fp_t residual(ui_t l) const;
+
+  /*!
+   * restricts the residual of a level to the right hand side of the next coarser level
+   * @param l level index
+   */
+  void restrict_residual(ui_t l) const;
+
+  /*!
+   * interpolates the solution of the next coarser level and adds it to the solution of a level
+   * @param l level index
+   */
+  void prolong_correction(ui_t l) const;
+
+  /*!
+   * copies the first node plane onto the last along periodic axes
+   * @param l level index
+   * @param v field to synchronize
+   */
+  void sync(ui_t l, const Scalar3<fp_t> &v) const;
+};
+
+#endif // CORE_MULTIGRID_H
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "particle.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+
+std::expected<void, std::string> Particles::init(const ui_t cap) noexcept {
+  SPDLOG_TRACE("enter Particles::init");
+
+  reset();
+
+  if (const auto result = reserve(cap); !result.has_value()) {
+    SPDLOG_CRITICAL(result.error());
+    return std::unexpected(result.error());
+  }
+
+  SPDLOG_TRACE("exit Particles::init");
+  return {};
+}
+
+void Particles::reset() noexcept {
+  SPDLOG_TRACE("enter Particles::reset");
+
+  std::free(arena);
+  arena = nullptr;
+  x = y = z = ux = uy = uz = w = spare = nullptr;
+  num = 0;
+  capacity = 0;
+
+  SPDLOG_TRACE("exit Particles::reset");
+}
+
+std::expected<void, std::string> Particles::reserve(const ui_t cap) noexcept {
+  SPDLOG_TRACE("enter Particles::reserve");
+
+  if (cap <= capacity) {
+    SPDLOG_TRACE("exit Particles::reserve");
+    return {};
+  }
+
+  // power of two capacities of at least one cache line keep every column aligned and amortize growth
+  const ui_t new_capacity = std::bit_ceil(std::max(cap, LINE));
+  const ui_t bytes = (NUM_COLUMNS + 1) * new_capacity * sizeof(fp_t);
+
+  auto *new_arena = static_cast<fp_t *>(std::aligned_alloc(64, bytes));
+  if (new_arena == nullptr) {
+    const auto error =
+        fmt::format("unable to allocate particle arena for `{}` particles ({} bytes)", new_capacity, bytes);
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  const auto old_columns = columns();
+  for (ui_t c = 0; c < NUM_COLUMNS; ++c) {
+    if (num > 0) {
+      std::memcpy(new_arena + c * new_capacity, old_columns[c], num * sizeof(fp_t));
+    }
+  }
+
+  std::free(arena);
+  arena = new_arena;
+  capacity = new_capacity;
+
+  x = arena;
+  y = arena + capacity;
+  z = arena + 2 * capacity;
+  ux = arena + 3 * capacity;
+  uy = arena + 4 * capacity;
+  uz = arena + 5 * capacity;
+  w = arena + 6 * capacity;
+  spare = arena + 7 * capacity;
+  SPDLOG_DEBUG("particle arena grown to {} particles ({} bytes)", capacity, bytes);
+
+  SPDLOG_TRACE("exit Particles::reserve");
+  return {};
+}
+
+std::expected<void, std::string> Particles::push(const std::array<fp_t, NUM_COLUMNS> &vals) noexcept {
+  if (num == capacity) {
+    // capacities are powers of two so this doubles the arena
+    if (const auto result = reserve(capacity + 1); !result.has_value()) {
+      return std::unexpected(result.error());
+    }
+  }
+
+  const auto cols = columns();
+  for (ui_t c = 0; c < NUM_COLUMNS; ++c) {
+    cols[c][num] = vals[c];
+  }
+  ++num;
+
+  return {};
+}
+
+void Particles::permute(const ui_t *dest) noexcept {
+  SPDLOG_TRACE("enter Particles::permute");
+
+  // each column is scattered into the spare slot which then takes its place, so only one column of scratch is needed
+  for (fp_t **col : {&x, &y, &z, &ux, &uy, &uz, &w}) {
+    const fp_t *src = *col;
+    fp_t *dst = spare;
+
+#pragma omp parallel for schedule(static)
+    for (ui_t i = 0; i < num; ++i) {
+      dst[dest[i]] = src[i];
+    }
+
+    std::swap(*col, spare);
+  }
+
+  SPDLOG_TRACE("exit Particles::permute");
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_PARTICLE_H
+#define CORE_PARTICLE_H
+
+#include <array>
+#include <expected>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+#include "type.h"
+
+/*!
+ * structure-of-arrays macroparticle storage
+ *
+ * all columns live back to back in a single 64 byte aligned arena whose per-column capacity is a power of two and a
+ * whole number of cache lines, so every column starts on a cache line and sweeps over one column never share lines
+ * with another, one additional spare column slot serves as scratch when reordering particles
+ *
+ * @note particle order is not stable as removal swaps the last particle into the freed slot
+ */
+struct Particles {
+  /// number of columns in {x, y, z, ux, uy, uz, w} order
+  static constexpr ui_t NUM_COLUMNS = 7;
+
+  /// number of fp_t elements in a 64 byte cache line
+  static constexpr ui_t LINE = 64 / sizeof(fp_t);
+
+  /// number of live particles
+  ui_t num = 0;
+
+  /// number of particles each column can hold before the arena grows
+  ui_t capacity = 0;
+
+  /// 64 byte aligned allocation holding all columns
+  fp_t *arena = nullptr;
+
+  /// (m) x-position column
+  fp_t *x = nullptr;
+
+  /// (m) y-position column
+  fp_t *y = nullptr;
+
+  /// (m) z-position column
+  fp_t *z = nullptr;
+
+  /// (m/s) x-component of proper velocity (gamma * v) column
+  fp_t *ux = nullptr;
+
+  /// (m/s) y-component of proper velocity (gamma * v) column
+  fp_t *uy = nullptr;
+
+  /// (m/s) z-component of proper velocity (gamma * v) column
+  fp_t *uz = nullptr;
+
+  /// number of physical particles represented by each macroparticle column
+  fp_t *w = nullptr;
+
+  /// spare column slot used as scratch by permute
+  fp_t *spare = nullptr;
+
+  /*!
+   * initializes Particles
+   * @param cap minimum number of particles to hold without growing
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init(ui_t cap) noexcept;
+
+  /*!
+   * resets Particles to default state
+   * @note this frees the arena
+   */
+  void reset() noexcept;
+
+  /*!
+   * grows the arena to hold at least cap particles
+   * @param cap minimum number of particles to hold without growing
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   * @note live particles are preserved, nothing happens if the arena is already large enough
+   */
+  [[nodiscard]] std::expected<void, std::string> reserve(ui_t cap) noexcept;
+
+  /*!
+   * appends a particle, growing the arena geometrically if required
+   * @param vals particle state in {x, y, z, ux, uy, uz, w} order
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> push(const std::array<fp_t, NUM_COLUMNS> &vals) noexcept;
+
+  /*!
+   * removes a particle in O(1) by moving the last particle into its slot
+   * @param idx index of particle to remove
+   */
+  void remove(ui_t idx) noexcept {
+    const ui_t last = num - 1;
+    for (fp_t *col : columns()) {
+      col[idx] = col[last];
+    }
+    num = last;
+  }
+
+  /*!
+   * reorders particles so particle i moves to dest[i]
+   * @param dest destination of every live particle, must be a permutation of [0, num)
+   * @note columns are scattered one at a time into the spare slot which then takes the place of the column
+   */
+  void permute(const ui_t *dest) noexcept;
+
+  /*!
+   * column handles
+   * @return column pointers in {x, y, z, ux, uy, uz, w} order
+   */
+  [[nodiscard]] std::array<fp_t *, NUM_COLUMNS> columns() const noexcept { return {x, y, z, ux, uy, uz, w}; }
+};
+
+/*!
+ * particle species
+ */
+struct Species {
+  /// species name
+  std::string name;
+
+  /// (C) charge of a single physical particle
+  fp_t charge = 0.0;
+
+  /// (kg) mass of a single physical particle
+  fp_t mass = 0.0;
+
+  /// macroparticles of species
+  Particles p;
+
+  /// offsets of the particles of each tile in tile-major order with one trailing entry holding the particle count
+  /// NOTE: only valid while sorted is true
+  std::vector<ui_t> tile_offsets;
+
+  /// true if particles have been sorted and none were removed since
+  bool sorted = false;
+
+  /// true if particles have been sorted and none were added, removed, or moved since so that every voxel is one run
+  /// NOTE: pushes keep the tile partition of sorted but leave particles in the voxel they were sorted into
+  bool ordered = false;
+};
+
+#endif // CORE_PARTICLE_H
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_PUSHER_H
+#define CORE_PUSHER_H
+
+#include <cmath>
+
+#include "config.h"
+#include "numeric.h"
+#include "particle.h"
+#include "physical.h"
+#include "type.h"
+
+/*!
+ * fields interpolated to a batch of particles
+ * @note arrays are cache line aligned so the pusher loop vectorizes with aligned loads
+ */
+struct FieldBatch {
+  /// (V/m) electric field components
+  alignas(64) fp_t ex[Particles::LINE];
+  alignas(64) fp_t ey[Particles::LINE];
+  alignas(64) fp_t ez[Particles::LINE];
+
+  /// (T) magnetic flux density components
+  alignas(64) fp_t bx[Particles::LINE];
+  alignas(64) fp_t by[Particles::LINE];
+  alignas(64) fp_t bz[Particles::LINE];
+};
+
+/*!
+ * positions of a batch of particles at the start of a step
+ */
+struct PositionBatch {
+  /// (m) position components
+  alignas(64) fp_t x[Particles::LINE];
+  alignas(64) fp_t y[Particles::LINE];
+  alignas(64) fp_t z[Particles::LINE];
+};
+
+/*!
+ * advances proper velocities and positions of a batch of particles by one time step
+ * @tparam P pusher algorithm
+ * @param p particles
+ * @param start index of first particle in batch
+ * @param len number of particles in batch (at most Particles::LINE)
+ * @param f fields interpolated to particles
+ * @param qdt2m (C s / kg) charge * time step / (2 * mass)
+ * @param dt (s) time step
+ * @note Boris rotates about B / gamma(u-) whereas Higuera-Cary uses the gamma that makes the rotation volume
+ * preserving and keeps E x B drifts correct at relativistic velocities
+ */
+template <Pusher P>
+inline void push_batch(const Particles &p, const ui_t start, const ui_t len, const FieldBatch &f, const fp_t qdt2m,
+                       const fp_t dt) noexcept {
+  constexpr fp_t c_inv_sq = static_cast<fp_t>(1.0) / (VAC_SPEED_OF_LIGHT * VAC_SPEED_OF_LIGHT);
+
+  fp_t *__restrict x = p.x + start;
+  fp_t *__restrict y = p.y + start;
+  fp_t *__restrict z = p.z + start;
+  fp_t *__restrict ux = p.ux + start;
+  fp_t *__restrict uy = p.uy + start;
+  fp_t *__restrict uz = p.uz + start;
+
+#pragma omp simd
+  for (ui_t n = 0; n < len; ++n) {
+    // first half acceleration
+    const fp_t um_x = ux[n] + qdt2m * f.ex[n];
+    const fp_t um_y = uy[n] + qdt2m * f.ey[n];
+    const fp_t um_z = uz[n] + qdt2m * f.ez[n];
+    const fp_t um_sq = um_x * um_x + um_y * um_y + um_z * um_z;
+
+    // (dimensionless) rotation vector before the gamma factor is applied
+    const fp_t tau_x = qdt2m * f.bx[n];
+    const fp_t tau_y = qdt2m * f.by[n];
+    const fp_t tau_z = qdt2m * f.bz[n];
+
+    fp_t gamma;
+    if constexpr (P == Pusher::BORIS) {
+      gamma = std::sqrt(static_cast<fp_t>(1.0) + um_sq * c_inv_sq);
+    } else {
+      const fp_t tau_sq = tau_x * tau_x + tau_y * tau_y + tau_z * tau_z;
+      const fp_t u_tau = (um_x * tau_x + um_y * tau_y + um_z * tau_z) * std::sqrt(c_inv_sq);
+      const fp_t sigma = static_cast<fp_t>(1.0) + um_sq * c_inv_sq - tau_sq;
+      gamma = std::sqrt(ONE_OVER_TWO *
+                        (sigma + std::sqrt(sigma * sigma + static_cast<fp_t>(4.0) * (tau_sq + u_tau * u_tau))));
+    }
+
+    // magnetic rotation
+    const fp_t t_x = tau_x / gamma;
+    const fp_t t_y = tau_y / gamma;
+    const fp_t t_z = tau_z / gamma;
+    const fp_t t_sq = t_x * t_x + t_y * t_y + t_z * t_z;
+
+    fp_t up_x, up_y, up_z;
+    if constexpr (P == Pusher::BORIS) {
+      const fp_t s = static_cast<fp_t>(2.0) / (static_cast<fp_t>(1.0) + t_sq);
+      const fp_t uq_x = um_x + (um_y * t_z - um_z * t_y);
+      const fp_t uq_y = um_y + (um_z * t_x - um_x * t_z);
+      const fp_t uq_z = um_z + (um_x * t_y - um_y * t_x);
+      up_x = um_x + s * (uq_y * t_z - uq_z * t_y);
+      up_y = um_y + s * (uq_z * t_x - uq_x * t_z);
+      up_z = um_z + s * (uq_x * t_y - uq_y * t_x);
+    } else {
+      const fp_t s = static_cast<fp_t>(1.0) / (static_cast<fp_t>(1.0) + t_sq);
+      const fp_t u_t = um_x * t_x + um_y * t_y + um_z * t_z;
+      const fp_t uq_x = s * (um_x + u_t * t_x + (um_y * t_z - um_z * t_y));
+      const fp_t uq_y = s * (um_y + u_t * t_y + (um_z * t_x - um_x * t_z));
+      const fp_t uq_z = s * (um_z + u_t * t_z + (um_x * t_y - um_y * t_x));
+      up_x = uq_x + (uq_y * t_z - uq_z * t_y);
+      up_y = uq_y + (uq_z * t_x - uq_x * t_z);
+      up_z = uq_z + (uq_x * t_y - uq_y * t_x);
+    }
+
+    // second half acceleration
+    ux[n] = up_x + qdt2m * f.ex[n];
+    uy[n] = up_y + qdt2m * f.ey[n];
+    uz[n] = up_z + qdt2m * f.ez[n];
+
+    // position update with the new velocity
+    const fp_t dt_gamma =
+        dt / std::sqrt(static_cast<fp_t>(1.0) + (ux[n] * ux[n] + uy[n] * uy[n] + uz[n] * uz[n]) * c_inv_sq);
+    x[n] += ux[n] * dt_gamma;
+    y[n] += uy[n] * dt_gamma;
+    z[n] += uz[n] * dt_gamma;
+  }
+}
+
+#endif // CORE_PUSHER_H
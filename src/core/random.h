@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CORE_RANDOM_H
+#define CORE_RANDOM_H
+
+#include <array>
+#include <cstdint>
+
+#include "type.h"
+
+/*!
+ * Philox4x32-10 counter-based random number generator of Salmon et al. (2011)
+ *
+ * every (counter, key) pair maps to four independent 32 bit random numbers without any state, so draws addressed by
+ * e.g. {step, chunk, particle} do not depend on which thread makes them or in which order
+ */
+struct Philox {
+  /// generator key (e.g., {seed, stream})
+  std::array<uint32_t, 2> key = {0, 0};
+
+  /*!
+   * draws four random numbers
+   * @param ctr counter identifying the draw
+   * @return four independent uniformly distributed 32 bit integers
+   */
+  [[nodiscard]] std::array<uint32_t, 4> operator()(std::array<uint32_t, 4> ctr) const noexcept {
+    constexpr uint64_t M0 = 0xD2511F53;
+    constexpr uint64_t M1 = 0xCD9E8D57;
+    constexpr uint32_t W0 = 0x9E3779B9;
+    constexpr uint32_t W1 = 0xBB67AE85;
+
+    std::array<uint32_t, 2> k = key;
+    for (ui_t round = 0; round < 10; ++round) {
+      const uint64_t p0 = M0 * ctr[0];
+      const uint64_t p1 = M1 * ctr[2];
+      ctr = {static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ k[0], static_cast<uint32_t>(p1),
+             static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ k[1], static_cast<uint32_t>(p0)};
+      k[0] += W0;
+      k[1] += W1;
+    }
+
+    return ctr;
+  }
+
+  /*!
+   * draws four uniform floating point numbers
+   * @param ctr counter identifying the draw
+   * @return four independent uniform numbers in (0, 1]
+   */
+  [[nodiscard]] std::array<fp_t, 4> uniform(const std::array<uint32_t, 4> &ctr) const noexcept {
+    constexpr fp_t scale = static_cast<fp_t>(1.0) / static_cast<fp_t>(4294967296.0);
+
+    const auto r = (*this)(ctr);
+    return {(static_cast<fp_t>(r[0]) + static_cast<fp_t>(1.0)) * scale,
+            (static_cast<fp_t>(r[1]) + static_cast<fp_t>(1.0)) * scale,
+            (static_cast<fp_t>(r[2]) + static_cast<fp_t>(1.0)) * scale,
+            (static_cast<fp_t>(r[3]) + static_cast<fp_t>(1.0)) * scale};
+  }
+};
+
+#endif // CORE_RANDOM_H
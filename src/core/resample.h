@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CORE_RESAMPLE_H
+#define CORE_RESAMPLE_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "particle.h"
+#include "physical.h"
+#include "type.h"
+
+/*!
+ * merges macroparticles of one cell and momentum octant into a pair following Vranic et al. (2015)
+ *
+ * the pair shares the total weight equally, sits at the weighted centroid, and carries equal and opposite momentum
+ * components perpendicular to the total momentum so total charge, momentum, and kinetic energy are conserved
+ *
+ * @param p particles
+ * @param idx indices of the particles to merge
+ * @param n number of particles to merge, must be at least three
+ * @note the pair overwrites the first two slots and the remaining slots are marked for removal with zero weight
+ */
+inline void merge_particles(Particles &p, const ui_t *idx, const ui_t n) noexcept {
+  constexpr fp_t c_inv_sq = static_cast<fp_t>(1.0) / (VAC_SPEED_OF_LIGHT * VAC_SPEED_OF_LIGHT);
+
+  // totals of weight, weighted position, momentum per unit mass, and gamma
+  fp_t wt = 0.0;
+  std::array<fp_t, 3> r = {0.0, 0.0, 0.0};
+  std::array<fp_t, 3> u = {0.0, 0.0, 0.0};
+  fp_t g = 0.0;
+  for (ui_t m = 0; m < n; ++m) {
+    const ui_t q = idx[m];
+    const fp_t w = p.w[q];
+    wt += w;
+    r[0] += w * p.x[q];
+    r[1] += w * p.y[q];
+    r[2] += w * p.z[q];
+    u[0] += w * p.ux[q];
+    u[1] += w * p.uy[q];
+    u[2] += w * p.uz[q];
+    g += w * std::sqrt(static_cast<fp_t>(1.0) + (p.ux[q] * p.ux[q] + p.uy[q] * p.uy[q] + p.uz[q] * p.uz[q]) * c_inv_sq);
+  }
+
+  // every member of the pair carries the mean gamma and the mean momentum along the total momentum
+  const fp_t gm = g / wt;
+  const fp_t um = VAC_SPEED_OF_LIGHT * std::sqrt(std::max(gm * gm - static_cast<fp_t>(1.0), static_cast<fp_t>(0.0)));
+  const fp_t ut = std::sqrt(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
+  const fp_t cos_t = um > 0.0 ? std::min(ut / (wt * um), static_cast<fp_t>(1.0)) : static_cast<fp_t>(1.0);
+  const fp_t sin_t = std::sqrt(static_cast<fp_t>(1.0) - cos_t * cos_t);
+
+  // e1 along the total momentum and e2 perpendicular to it in the plane of the first particle momentum
+  std::array<fp_t, 3> e1 = {1.0, 0.0, 0.0};
+  if (ut > 0.0) {
+    e1 = {u[0] / ut, u[1] / ut, u[2] / ut};
+  }
+  const ui_t first = idx[0];
+  std::array<fp_t, 3> e2 = {p.ux[first], p.uy[first], p.uz[first]};
+  fp_t proj = e2[0] * e1[0] + e2[1] * e1[1] + e2[2] * e1[2];
+  e2 = {e2[0] - proj * e1[0], e2[1] - proj * e1[1], e2[2] - proj * e1[2]};
+  fp_t norm = std::sqrt(e2[0] * e2[0] + e2[1] * e2[1] + e2[2] * e2[2]);
+  if (norm <= static_cast<fp_t>(1e-6) * (um + ut / wt)) {
+    // first particle is parallel to the total momentum so any perpendicular direction will do
+    e2 = std::abs(e1[0]) < static_cast<fp_t>(0.9) ? std::array<fp_t, 3>{1.0, 0.0, 0.0}
+                                                  : std::array<fp_t, 3>{0.0, 1.0, 0.0};
+    proj = e2[0] * e1[0] + e2[1] * e1[1] + e2[2] * e1[2];
+    e2 = {e2[0] - proj * e1[0], e2[1] - proj * e1[1], e2[2] - proj * e1[2]};
+    norm = std::sqrt(e2[0] * e2[0] + e2[1] * e2[1] + e2[2] * e2[2]);
+  }
+  e2 = {e2[0] / norm, e2[1] / norm, e2[2] / norm};
+
+  const fp_t sign[2] = {1.0, -1.0};
+  for (ui_t m = 0; m < 2; ++m) {
+    const ui_t q = idx[m];
+    p.x[q] = r[0] / wt;
+    p.y[q] = r[1] / wt;
+    p.z[q] = r[2] / wt;
+    p.ux[q] = um * (cos_t * e1[0] + sign[m] * sin_t * e2[0]);
+    p.uy[q] = um * (cos_t * e1[1] + sign[m] * sin_t * e2[1]);
+    p.uz[q] = um * (cos_t * e1[2] + sign[m] * sin_t * e2[2]);
+    p.w[q] = static_cast<fp_t>(0.5) * wt;
+  }
+
+  for (ui_t m = 2; m < n; ++m) {
+    p.w[idx[m]] = 0.0;
+  }
+}
+
+/*!
+ * splits a macroparticle into two halves displaced symmetrically about its position
+ * @param p particles
+ * @param q index of particle to split, receives the first half
+ * @param offset (m) displacement of each half along {x, y, z}, must keep both halves inside the cell of the particle
+ * @return state of the second half in {x, y, z, ux, uy, uz, w} order
+ * @note both halves keep the momentum of the original so charge, momentum, energy, and the centroid are conserved
+ */
+inline std::array<fp_t, Particles::NUM_COLUMNS> split_particle(Particles &p, const ui_t q,
+                                                               const std::array<fp_t, 3> &offset) noexcept {
+  p.w[q] *= static_cast<fp_t>(0.5);
+  const std::array<fp_t, Particles::NUM_COLUMNS> half = {
+      p.x[q] - offset[0], p.y[q] - offset[1], p.z[q] - offset[2], p.ux[q], p.uy[q], p.uz[q], p.w[q]};
+  p.x[q] += offset[0];
+  p.y[q] += offset[1];
+  p.z[q] += offset[2];
+
+  return half;
+}
+
+#endif // CORE_RESAMPLE_H
@@ -51,18 +51,15 @@ template <numeric T> struct Scalar3 {
 
     const ui_t n = dims.x * dims.y * dims.z;
 
-    if (n * sizeof(T) % 64 != 0) {
-      const auto error =
-          fmt::format("number of elements `{}` cannot be aligned to 64 byte boundary for type {}", n, type_name<T>());
-      SPDLOG_CRITICAL(error);
-      return std::unexpected(error);
-    }
+    // allocations are padded to a whole number of cache lines so arbitrary dimensions (e.g., coarse multigrid levels)
+    // remain valid for aligned_alloc
+    const ui_t bytes = (n * sizeof(T) + 63) / 64 * 64;
 
     try {
-      data = static_cast<T *>(std::aligned_alloc(64, sizeof(T) * n));
+      data = static_cast<T *>(std::aligned_alloc(64, bytes));
     } catch (const std::bad_alloc &err) {
       const auto error = fmt::format("unable to allocate memory for `data` with `{}` elements ({} bytes): {}", n,
-                                     n * sizeof(T), err.what());
+                                     bytes, err.what());
       SPDLOG_CRITICAL(error);
       return std::unexpected(error);
     }
@@ -92,4 +89,124 @@ template <numeric T> struct Scalar3 {
   }
 };
 
+/*!
+ * 2D scalar field
+ * @tparam T numeric type
+ */
+template <numeric T> struct Scalar2 {
+  /// data view
+  Kokkos::mdspan<T, Kokkos::dextents<ui_t, 2>> v;
+
+  /// data container
+  T *data = nullptr;
+
+  /*!
+   * initializes Scalar2
+   * @param dims field dimensions
+   * @param val initial field value
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init(const Coord2<ui_t> &dims, const T val) noexcept {
+    SPDLOG_TRACE("enter Scalar2::init");
+
+    const ui_t n = dims.x * dims.y;
+
+    // allocations are padded to a whole number of cache lines so that the electric and magnetic field lengths, which
+    // differ by one node per axis, remain valid for aligned_alloc
+    const ui_t bytes = (n * sizeof(T) + 63) / 64 * 64;
+
+    try {
+      data = static_cast<T *>(std::aligned_alloc(64, bytes));
+    } catch (const std::bad_alloc &err) {
+      const auto error = fmt::format("unable to allocate memory for `data` with `{}` elements ({} bytes): {}", n,
+                                     bytes, err.what());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    v = Kokkos::mdspan(data, dims.x, dims.y);
+
+    for (ui_t i = 0; i < n; ++i) {
+      data[i] = val;
+    }
+
+    SPDLOG_TRACE("exit Scalar2::init");
+    return {};
+  }
+
+  /*!
+   * resets Scalar2 to default state
+   * @note this frees existing data and resets dataview
+   */
+  void reset() noexcept {
+    SPDLOG_TRACE("enter Scalar2::reset");
+
+    v = Kokkos::mdspan<T, Kokkos::dextents<ui_t, 2>>();
+    std::free(data);
+    data = nullptr;
+
+    SPDLOG_TRACE("exit Scalar2::reset");
+  }
+};
+
+/*!
+ * 1D scalar field
+ * @tparam T numeric type
+ */
+template <numeric T> struct Scalar1 {
+  /// data view
+  Kokkos::mdspan<T, Kokkos::dextents<ui_t, 1>> v;
+
+  /// data container
+  T *data = nullptr;
+
+  /*!
+   * initializes Scalar1
+   * @param dims field dimensions
+   * @param val initial field value
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init(const Coord1<ui_t> &dims, const T val) noexcept {
+    SPDLOG_TRACE("enter Scalar1::init");
+
+    const ui_t n = dims.x;
+
+    // allocations are padded to a whole number of cache lines so that the electric and magnetic field lengths, which
+    // differ by one node per axis, remain valid for aligned_alloc
+    const ui_t bytes = (n * sizeof(T) + 63) / 64 * 64;
+
+    try {
+      data = static_cast<T *>(std::aligned_alloc(64, bytes));
+    } catch (const std::bad_alloc &err) {
+      const auto error = fmt::format("unable to allocate memory for `data` with `{}` elements ({} bytes): {}", n,
+                                     bytes, err.what());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    v = Kokkos::mdspan(data, dims.x);
+
+    for (ui_t i = 0; i < n; ++i) {
+      data[i] = val;
+    }
+
+    SPDLOG_TRACE("exit Scalar1::init");
+    return {};
+  }
+
+  /*!
+   * resets Scalar1 to default state
+   * @note this frees existing data and resets dataview
+   */
+  void reset() noexcept {
+    SPDLOG_TRACE("enter Scalar1::reset");
+
+    v = Kokkos::mdspan<T, Kokkos::dextents<ui_t, 1>>();
+    std::free(data);
+    data = nullptr;
+
+    SPDLOG_TRACE("exit Scalar1::reset");
+  }
+};
+
 #endif // CORE_SCALAR_H
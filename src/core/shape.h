@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_SHAPE_H
+#define CORE_SHAPE_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+#include "numeric.h"
+#include "type.h"
+
+/*!
+ * invokes f with std::integral_constant<ui_t, i> for i in [0, N) without a runtime loop
+ * @tparam N number of invocations
+ * @tparam F callable type
+ * @param f callable
+ */
+template <ui_t N, typename F> constexpr void unroll(F &&f) {
+  [&]<ui_t... I>(std::integer_sequence<ui_t, I...>) {
+    (f(std::integral_constant<ui_t, I>{}), ...);
+  }(std::make_integer_sequence<ui_t, N>{});
+}
+
+/*!
+ * one dimensional interpolation stencil of a B-spline shape function
+ * @tparam O shape order as {0, 1, 2, 3} for {NGP, CIC, TSC, cubic}
+ */
+template <ui_t O> struct Stencil {
+  /// number of grid points touched
+  static constexpr ui_t N = O + 1;
+
+  /// index of first grid point before wrapping or folding which may lie outside of the grid
+  si_t base = 0;
+
+  /// indices of grid points [base, base + N) after wrapping or folding onto the grid
+  std::array<ui_t, N> idx{};
+
+  /// weights of grid points [base, base + N)
+  std::array<fp_t, N> w{};
+};
+
+/*!
+ * maps a grid point index that may lie outside of the grid onto it
+ * @param i grid point index
+ * @param extent number of grid points along this axis
+ * @param period number of grid points per period if the axis wraps, 0 if it is bounded by walls
+ * @return i modulo period on wrapping axes, otherwise the nearest grid point inside of [0, extent)
+ */
+[[nodiscard]] inline ui_t fold(const si_t i, const ui_t extent, const ui_t period) noexcept {
+  if (period > 0) {
+    const auto p = static_cast<si_t>(period);
+    return static_cast<ui_t>((i % p + p) % p);
+  }
+  return static_cast<ui_t>(std::clamp(i, static_cast<si_t>(0), static_cast<si_t>(extent) - 1));
+}
+
+/*!
+ * computes the stencil of a particle along one axis
+ * @tparam O shape order as {0, 1, 2, 3} for {NGP, CIC, TSC, cubic}
+ * @param xi particle position in units of grid points of the field component along this axis
+ * @param extent number of grid points of the field component along this axis
+ * @param period number of grid points per period if the axis wraps, 0 if it is bounded by walls
+ * @return stencil whose points wrap around periodic axes and fold onto the outermost grid point next to walls
+ * @note folding keeps the weights of points past a wall on the grid so the weights still sum to one
+ */
+template <ui_t O>
+[[nodiscard]] inline Stencil<O> stencil(const fp_t xi, const ui_t extent, const ui_t period = 0) noexcept {
+  static_assert(O <= 3, "shape functions are only implemented up to cubic order");
+
+  Stencil<O> s;
+  si_t &base = s.base;
+
+  if constexpr (O == 0) {
+    base = static_cast<si_t>(std::floor(xi + ONE_OVER_TWO));
+    s.w = {1.0};
+  } else if constexpr (O == 1) {
+    base = static_cast<si_t>(std::floor(xi));
+    const fp_t dx = xi - static_cast<fp_t>(base);
+    s.w = {static_cast<fp_t>(1.0) - dx, dx};
+  } else if constexpr (O == 2) {
+    const fp_t nearest = std::floor(xi + ONE_OVER_TWO);
+    base = static_cast<si_t>(nearest) - 1;
+    const fp_t dx = xi - nearest;
+    s.w = {ONE_OVER_TWO * (ONE_OVER_TWO - dx) * (ONE_OVER_TWO - dx), static_cast<fp_t>(0.75) - dx * dx,
+           ONE_OVER_TWO * (ONE_OVER_TWO + dx) * (ONE_OVER_TWO + dx)};
+  } else {
+    const fp_t left = std::floor(xi);
+    base = static_cast<si_t>(left) - 1;
+    const fp_t dx = xi - left;
+    const fp_t dx_sq = dx * dx;
+    const fp_t dx_cu = dx_sq * dx;
+    constexpr fp_t sixth = static_cast<fp_t>(1.0 / 6.0);
+    s.w = {sixth * (static_cast<fp_t>(1.0) - dx) * (static_cast<fp_t>(1.0) - dx) * (static_cast<fp_t>(1.0) - dx),
+           sixth * (static_cast<fp_t>(4.0) - static_cast<fp_t>(6.0) * dx_sq + static_cast<fp_t>(3.0) * dx_cu),
+           sixth * (static_cast<fp_t>(1.0) + static_cast<fp_t>(3.0) * (dx + dx_sq - dx_cu)), sixth * dx_cu};
+  }
+
+  unroll<Stencil<O>::N>([&](auto n) { s.idx[n] = fold(base + static_cast<si_t>(n), extent, period); });
+
+  return s;
+}
+
+/*!
+ * interpolates a field component with a separable shape function
+ * @tparam O shape order
+ * @tparam V mdspan type of field component
+ * @param v field component
+ * @param sx stencil along x
+ * @param sy stencil along y
+ * @param sz stencil along z
+ * @return interpolated value
+ */
+template <ui_t O, typename V>
+[[nodiscard]] inline fp_t interpolate(const V &v, const Stencil<O> &sx, const Stencil<O> &sy,
+                                      const Stencil<O> &sz) noexcept {
+  fp_t sum = 0.0;
+  unroll<Stencil<O>::N>([&](auto a) {
+    unroll<Stencil<O>::N>([&](auto b) {
+      const fp_t wab = sx.w[a] * sy.w[b];
+      unroll<Stencil<O>::N>([&](auto c) { sum += wab * sz.w[c] * v[sx.idx[a], sy.idx[b], sz.idx[c]]; });
+    });
+  });
+  return sum;
+}
+
+#endif // CORE_SHAPE_H
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "spectral.h"
+
+#include <numbers>
+#include <omp.h>
+
+std::expected<void, std::string> Spectral::init(const Coord3<ui_t> &dims, const Coord3<fp_t> &spacing) noexcept {
+  SPDLOG_TRACE("enter Spectral::init");
+
+  n = dims;
+  d = spacing;
+  nz_c = n.z / 2 + 1;
+
+  const ui_t n_real = n.x * n.y * n.z;
+  const ui_t n_spec = n.x * n.y * nz_c;
+
+  real = static_cast<fp_t *>(FFTW(malloc)(6 * n_real * sizeof(fp_t)));
+  spec = static_cast<std::complex<fp_t> *>(FFTW(malloc)(6 * n_spec * sizeof(std::complex<fp_t>)));
+  if (real == nullptr || spec == nullptr) {
+    const auto error = fmt::format("unable to allocate spectral buffers for `{}` real and `{}` complex elements",
+                                   6 * n_real, 6 * n_spec);
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  if (FFTW(init_threads)() == 0) {
+    const auto error = fmt::format("unable to initialize threaded FFTW");
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  FFTW(plan_with_nthreads)(omp_get_max_threads());
+  SPDLOG_DEBUG("planning batched transforms with {} threads", omp_get_max_threads());
+
+  const int rank_dims[3] = {static_cast<int>(n.x), static_cast<int>(n.y), static_cast<int>(n.z)};
+
+  // all six components are transformed by a single batched plan, FFTW_MEASURE overwrites the buffers which is fine as
+  // they are always filled by gather before use
+  forward = FFTW(plan_many_dft_r2c)(3, rank_dims, 6, real, nullptr, 1, static_cast<int>(n_real),
+                                    reinterpret_cast<FFTW(complex) *>(spec), nullptr, 1, static_cast<int>(n_spec),
+                                    FFTW_MEASURE);
+  backward = FFTW(plan_many_dft_c2r)(3, rank_dims, 6, reinterpret_cast<FFTW(complex) *>(spec), nullptr, 1,
+                                     static_cast<int>(n_spec), real, nullptr, 1, static_cast<int>(n_real),
+                                     FFTW_MEASURE | FFTW_DESTROY_INPUT);
+  if (forward == nullptr || backward == nullptr) {
+    const auto error = fmt::format("unable to plan batched transforms of size {} x {} x {}", n.x, n.y, n.z);
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  kx = wavenumbers(n.x, d.x, false);
+  ky = wavenumbers(n.y, d.y, false);
+  kz = wavenumbers(n.z, d.z, true);
+
+  SPDLOG_TRACE("exit Spectral::init");
+  return {};
+}
+
+void Spectral::reset() noexcept {
+  SPDLOG_TRACE("enter Spectral::reset");
+
+  if (forward != nullptr) {
+    FFTW(destroy_plan)(forward);
+  }
+  if (backward != nullptr) {
+    FFTW(destroy_plan)(backward);
+  }
+  forward = nullptr;
+  backward = nullptr;
+
+  FFTW(free)(real);
+  FFTW(free)(spec);
+  real = nullptr;
+  spec = nullptr;
+
+  n = {0, 0, 0};
+  nz_c = 0;
+  d = {0.0, 0.0, 0.0};
+  kx.clear();
+  ky.clear();
+  kz.clear();
+
+  SPDLOG_TRACE("exit Spectral::reset");
+}
+
+void Spectral::advance(const Vector3<fp_t> &e, const Vector3<fp_t> &h, const fp_t dt, const fp_t ep,
+                       const fp_t mu) const {
+  SPDLOG_TRACE("enter Spectral::advance");
+
+  gather(e, h);
+  FFTW(execute)(forward);
+
+  const ui_t n_spec = n.x * n.y * nz_c;
+  const fp_t c = static_cast<fp_t>(1.0) / std::sqrt(ep * mu);
+
+  std::complex<fp_t> *ex = spec;
+  std::complex<fp_t> *ey = spec + n_spec;
+  std::complex<fp_t> *ez = spec + 2 * n_spec;
+  std::complex<fp_t> *hx = spec + 3 * n_spec;
+  std::complex<fp_t> *hy = spec + 4 * n_spec;
+  std::complex<fp_t> *hz = spec + 5 * n_spec;
+
+  constexpr std::complex<fp_t> I(0.0, 1.0);
+
+#pragma omp parallel for collapse(2)
+  for (ui_t i = 0; i < n.x; ++i) {
+    for (ui_t j = 0; j < n.y; ++j) {
+      for (ui_t k = 0; k < nz_c; ++k) {
+        const ui_t idx = (i * n.y + j) * nz_c + k;
+
+        // forward (p) and backward (m) half-cell shifted wavenumbers, E -> H derivatives use p, H -> E use m
+        const std::complex<fp_t> px = kx[i], py = ky[j], pz = kz[k];
+        const std::complex<fp_t> mx = std::conj(px), my = std::conj(py), mz = std::conj(pz);
+
+        const fp_t kk = std::norm(px) + std::norm(py) + std::norm(pz);
+        if (kk == static_cast<fp_t>(0.0)) [[unlikely]] {
+          continue;
+        }
+
+        const fp_t omega = c * std::sqrt(kk);
+        const fp_t cos_wt = std::cos(omega * dt);
+        const fp_t sin_wt = std::sin(omega * dt);
+
+        const std::complex<fp_t> e0x = ex[idx], e0y = ey[idx], e0z = ez[idx];
+        const std::complex<fp_t> h0x = hx[idx], h0y = hy[idx], h0z = hz[idx];
+
+        // longitudinal parts do not evolve without sources
+        const std::complex<fp_t> div_e = (mx * e0x + my * e0y + mz * e0z) / kk;
+        const std::complex<fp_t> div_h = (px * h0x + py * h0y + pz * h0z) / kk;
+        const std::complex<fp_t> elx = px * div_e, ely = py * div_e, elz = pz * div_e;
+        const std::complex<fp_t> hlx = mx * div_h, hly = my * div_h, hlz = mz * div_h;
+
+        const std::complex<fp_t> ae = I * (sin_wt / (omega * ep));
+        const std::complex<fp_t> ah = I * (sin_wt / (omega * mu));
+
+        ex[idx] = elx + cos_wt * (e0x - elx) + ae * (my * h0z - mz * h0y);
+        ey[idx] = ely + cos_wt * (e0y - ely) + ae * (mz * h0x - mx * h0z);
+        ez[idx] = elz + cos_wt * (e0z - elz) + ae * (mx * h0y - my * h0x);
+        hx[idx] = hlx + cos_wt * (h0x - hlx) - ah * (py * e0z - pz * e0y);
+        hy[idx] = hly + cos_wt * (h0y - hly) - ah * (pz * e0x - px * e0z);
+        hz[idx] = hlz + cos_wt * (h0z - hlz) - ah * (px * e0y - py * e0x);
+      }
+    }
+  }
+
+  FFTW(execute)(backward);
+  scatter(e, h);
+
+  SPDLOG_TRACE("exit Spectral::advance");
+}
+
+void Spectral::gather(const Vector3<fp_t> &e, const Vector3<fp_t> &h) const {
+  SPDLOG_TRACE("enter Spectral::gather");
+
+  const ui_t n_real = n.x * n.y * n.z;
+
+#pragma omp parallel for collapse(2)
+  for (ui_t i = 0; i < n.x; ++i) {
+    for (ui_t j = 0; j < n.y; ++j) {
+      for (ui_t k = 0; k < n.z; ++k) {
+        const ui_t idx = (i * n.y + j) * n.z + k;
+        real[idx] = e.x[i, j, k];
+        real[n_real + idx] = e.y[i, j, k];
+        real[2 * n_real + idx] = e.z[i, j, k];
+        real[3 * n_real + idx] = h.x[i, j, k];
+        real[4 * n_real + idx] = h.y[i, j, k];
+        real[5 * n_real + idx] = h.z[i, j, k];
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit Spectral::gather");
+}
+
+void Spectral::scatter(const Vector3<fp_t> &e, const Vector3<fp_t> &h) const {
+  SPDLOG_TRACE("enter Spectral::scatter");
+
+  const ui_t n_real = n.x * n.y * n.z;
+
+  // backward transforms are unnormalized
+  const fp_t norm = static_cast<fp_t>(1.0) / static_cast<fp_t>(n_real);
+
+#pragma omp parallel for collapse(2)
+  for (ui_t i = 0; i < n.x + 1; ++i) {
+    for (ui_t j = 0; j < n.y + 1; ++j) {
+      for (ui_t k = 0; k < n.z + 1; ++k) {
+        // the wrapping electric field plane is the periodic image of the first plane
+        const ui_t ip = i % n.x, jp = j % n.y, kp = k % n.z;
+        const ui_t idx = (ip * n.y + jp) * n.z + kp;
+
+        e.x[i, j, k] = norm * real[idx];
+        e.y[i, j, k] = norm * real[n_real + idx];
+        e.z[i, j, k] = norm * real[2 * n_real + idx];
+
+        if (i < n.x && j < n.y && k < n.z) {
+          h.x[i, j, k] = norm * real[3 * n_real + idx];
+          h.y[i, j, k] = norm * real[4 * n_real + idx];
+          h.z[i, j, k] = norm * real[5 * n_real + idx];
+        }
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit Spectral::scatter");
+}
+
+std::vector<std::complex<fp_t>> Spectral::wavenumbers(const ui_t num, const fp_t ds, const bool half) {
+  SPDLOG_TRACE("enter Spectral::wavenumbers");
+
+  const ui_t len = half ? num / 2 + 1 : num;
+  std::vector<std::complex<fp_t>> k(len);
+
+  for (ui_t m = 0; m < len; ++m) {
+    // negative frequencies are stored in the upper half of full spectra
+    const auto signed_m = m <= num / 2 ? static_cast<fp_t>(m) : static_cast<fp_t>(m) - static_cast<fp_t>(num);
+    const fp_t kr = static_cast<fp_t>(2.0 * std::numbers::pi) * signed_m / (static_cast<fp_t>(num) * ds);
+
+    if (num % 2 == 0 && m == num / 2) {
+      k[m] = {0.0, 0.0};
+    } else {
+      k[m] = kr * std::polar(static_cast<fp_t>(1.0), kr * ds / static_cast<fp_t>(2.0));
+    }
+  }
+
+  SPDLOG_TRACE("exit Spectral::wavenumbers");
+  return k;
+}
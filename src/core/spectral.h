@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_SPECTRAL_H
+#define CORE_SPECTRAL_H
+
+#include <complex>
+#include <expected>
+#include <fftw3.h>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+#include "coordinate.h"
+#include "type.h"
+#include "vector.h"
+
+/// FFTW symbol matching fp_t (e.g., FFTW(execute) is fftw_execute for double and fftwf_execute for float)
+#if EPPIC_USE_FLOAT
+#define FFTW(name) fftwf_##name
+#else
+#define FFTW(name) fftw_##name
+#endif
+
+/*!
+ * pseudo-spectral analytical time-domain (PSATD) field solver
+ *
+ * fields are advanced in Fourier space with the exact solution of the source-free Maxwell equations over one time
+ * step, which is free of numerical dispersion and of any Courant limit
+ *
+ * @note the domain is periodic with the magnetic field voxel dimensions, components stay on their Yee locations by
+ * means of half-cell shift factors so the output layout matches the Yee engine
+ */
+struct Spectral {
+  /// real space grid dimensions (magnetic field voxel dimensions)
+  Coord3<ui_t> n = {0, 0, 0};
+
+  /// number of complex points along z after a real-to-complex transform
+  ui_t nz_c = 0;
+
+  /// contiguous real space buffer holding {ex, ey, ez, hx, hy, hz} back to back
+  fp_t *real = nullptr;
+
+  /// contiguous Fourier space buffer holding {ex, ey, ez, hx, hy, hz} back to back
+  std::complex<fp_t> *spec = nullptr;
+
+  /// batched forward transform of all six components
+  FFTW(plan) forward = nullptr;
+
+  /// batched backward transform of all six components
+  FFTW(plan) backward = nullptr;
+
+  /// (rad/m) wavenumbers along x multiplied by the forward half-cell shift exp(i kx dx / 2)
+  /// NOTE: the backward half-cell shifted wavenumber is the complex conjugate
+  std::vector<std::complex<fp_t>> kx;
+
+  /// (rad/m) wavenumbers along y multiplied by the forward half-cell shift exp(i ky dy / 2)
+  std::vector<std::complex<fp_t>> ky;
+
+  /// (rad/m) wavenumbers along z multiplied by the forward half-cell shift exp(i kz dz / 2)
+  std::vector<std::complex<fp_t>> kz;
+
+  /// (m) spatial increments in all directions
+  Coord3<fp_t> d = {0.0, 0.0, 0.0};
+
+  /*!
+   * initializes Spectral
+   * @param dims magnetic field voxel dimensions
+   * @param spacing (m) spatial increments in all directions
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init(const Coord3<ui_t> &dims, const Coord3<fp_t> &spacing) noexcept;
+
+  /*!
+   * resets Spectral to default state
+   * @note this destroys transform plans and frees existing buffers
+   */
+  void reset() noexcept;
+
+  /*!
+   * advances electric and magnetic fields by one time step
+   * @param e (V/m) electric field vector
+   * @param h (A/m) magnetic field vector
+   * @param dt (s) time step
+   * @param ep (F/m) permittivity
+   * @param mu (H/m) permeability
+   */
+  void advance(const Vector3<fp_t> &e, const Vector3<fp_t> &h, fp_t dt, fp_t ep, fp_t mu) const;
+
+  /*!
+   * copies fields into the real space buffer
+   * @param e (V/m) electric field vector
+   * @param h (A/m) magnetic field vector
+   */
+  void gather(const Vector3<fp_t> &e, const Vector3<fp_t> &h) const;
+
+  /*!
+   * copies the normalized real space buffer back into fields
+   * @param e (V/m) electric field vector
+   * @param h (A/m) magnetic field vector
+   * @note the wrapping electric field plane at the end of each axis receives the periodic image of the first plane
+   */
+  void scatter(const Vector3<fp_t> &e, const Vector3<fp_t> &h) const;
+
+  /*!
+   * calculates wavenumbers of a discrete Fourier transform
+   * @param num number of real space points
+   * @param ds (m) spatial increment
+   * @param half {true, false} for {real-to-complex (non-negative only), full} spectra respectively
+   * @return (rad/m) half-cell shifted wavenumbers where the Nyquist wavenumber is zeroed to keep derivatives real
+   */
+  [[nodiscard]] static std::vector<std::complex<fp_t>> wavenumbers(ui_t num, fp_t ds, bool half);
+};
+
+#endif // CORE_SPECTRAL_H
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "sweep.h"
+
+#include <algorithm>
+#include <omp.h>
+#include <unordered_set>
+
+#include "world.h"
+
+std::expected<void, std::string> Sweep::init(const std::string &input_file_path, const std::string &id) noexcept {
+  SPDLOG_TRACE("enter Sweep::init");
+
+  auto deck = Config::read(input_file_path);
+  if (!deck.has_value()) {
+    SPDLOG_CRITICAL(deck.error());
+    return std::unexpected(deck.error());
+  }
+  auto &base = deck.value();
+
+  if (!base.contains("sweep")) {
+    SPDLOG_DEBUG("no `[sweep]` table found ... running a single configuration");
+    SPDLOG_TRACE("exit Sweep::init");
+    return {};
+  }
+
+  // NOTE: only used for its parsing diagnostics
+  Config parser;
+
+  if (auto result = parser.parse_item<ui_t>(base, "sweep", "workers"); result.has_value()) {
+    workers = result.value();
+  } else {
+    return std::unexpected(result.error());
+  }
+
+  if (!base.at("sweep").contains("runs") || !base.at("sweep").at("runs").is_array()) {
+    const std::string error = "`[sweep]` does not contain any `[[sweep.runs]]` tables ... please correct and rerun";
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  const auto entries = base.at("sweep").at("runs").as_array();
+
+  // the driver settings are of no meaning to the individual runs
+  base.as_table().erase("sweep");
+
+  for (const auto &entry : entries) {
+    SweepRun run;
+
+    if (auto result = parser.parse_entry<std::string>(entry, "[sweep.runs]", "name"); result.has_value()) {
+      run.name = result.value();
+    } else {
+      return std::unexpected(result.error());
+    }
+
+    // every key besides the name overrides the input deck, dotted keys address nested tables
+    auto overrides = entry;
+    overrides.as_table().erase("name");
+
+    run.config = base;
+    if (const auto result = merge(run.config, overrides, ""); !result.has_value()) {
+      const std::string error = fmt::format("failed to apply overrides of run `{}`: {}", run.name, result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    runs.push_back(std::move(run));
+  }
+
+  if (workers == 0) {
+    const std::string error = "`[sweep] workers` is not within accepted range ... please correct and rerun";
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  SPDLOG_DEBUG("`[sweep] workers` passed all checks");
+
+  std::unordered_set<std::string> names;
+  for (const auto &run : runs) {
+    // run names become HDF5 group names directly below the file root
+    if (run.name.empty() || run.name.find_first_of("/.") != std::string::npos) {
+      const std::string error = fmt::format(
+          "`[[sweep.runs]] name` of `{}` is empty or contains `/` or `.` ... please correct and rerun", run.name);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+    if (!names.insert(run.name).second) {
+      const std::string error =
+          fmt::format("`[[sweep.runs]] name` of `{}` is not unique ... please correct and rerun", run.name);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+  SPDLOG_DEBUG("`[[sweep.runs]] name` passed all checks");
+
+  // every run is validated up front so a bad override does not surface hours into a sweep
+  std::filesystem::path out;
+  for (const auto &run : runs) {
+    Config cfg;
+    if (const auto result = cfg.init(run.config); !result.has_value()) {
+      const std::string error = fmt::format("run `{}` is not a valid configuration: {}", run.name, result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+    if (!out.empty() && cfg.out != out) {
+      const std::string error =
+          fmt::format("run `{}` overrides `[data] out_dir` ... please remove the override and rerun", run.name);
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+    out = cfg.out;
+  }
+  SPDLOG_DEBUG("`[[sweep.runs]]` passed all checks");
+
+  const auto result = World::init_filesystem(out, id);
+  if (!result.has_value()) {
+    const auto error = fmt::format("failed to initialize output filesystem: {}", result.error());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  io_dir = result.value();
+
+  SPDLOG_INFO("sweep of {} runs on {} workers", runs.size(), std::min<ui_t>(workers, runs.size()));
+
+  SPDLOG_TRACE("exit Sweep::init");
+  return {};
+}
+
+void Sweep::reset() noexcept {
+  SPDLOG_TRACE("enter Sweep::reset");
+
+  workers = 0;
+  runs.clear();
+  io_dir.clear();
+
+  SPDLOG_TRACE("exit Sweep::reset");
+}
+
+std::expected<void, std::string> Sweep::run() {
+  SPDLOG_TRACE("enter Sweep::run");
+
+  const auto file =
+      HDF5Obj(H5Fcreate((io_dir / "data.h5").c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT), H5Fclose);
+  SPDLOG_DEBUG("created output HDF5 file at `{}`", (io_dir / "data.h5").string());
+
+  // groups are created up front so that workers only ever write below their own group
+  std::vector<HDF5Obj> groups;
+  groups.reserve(runs.size());
+  for (const auto &run : runs) {
+    groups.emplace_back(H5Gcreate(file.get(), run.name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), H5Gclose);
+  }
+
+  const ui_t num_workers = std::min<ui_t>(workers, runs.size());
+
+  // threads beyond the workers are split evenly between them for the kernels of each run
+  const int inner = std::max(1, omp_get_max_threads() / static_cast<int>(num_workers));
+  omp_set_max_active_levels(2);
+  SPDLOG_DEBUG("{} workers with {} threads each", num_workers, inner);
+
+  // one World per worker keeps its field buffers alive from one run to the next
+  std::vector<World> worlds(num_workers);
+  std::vector<std::string> errors(runs.size());
+
+#pragma omp parallel for num_threads(num_workers) schedule(dynamic, 1)
+  for (ui_t r = 0; r < runs.size(); ++r) {
+    omp_set_num_threads(inner);
+    World &world = worlds[omp_get_thread_num()];
+
+    SPDLOG_INFO("begin sweep run `{}`", runs[r].name);
+
+    // NOTE: releases the HDF5 handles of the previous run of this worker
+#pragma omp critical(hdf5)
+    world.reset(true);
+
+    if (const auto result = world.init(runs[r].config, std::move(groups[r])); !result.has_value()) {
+      errors[r] = result.error();
+      continue;
+    }
+
+    if (const auto result = world.run(); !result.has_value()) {
+      errors[r] = result.error();
+      continue;
+    }
+
+    SPDLOG_INFO("sweep run `{}` successfully completed", runs[r].name);
+  }
+
+  for (auto &world : worlds) {
+    world.reset();
+  }
+
+  std::string error;
+  for (ui_t r = 0; r < runs.size(); ++r) {
+    if (!errors[r].empty()) {
+      error += fmt::format("{}run `{}` failed: {}", error.empty() ? "" : "; ", runs[r].name, errors[r]);
+    }
+  }
+  if (!error.empty()) {
+    SPDLOG_CRITICAL(error);
+    SPDLOG_TRACE("exit Sweep::run with failure");
+    return std::unexpected(error);
+  }
+
+  SPDLOG_TRACE("exit Sweep::run with success");
+  return {};
+}
+
+std::expected<void, std::string> Sweep::merge(toml::basic_value<toml::type_config> &base,
+                                              const toml::basic_value<toml::type_config> &overrides,
+                                              const std::string &prefix) noexcept {
+  for (const auto &[key, value] : overrides.as_table()) {
+    const auto dotted = prefix.empty() ? key : fmt::format("{}.{}", prefix, key);
+
+    if (!base.contains(key)) {
+      return std::unexpected(fmt::format("override `{}` does not exist in the input deck", dotted));
+    }
+
+    auto &target = base.at(key);
+    if (value.is_table() && target.is_table()) {
+      if (const auto result = merge(target, value, dotted); !result.has_value()) {
+        return result;
+      }
+    } else {
+      SPDLOG_DEBUG("overriding `{}`", dotted);
+      target = value;
+    }
+  }
+
+  return {};
+}
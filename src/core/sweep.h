@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_SWEEP_H
+#define CORE_SWEEP_H
+
+#include <expected>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "type.h"
+
+/*!
+ * single run of a parameter sweep
+ */
+struct SweepRun {
+  /// unique run name which also names the HDF5 group the run writes to
+  std::string name;
+
+  /// input deck with the overrides of this run applied
+  toml::basic_value<toml::type_config> config;
+};
+
+/*!
+ * in-process parameter sweep over overrides of a single input deck
+ *
+ * runs are handed out dynamically to worker threads that each own one World, which is reset between runs so that
+ * field buffers are reused whenever consecutive runs of a worker share a grid
+ *
+ * @note all runs write into their own group of one HDF5 file and HDF5 calls are serialized between workers
+ */
+struct Sweep {
+  /// number of runs advanced concurrently
+  ui_t workers = 0;
+
+  /// runs in input deck order
+  std::vector<SweepRun> runs;
+
+  /// unique output directory of the sweep
+  std::filesystem::path io_dir;
+
+  /*!
+   * initializes Sweep from the optional `[sweep]` table of an input deck
+   * @param input_file_path path to input configuration file
+   * @param id unique run identifier
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   * @note runs stay empty if the input deck has no `[sweep]` table
+   */
+  [[nodiscard]] std::expected<void, std::string> init(const std::string &input_file_path,
+                                                      const std::string &id) noexcept;
+
+  /*!
+   * resets Sweep to default state
+   */
+  void reset() noexcept;
+
+  /*!
+   * advances every run to its configured end time
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   * @note a failed run does not stop the others, the error lists every failed run
+   */
+  [[nodiscard]] std::expected<void, std::string> run();
+
+  /*!
+   * recursively applies overrides to an input deck
+   * @param base input deck to modify
+   * @param overrides tables of values that replace those of base
+   * @param prefix dotted key of the tables being merged for diagnostics
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   * @note overriding a key that base does not contain is an error so that misspelled keys do not go unnoticed
+   */
+  [[nodiscard]] static std::expected<void, std::string> merge(toml::basic_value<toml::type_config> &base,
+                                                              const toml::basic_value<toml::type_config> &overrides,
+                                                              const std::string &prefix) noexcept;
+};
+
+#endif // CORE_SWEEP_H
@@ -19,8 +19,12 @@
 #define CORE_TYPE_H
 
 #include <H5Tpublic.h>
+#include <cxxabi.h>
+#include <memory>
+#include <spdlog/spdlog.h>
 #include <string>
 #include <type_traits>
+#include <typeinfo>
 
 /// floating point type (e.g., double or float)
 #if EPPIC_USE_FLOAT
@@ -42,6 +46,9 @@ using ui_t = uint64_t;
 // ensure ui_t is either uint64_t or uint32_t to use correct HDF5 and MPI type aliases
 static_assert(std::is_same_v<ui_t, uint64_t> || std::is_same_v<ui_t, uint32_t>);
 
+/// signed integer type matching ui_t (e.g., for stencil offsets that may step outside of a field)
+using si_t = std::make_signed_t<ui_t>;
+
 /// HDF5 floating point type
 template <typename T> hid_t h5_fp_t();
 
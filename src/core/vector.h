@@ -20,6 +20,7 @@
 
 #include <concepts>
 #include <cstdlib>
+#include <cstring>
 #include <expected>
 #include <fmt/format.h>
 #include <mdspan/mdspan.hpp>
@@ -52,47 +53,54 @@ template <numeric T> struct Vector3 {
   /// z-component data container
   T *z_data = nullptr;
 
+  /// number of spare x-planes allocated past the views for shifting without copies
+  ui_t spare = 0;
+
+  /// number of x-planes the views currently start past the data containers
+  ui_t offset = 0;
+
   /*!
    * initializes Vector3
    * @param dims field dimensions
    * @param val initial field value
+   * @param spare_planes number of spare x-planes to allocate for shift
    * @return std::expected<void, std::string> for {success, error} cases respectively
    */
-  [[nodiscard]] std::expected<void, std::string> init(const Coord3<ui_t> &dims, const T val) noexcept {
+  [[nodiscard]] std::expected<void, std::string> init(const Coord3<ui_t> &dims, const T val,
+                                                      const ui_t spare_planes = 0) noexcept {
     SPDLOG_TRACE("enter Vector3::init");
 
     const ui_t n = dims.x * dims.y * dims.z;
 
-    if (n * sizeof(T) % 64 != 0) {
-      const auto error =
-          fmt::format("number of elements `{}` cannot be aligned to 64 byte boundary for type {}", n, type_name<T>());
-      SPDLOG_CRITICAL(error);
-      return std::unexpected(error);
-    }
+    spare = spare_planes;
+    offset = 0;
+
+    // fields and spare planes are padded to a whole number of cache lines so the total remains valid for aligned_alloc
+    const ui_t bytes = (sizeof(T) * (n + spare * dims.y * dims.z) + 63) / 64 * 64;
 
     try {
-      x_data = static_cast<T *>(std::aligned_alloc(64, sizeof(T) * n));
+      x_data = static_cast<T *>(std::aligned_alloc(64, bytes));
     } catch (const std::bad_alloc &err) {
       const auto error = fmt::format("unable to allocate memory for `x_data` with `{}` elements ({} bytes): {}", n,
-                                     n * sizeof(T), err.what());
+                                     bytes, err.what());
       SPDLOG_CRITICAL(error);
       return std::unexpected(error);
     }
 
     try {
-      y_data = static_cast<T *>(std::aligned_alloc(64, sizeof(T) * n));
+      y_data = static_cast<T *>(std::aligned_alloc(64, bytes));
     } catch (const std::bad_alloc &err) {
       const auto error = fmt::format("unable to allocate memory for `y_data` with `{}` elements ({} bytes): {}", n,
-                                     n * sizeof(T), err.what());
+                                     bytes, err.what());
       SPDLOG_CRITICAL(error);
       return std::unexpected(error);
     }
 
     try {
-      z_data = static_cast<T *>(std::aligned_alloc(64, sizeof(T) * n));
+      z_data = static_cast<T *>(std::aligned_alloc(64, bytes));
     } catch (const std::bad_alloc &err) {
       const auto error = fmt::format("unable to allocate memory for `z_data` with `{}` elements ({} bytes): {}", n,
-                                     n * sizeof(T), err.what());
+                                     bytes, err.what());
       SPDLOG_CRITICAL(error);
       return std::unexpected(error);
     }
@@ -111,6 +119,66 @@ template <numeric T> struct Vector3 {
     return {};
   }
 
+  /*!
+   * shifts every component by one plane towards -x so that index i holds what index i + 1 held before
+   *
+   * views advance into the spare planes which only costs a copy once every spare + 1 shifts when the data is moved
+   * back to the front of the containers
+   *
+   * @param val value of the freshly exposed last x-plane
+   */
+  void shift(const T val) noexcept {
+    SPDLOG_TRACE("enter Vector3::shift");
+
+    const ui_t plane = x.extent(1) * x.extent(2);
+    const ui_t n = x.extent(0) * plane;
+
+    if (offset == spare) {
+      std::memmove(x_data, x_data + (offset + 1) * plane, sizeof(T) * (n - plane));
+      std::memmove(y_data, y_data + (offset + 1) * plane, sizeof(T) * (n - plane));
+      std::memmove(z_data, z_data + (offset + 1) * plane, sizeof(T) * (n - plane));
+      offset = 0;
+    } else {
+      ++offset;
+    }
+
+    x = Kokkos::mdspan(x_data + offset * plane, x.extent(0), x.extent(1), x.extent(2));
+    y = Kokkos::mdspan(y_data + offset * plane, y.extent(0), y.extent(1), y.extent(2));
+    z = Kokkos::mdspan(z_data + offset * plane, z.extent(0), z.extent(1), z.extent(2));
+
+    for (ui_t idx = n - plane; idx < n; ++idx) {
+      x.data_handle()[idx] = val;
+      y.data_handle()[idx] = val;
+      z.data_handle()[idx] = val;
+    }
+
+    SPDLOG_TRACE("exit Vector3::shift");
+  }
+
+  /*!
+   * sets every component to a value and moves the views back to the front of the data containers
+   * @param val field value
+   * @note lets a run reuse the allocation of a previous run on the same grid
+   */
+  void fill(const T val) noexcept {
+    SPDLOG_TRACE("enter Vector3::fill");
+
+    const ui_t n = x.extent(0) * x.extent(1) * x.extent(2);
+
+    offset = 0;
+    x = Kokkos::mdspan(x_data, x.extent(0), x.extent(1), x.extent(2));
+    y = Kokkos::mdspan(y_data, y.extent(0), y.extent(1), y.extent(2));
+    z = Kokkos::mdspan(z_data, z.extent(0), z.extent(1), z.extent(2));
+
+    for (ui_t i = 0; i < n; ++i) {
+      x_data[i] = val;
+      y_data[i] = val;
+      z_data[i] = val;
+    }
+
+    SPDLOG_TRACE("exit Vector3::fill");
+  }
+
   /*!
    * resets Vector3 to default state
    * @note this frees existing data and resets dataview
@@ -130,6 +198,9 @@ template <numeric T> struct Vector3 {
     y_data = nullptr;
     z_data = nullptr;
 
+    spare = 0;
+    offset = 0;
+
     SPDLOG_TRACE("exit Vector3::reset");
   }
 };
@@ -0,0 +1,323 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "voxelize.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+std::expected<void, std::string> Mesh::init(const std::filesystem::path &path, const fp_t scale) noexcept {
+  SPDLOG_TRACE("enter Mesh::init");
+
+  reset();
+
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(path, ec);
+  std::ifstream file(path, std::ios::binary);
+  if (ec || !file.is_open()) {
+    const auto error = fmt::format("unable to open STL file `{}`", path.string());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  // binary files are an 80 byte header, a 32 bit triangle count, and 50 bytes per triangle, ASCII files may also
+  // start with `solid` so the size is the only reliable distinction
+  char header[84] = {};
+  uint32_t num = 0;
+  if (size >= 84 && file.read(header, 84)) {
+    std::memcpy(&num, header + 80, sizeof(num));
+  }
+
+  try {
+    if (size >= 84 && size == 84 + 50 * static_cast<uintmax_t>(num)) {
+      tris.reserve(num);
+      char record[50];
+      for (uint32_t t = 0; t < num; ++t) {
+        file.read(record, 50);
+        // the first 12 bytes hold the facet normal which is recomputed from the vertex order wherever it is needed
+        float v[9];
+        std::memcpy(v, record + 12, sizeof(v));
+        std::array<fp_t, 9> tri;
+        for (ui_t c = 0; c < 9; ++c) {
+          tri[c] = scale * static_cast<fp_t>(v[c]);
+        }
+        tris.push_back(tri);
+      }
+    } else {
+      file.clear();
+      file.seekg(0);
+      std::string token;
+      std::array<fp_t, 9> tri;
+      ui_t vertex = 0;
+      while (file >> token) {
+        if (token != "vertex") {
+          continue;
+        }
+        if (!(file >> tri[3 * vertex] >> tri[3 * vertex + 1] >> tri[3 * vertex + 2])) {
+          const auto error = fmt::format("STL file `{}` holds a vertex without three coordinates", path.string());
+          SPDLOG_CRITICAL(error);
+          return std::unexpected(error);
+        }
+        if (++vertex == 3) {
+          for (auto &c : tri) {
+            c *= scale;
+          }
+          tris.push_back(tri);
+          vertex = 0;
+        }
+      }
+    }
+  } catch (const std::bad_alloc &err) {
+    const auto error = fmt::format("unable to allocate memory for triangles of STL file `{}`: {}", path.string(),
+                                   err.what());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  if (!file.eof() && file.fail()) {
+    const auto error = fmt::format("STL file `{}` is truncated", path.string());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  if (tris.empty()) {
+    const auto error = fmt::format("STL file `{}` does not hold any triangles", path.string());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  SPDLOG_DEBUG("read {} triangles from STL file `{}`", tris.size(), path.string());
+  SPDLOG_TRACE("exit Mesh::init");
+  return {};
+}
+
+void Mesh::reset() noexcept {
+  SPDLOG_TRACE("enter Mesh::reset");
+
+  tris.clear();
+
+  SPDLOG_TRACE("exit Mesh::reset");
+}
+
+std::expected<void, std::string> Bvh::init(const Mesh &mesh) noexcept {
+  SPDLOG_TRACE("enter Bvh::init");
+
+  reset();
+
+  const ui_t num = mesh.tris.size();
+
+  try {
+    // xy-bounds and centroids of every triangle
+    std::vector<std::array<fp_t, 4>> boxes(num);
+    std::vector<std::array<fp_t, 2>> centers(num);
+    for (ui_t t = 0; t < num; ++t) {
+      const auto &v = mesh.tris[t];
+      boxes[t] = {std::min({v[0], v[3], v[6]}), std::min({v[1], v[4], v[7]}), std::max({v[0], v[3], v[6]}),
+                  std::max({v[1], v[4], v[7]})};
+      centers[t] = {(v[0] + v[3] + v[6]) / 3, (v[1] + v[4] + v[7]) / 3};
+    }
+
+    order.resize(num);
+    std::iota(order.begin(), order.end(), static_cast<ui_t>(0));
+
+    // a binary tree with at least one triangle per leaf holds fewer than 2 * num nodes
+    nodes.reserve(2 * num);
+    nodes.emplace_back();
+
+    // pending nodes as {node, first triangle, one past last triangle}
+    std::vector<std::array<ui_t, 3>> pending = {{0, 0, num}};
+    while (!pending.empty()) {
+      const auto [node, begin, end] = pending.back();
+      pending.pop_back();
+
+      std::array<fp_t, 4> box = boxes[order[begin]];
+      for (ui_t t = begin + 1; t < end; ++t) {
+        const auto &b = boxes[order[t]];
+        box = {std::min(box[0], b[0]), std::min(box[1], b[1]), std::max(box[2], b[2]), std::max(box[3], b[3])};
+      }
+      nodes[node].box = box;
+
+      if (end - begin <= LEAF_SIZE) {
+        nodes[node].first = begin;
+        nodes[node].count = end - begin;
+        continue;
+      }
+
+      const ui_t axis = box[2] - box[0] >= box[3] - box[1] ? 0 : 1;
+      const ui_t mid = begin + (end - begin) / 2;
+      std::nth_element(order.begin() + static_cast<si_t>(begin), order.begin() + static_cast<si_t>(mid),
+                       order.begin() + static_cast<si_t>(end),
+                       [&](const ui_t a, const ui_t b) { return centers[a][axis] < centers[b][axis]; });
+
+      const ui_t child = nodes.size();
+      nodes[node].first = child;
+      nodes[node].count = 0;
+      nodes.emplace_back();
+      nodes.emplace_back();
+      pending.push_back({child, begin, mid});
+      pending.push_back({child + 1, mid, end});
+    }
+  } catch (const std::bad_alloc &err) {
+    const auto error = fmt::format("unable to allocate memory for bounding volume hierarchy: {}", err.what());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  SPDLOG_DEBUG("bounding volume hierarchy holds {} nodes over {} triangles", nodes.size(), num);
+  SPDLOG_TRACE("exit Bvh::init");
+  return {};
+}
+
+void Bvh::reset() noexcept {
+  SPDLOG_TRACE("enter Bvh::reset");
+
+  nodes.clear();
+  order.clear();
+
+  SPDLOG_TRACE("exit Bvh::reset");
+}
+
+void Bvh::column_hits(const Mesh &mesh, const fp_t x, const fp_t y, std::vector<fp_t> &hits) const {
+  hits.clear();
+  if (nodes.empty()) {
+    return;
+  }
+
+  // median splits keep the depth logarithmic so a small fixed stack suffices
+  std::array<ui_t, 128> stack;
+  ui_t top = 0;
+  stack[top++] = 0;
+
+  while (top > 0) {
+    const auto &node = nodes[stack[--top]];
+    if (x < node.box[0] || x > node.box[2] || y < node.box[1] || y > node.box[3]) {
+      continue;
+    }
+
+    if (node.count == 0) {
+      stack[top++] = node.first;
+      stack[top++] = node.first + 1;
+      continue;
+    }
+
+    for (ui_t t = node.first; t < node.first + node.count; ++t) {
+      const auto &v = mesh.tris[order[t]];
+
+      // twice the signed areas of the sub-triangles opposite each vertex in the xy-plane
+      const fp_t w0 = (v[3] - x) * (v[7] - y) - (v[4] - y) * (v[6] - x);
+      const fp_t w1 = (v[6] - x) * (v[1] - y) - (v[7] - y) * (v[0] - x);
+      const fp_t w2 = (v[0] - x) * (v[4] - y) - (v[1] - y) * (v[3] - x);
+      const fp_t area = w0 + w1 + w2;
+
+      // triangles parallel to the ray never cross it
+      if (area == 0.0) {
+        continue;
+      }
+
+      const bool inside = area > 0.0 ? w0 >= 0.0 && w1 >= 0.0 && w2 >= 0.0 : w0 <= 0.0 && w1 <= 0.0 && w2 <= 0.0;
+      if (inside) {
+        hits.push_back((w0 * v[2] + w1 * v[5] + w2 * v[8]) / area);
+      }
+    }
+  }
+}
+
+void voxelize_mesh(const Mesh &mesh, const Bvh &bvh, const Scalar3<uint8_t> &ids, const uint8_t id,
+                   const Coord3<fp_t> &d) {
+  SPDLOG_TRACE("enter voxelize_mesh");
+
+  // rays are nudged off voxel centers by irrational fractions of a voxel so they do not run exactly through vertices or
+  // edges of meshes aligned with the grid, which would count a single crossing twice
+  constexpr fp_t jitter_x = static_cast<fp_t>(0.5 + 1.4142135623730951e-7);
+  constexpr fp_t jitter_y = static_cast<fp_t>(0.5 + 1.7320508075688772e-7);
+
+  const ui_t nx = ids.v.extent(0);
+  const ui_t ny = ids.v.extent(1);
+  const ui_t nz = ids.v.extent(2);
+
+#pragma omp parallel
+  {
+    std::vector<fp_t> hits;
+
+#pragma omp for collapse(2) schedule(dynamic, 16)
+    for (ui_t i = 0; i < nx; ++i) {
+      for (ui_t j = 0; j < ny; ++j) {
+        bvh.column_hits(mesh, (static_cast<fp_t>(i) + jitter_x) * d.x, (static_cast<fp_t>(j) + jitter_y) * d.y, hits);
+        if (hits.empty()) {
+          continue;
+        }
+        std::ranges::sort(hits);
+
+        // voxel centers above an odd number of crossings lie inside the closed mesh
+        ui_t h = 0;
+        for (ui_t k = 0; k < nz; ++k) {
+          const fp_t z = (static_cast<fp_t>(k) + static_cast<fp_t>(0.5)) * d.z;
+          while (h < hits.size() && hits[h] < z) {
+            ++h;
+          }
+          if (h % 2 == 1) {
+            ids.v[i, j, k] = id;
+          }
+        }
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit voxelize_mesh");
+}
+
+void voxelize_primitive(const ObjectConfig &obj, const Scalar3<uint8_t> &ids, const uint8_t id,
+                        const Coord3<fp_t> &d) {
+  SPDLOG_TRACE("enter voxelize_primitive");
+
+  const fp_t r_sq = obj.radius * obj.radius;
+  const auto inside = [&](const fp_t x, const fp_t y, const fp_t z) {
+    switch (obj.shape) {
+    case Shape::SPHERE:
+      return (x - obj.center.x) * (x - obj.center.x) + (y - obj.center.y) * (y - obj.center.y) +
+                 (z - obj.center.z) * (z - obj.center.z) <=
+             r_sq;
+    case Shape::CYLINDER:
+      return (x - obj.center.x) * (x - obj.center.x) + (y - obj.center.y) * (y - obj.center.y) <= r_sq &&
+             z >= obj.lo.z && z <= obj.hi.z;
+    case Shape::BOX:
+      return x >= obj.lo.x && x <= obj.hi.x && y >= obj.lo.y && y <= obj.hi.y && z >= obj.lo.z && z <= obj.hi.z;
+    case Shape::STL:
+      break;
+    }
+    return false;
+  };
+
+#pragma omp parallel for collapse(2) schedule(static)
+  for (ui_t i = 0; i < ids.v.extent(0); ++i) {
+    for (ui_t j = 0; j < ids.v.extent(1); ++j) {
+      for (ui_t k = 0; k < ids.v.extent(2); ++k) {
+        const fp_t x = (static_cast<fp_t>(i) + static_cast<fp_t>(0.5)) * d.x;
+        const fp_t y = (static_cast<fp_t>(j) + static_cast<fp_t>(0.5)) * d.y;
+        const fp_t z = (static_cast<fp_t>(k) + static_cast<fp_t>(0.5)) * d.z;
+        if (inside(x, y, z)) {
+          ids.v[i, j, k] = id;
+        }
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit voxelize_primitive");
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2025 Samuel Wyss
+ *
+ * This file is part of EPPIC.
+ *
+ * EPPIC is free software: you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * EPPIC is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even
+ * the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with EPPIC. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_VOXELIZE_H
+#define CORE_VOXELIZE_H
+
+#include <array>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "coordinate.h"
+#include "scalar.h"
+#include "type.h"
+
+/*!
+ * triangle surface mesh
+ */
+struct Mesh {
+  /// (m) triangle vertices as {x0, y0, z0, x1, y1, z1, x2, y2, z2}
+  std::vector<std::array<fp_t, 9>> tris;
+
+  /*!
+   * initializes Mesh from an ASCII or binary STL file
+   * @param path path to STL file
+   * @param scale (m) size of one STL length unit
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init(const std::filesystem::path &path, fp_t scale) noexcept;
+
+  /*!
+   * resets Mesh to default state
+   */
+  void reset() noexcept;
+};
+
+/*!
+ * node of a bounding volume hierarchy over the xy-extents of triangles
+ */
+struct BvhNode {
+  /// (m) bounds as {x_lo, y_lo, x_hi, y_hi}
+  std::array<fp_t, 4> box = {0.0, 0.0, 0.0, 0.0};
+
+  /// index of first child for inner nodes (the second follows it) or of first triangle in Bvh::order for leaves
+  ui_t first = 0;
+
+  /// number of triangles of leaves, 0 for inner nodes
+  ui_t count = 0;
+};
+
+/*!
+ * bounding volume hierarchy over the xy-extents of mesh triangles which answers which triangles a ray along z crosses
+ *
+ * nodes are split at the median centroid along their longer axis until at most LEAF_SIZE triangles remain
+ */
+struct Bvh {
+  /// maximum number of triangles per leaf
+  static constexpr ui_t LEAF_SIZE = 4;
+
+  /// nodes with the root first
+  std::vector<BvhNode> nodes;
+
+  /// triangle indices ordered so every leaf references a contiguous range
+  std::vector<ui_t> order;
+
+  /*!
+   * initializes Bvh
+   * @param mesh mesh to build hierarchy over
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init(const Mesh &mesh) noexcept;
+
+  /*!
+   * resets Bvh to default state
+   */
+  void reset() noexcept;
+
+  /*!
+   * collects heights at which a ray along z crosses the mesh
+   * @param mesh mesh hierarchy was built over
+   * @param x (m) x-coordinate of ray
+   * @param y (m) y-coordinate of ray
+   * @param hits (m) cleared and filled with unsorted crossing heights
+   */
+  void column_hits(const Mesh &mesh, fp_t x, fp_t y, std::vector<fp_t> &hits) const;
+};
+
+/*!
+ * assigns a material to every voxel whose center lies inside a closed mesh
+ *
+ * columns along z are filled in parallel by ray parity, i.e. voxels above an odd number of crossings are inside
+ *
+ * @param mesh closed mesh
+ * @param bvh hierarchy over mesh
+ * @param ids per-voxel material IDs
+ * @param id material ID to assign
+ * @param d (m) voxel size along each axis
+ */
+void voxelize_mesh(const Mesh &mesh, const Bvh &bvh, const Scalar3<uint8_t> &ids, uint8_t id, const Coord3<fp_t> &d);
+
+/*!
+ * assigns a material to every voxel whose center lies inside a BOX, SPHERE, or CYLINDER object
+ * @param obj object to voxelize
+ * @param ids per-voxel material IDs
+ * @param id material ID to assign
+ * @param d (m) voxel size along each axis
+ */
+void voxelize_primitive(const ObjectConfig &obj, const Scalar3<uint8_t> &ids, uint8_t id, const Coord3<fp_t> &d);
+
+#endif // CORE_VOXELIZE_H
@@ -17,6 +17,11 @@
 
 #include "world.h"
 
+#include <cstring>
+#include <numeric>
+#include <omp.h>
+#include <random>
+
 std::expected<void, std::string> World::init(const std::string &input_file_path, const std::string &id) noexcept {
   SPDLOG_TRACE("enter World::init");
 
@@ -26,15 +31,74 @@ std::expected<void, std::string> World::init(const std::string &input_file_path,
     return std::unexpected(error);
   }
 
+  if (const auto result = init_state(); !result.has_value()) {
+    SPDLOG_CRITICAL(result.error());
+    return std::unexpected(result.error());
+  }
+
+  const auto result = init_filesystem(cfg.out, id);
+  if (!result.has_value()) {
+    const auto error = fmt::format("failed to initialize output filesystem: {}", result.error());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+  io_dir = result.value();
+
+  h5 = HDF5Obj(H5Fcreate((io_dir / "data.h5").c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT), H5Fclose);
+  SPDLOG_DEBUG("created output HDF5 file at `{}`", (io_dir / "data.h5").string());
+
+  SPDLOG_TRACE("exit World::init");
+  return {};
+}
+
+std::expected<void, std::string> World::init(const toml::basic_value<toml::type_config> &config,
+                                             HDF5Obj &&group) noexcept {
+  SPDLOG_TRACE("enter World::init");
+
+  if (const auto result = cfg.init(config); !result.has_value()) {
+    const auto error = fmt::format("failed to initialize configuration: {}", result.error());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  if (const auto result = init_state(); !result.has_value()) {
+    SPDLOG_CRITICAL(result.error());
+    return std::unexpected(result.error());
+  }
+
+  h5 = std::move(group);
+
+  SPDLOG_TRACE("exit World::init");
+  return {};
+}
+
+std::expected<void, std::string> World::init_state() noexcept {
+  SPDLOG_TRACE("enter World::init_state");
+
+  // product of relative permittivity and permeability of the densest material which holds the shortest wavelengths
+  fp_t ep_mu_max = cfg.ep_r * cfg.mu_r;
+  for (const auto &mc : cfg.materials) {
+    ep_mu_max = std::max(ep_mu_max, mc.ep_r * cfg.mu_r);
+  }
+  for (const auto &ec : cfg.ensemble) {
+    ep_mu_max = std::max(ep_mu_max, ec.ep_r * ec.mu_r);
+  }
+
   // (m) maximum spatial step based on maximum frequency
   const fp_t ds_min_wavelength =
       VAC_SPEED_OF_LIGHT /
-      static_cast<fp_t>(sqrt(cfg.ep_r * cfg.mu_r) * static_cast<fp_t>(cfg.num_vox_min_wavelength) * cfg.max_frequency);
+      static_cast<fp_t>(sqrt(ep_mu_max) * static_cast<fp_t>(cfg.num_vox_min_wavelength) * cfg.max_frequency);
   SPDLOG_DEBUG("maximum spatial step based on maximum frequency (m): {:.3e}", ds_min_wavelength);
 
+  // axes resolved by the configured mode, RZ resolves r along x and z along z
+  const bool resolves_y = rank() >= 2 && cfg.mode != Mode::RZ;
+  const bool resolves_z = rank() == 3 || cfg.mode == Mode::RZ;
+
+  // (m) smallest bounding box length along the axes resolved by the configured mode
+  const fp_t len_min = std::min({cfg.len.x, resolves_y ? cfg.len.y : cfg.len.x, resolves_z ? cfg.len.z : cfg.len.x});
+
   // (m) maximum spatial step based on minimum feature size
-  const fp_t ds_min_feature_size =
-      std::min({cfg.len.x, cfg.len.y, cfg.len.z}) / static_cast<fp_t>(cfg.num_vox_min_feature);
+  const fp_t ds_min_feature_size = len_min / static_cast<fp_t>(cfg.num_vox_min_feature);
   SPDLOG_DEBUG("maximum spatial step based on feature size (m): {:.3e}", ds_min_feature_size);
 
   // (m) maximum required spatial step
@@ -42,13 +106,14 @@ std::expected<void, std::string> World::init(const std::string &input_file_path,
   SPDLOG_DEBUG("minimum of maximum spatial steps (m): {:.3e}", ds);
 
   // the computation here is a result of snapping the maximum step to the geometry
-  const Coord3 nv_h = {static_cast<ui_t>(ceil(static_cast<fp_t>(cfg.len.x) / ds)),
-                       static_cast<ui_t>(ceil(static_cast<fp_t>(cfg.len.y) / ds)),
-                       static_cast<ui_t>(ceil(static_cast<fp_t>(cfg.len.z) / ds))};
+  // invariant axes of reduced dimensionality modes are collapsed to a single voxel
+  nv_h = {static_cast<ui_t>(ceil(static_cast<fp_t>(cfg.len.x) / ds)),
+          resolves_y ? static_cast<ui_t>(ceil(static_cast<fp_t>(cfg.len.y) / ds)) : 1,
+          resolves_z ? static_cast<ui_t>(ceil(static_cast<fp_t>(cfg.len.z) / ds)) : 1};
   SPDLOG_DEBUG("magnetic field voxel dimensions: {} x {} x {}", nv_h.x, nv_h.y, nv_h.z);
 
   // the +1 is a result of the convention that all magnetic field points are wrapped by an electric field
-  const Coord3 nv_e = {nv_h.x + 1, nv_h.y + 1, nv_h.z + 1};
+  nv_e = {nv_h.x + 1, resolves_y ? nv_h.y + 1 : 1, resolves_z ? nv_h.z + 1 : 1};
   SPDLOG_DEBUG("electric field voxel dimensions: {} x {} x {}", nv_e.x, nv_e.y, nv_e.z);
 
   // the magnetic field numbers are used as a result of the electric field wrapping the magnetic field
@@ -60,45 +125,573 @@ std::expected<void, std::string> World::init(const std::string &input_file_path,
   d_inv = {static_cast<fp_t>(1.0) / d.x, static_cast<fp_t>(1.0) / d.y, static_cast<fp_t>(1.0) / d.z};
   SPDLOG_DEBUG("inverse voxel size (m^-1): {:.3e} x {:.3e} x {:.3e}", d_inv.x, d_inv.y, d_inv.z);
 
-  if (const auto result = h.init(nv_h, static_cast<fp_t>(0.0)); !result.has_value()) {
-    const auto error = fmt::format("failed to initialize magnetic field: {}", result.error());
+  ep = cfg.ep_r * VAC_PERMITTIVITY;
+  SPDLOG_DEBUG("permittivity (F/m): {:.3e}", ep);
+
+  mu = cfg.mu_r * VAC_PERMEABILITY;
+  SPDLOG_DEBUG("permeability (H/m): {:.3e}", mu);
+
+  if (const auto result = init_fields(); !result.has_value()) {
+    const auto error = fmt::format("failed to initialize fields: {}", result.error());
     SPDLOG_CRITICAL(error);
     return std::unexpected(error);
   }
 
-  if (const auto result = e.init(nv_e, static_cast<fp_t>(0.0)); !result.has_value()) {
-    const auto error = fmt::format("failed to initialize electric field: {}", result.error());
+  if (const auto result = init_geometry(); !result.has_value()) {
+    const auto error = fmt::format("failed to initialize geometry: {}", result.error());
     SPDLOG_CRITICAL(error);
     return std::unexpected(error);
   }
 
-  if (const auto result = init_filesystem(id); result.has_value()) {
-    const auto error = fmt::format("failed to initialize output filesystem: {}", result.error());
+  if (!cfg.dispersive.empty()) {
+    if (const auto result = dispersive.init(cfg.dispersive, nv_e, d); !result.has_value()) {
+      const auto error = fmt::format("failed to initialize dispersive materials: {}", result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+
+  if (const auto result = init_particles(); !result.has_value()) {
+    const auto error = fmt::format("failed to initialize particles: {}", result.error());
     SPDLOG_CRITICAL(error);
     return std::unexpected(error);
   }
 
-  h5 = HDF5Obj(H5Fcreate((cfg.out / "data.h5").c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT), H5Fclose);
-  SPDLOG_DEBUG("created output HDF5 file at `{}`", (cfg.out / "data.h5").string());
+  if (const auto result = init_collisions(); !result.has_value()) {
+    const auto error = fmt::format("failed to initialize collisions: {}", result.error());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
 
-  // todo dataspaces/datasets
+  // non-neutral particle loadings need an initial electrostatic field that satisfies Gauss's law
+  if (!species.empty()) {
+    if (const auto result = mg.init(nv_h, d, cfg.boundary); !result.has_value()) {
+      const auto error = fmt::format("failed to initialize multigrid: {}", result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
 
-  SPDLOG_TRACE("exit World::init");
+    if (const auto result = solve_gauss(); !result.has_value()) {
+      const auto error = fmt::format("failed to solve for initial electric field: {}", result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+
+#if EPPIC_USE_PSATD
+  if (cfg.engine == Engine::PSATD) {
+    if (const auto result = psatd.init(nv_h, d); !result.has_value()) {
+      const auto error = fmt::format("failed to initialize PSATD engine: {}", result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+  }
+#endif
+
+  SPDLOG_TRACE("exit World::init_state");
+  return {};
+}
+
+std::expected<void, std::string> World::init_fields() noexcept {
+  SPDLOG_TRACE("enter World::init_fields");
+
+  const Coord2<ui_t> nv_e_2d = {nv_e.x, nv_e.y};
+  const Coord2<ui_t> nv_h_2d = {nv_h.x, nv_h.y};
+
+  // field buffers kept from a previous run are of no use to the other modes or the ensemble
+  if (cfg.mode != Mode::D3 || !cfg.ensemble.empty()) {
+    e.reset();
+    h.reset();
+  }
+
+  switch (cfg.mode) {
+  case Mode::D3: {
+    if (!cfg.ensemble.empty()) {
+      if (const auto result = ensemble.init(cfg.ensemble, nv_h, d, cfg.max_frequency); !result.has_value()) {
+        const auto error = fmt::format("failed to initialize ensemble: {}", result.error());
+        SPDLOG_CRITICAL(error);
+        return std::unexpected(error);
+      }
+      SPDLOG_INFO("advancing {} ensemble members in {} SIMD lanes", ensemble.num_members, ENSEMBLE_WIDTH);
+      break;
+    }
+
+    // spare x-planes let the moving window shift fields without copying them every time
+    const ui_t spare = cfg.window_velocity > 0.0 ? cfg.window_spare : 0;
+
+    // buffers kept by reset(true) are only zeroed when the previous run had the same grid
+    if (e.x_data != nullptr && e.spare == spare && e.x.extent(0) == nv_e.x && e.x.extent(1) == nv_e.y &&
+        e.x.extent(2) == nv_e.z && h.x.extent(0) == nv_h.x && h.x.extent(1) == nv_h.y && h.x.extent(2) == nv_h.z) {
+      SPDLOG_DEBUG("reusing field buffers of the previous run");
+      h.fill(static_cast<fp_t>(0.0));
+      e.fill(static_cast<fp_t>(0.0));
+    } else {
+      h.reset();
+      e.reset();
+      if (const auto result = h.init(nv_h, static_cast<fp_t>(0.0), spare); !result.has_value()) {
+        const auto error = fmt::format("failed to initialize magnetic field: {}", result.error());
+        SPDLOG_CRITICAL(error);
+        return std::unexpected(error);
+      }
+      if (const auto result = e.init(nv_e, static_cast<fp_t>(0.0), spare); !result.has_value()) {
+        const auto error = fmt::format("failed to initialize electric field: {}", result.error());
+        SPDLOG_CRITICAL(error);
+        return std::unexpected(error);
+      }
+    }
+    if (cfg.wraps(true)) {
+      if (const auto result = h_im.init(nv_h, static_cast<fp_t>(0.0), spare); !result.has_value()) {
+        const auto error = fmt::format("failed to initialize imaginary magnetic field: {}", result.error());
+        SPDLOG_CRITICAL(error);
+        return std::unexpected(error);
+      }
+      if (const auto result = e_im.init(nv_e, static_cast<fp_t>(0.0), spare); !result.has_value()) {
+        const auto error = fmt::format("failed to initialize imaginary electric field: {}", result.error());
+        SPDLOG_CRITICAL(error);
+        return std::unexpected(error);
+      }
+    }
+    for (ui_t a = 0; a < bloch_shift.size(); ++a) {
+      bloch_shift[a] = std::polar(static_cast<fp_t>(1.0), cfg.bloch_phase[a]);
+    }
+    if (cfg.boundary[1] == Boundary::PMC) {
+      if (const auto result = hx_hi.init({nv_h.y, nv_h.z}, static_cast<fp_t>(0.0)); !result.has_value()) {
+        const auto error = fmt::format("failed to initialize x_hi magnetic wall: {}", result.error());
+        SPDLOG_CRITICAL(error);
+        return std::unexpected(error);
+      }
+    }
+    if (cfg.boundary[3] == Boundary::PMC) {
+      if (const auto result = hy_hi.init({nv_h.x, nv_h.z}, static_cast<fp_t>(0.0)); !result.has_value()) {
+        const auto error = fmt::format("failed to initialize y_hi magnetic wall: {}", result.error());
+        SPDLOG_CRITICAL(error);
+        return std::unexpected(error);
+      }
+    }
+    if (cfg.boundary[5] == Boundary::PMC) {
+      if (const auto result = hz_hi.init({nv_h.x, nv_h.y}, static_cast<fp_t>(0.0)); !result.has_value()) {
+        const auto error = fmt::format("failed to initialize z_hi magnetic wall: {}", result.error());
+        SPDLOG_CRITICAL(error);
+        return std::unexpected(error);
+      }
+    }
+    break;
+  }
+  case Mode::D2_TE:
+    if (const auto result = hz_2d.init(nv_h_2d, static_cast<fp_t>(0.0)); !result.has_value()) {
+      const auto error = fmt::format("failed to initialize magnetic field z-component: {}", result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+    if (const auto result = ex_2d.init(nv_e_2d, static_cast<fp_t>(0.0)); !result.has_value()) {
+      const auto error = fmt::format("failed to initialize electric field x-component: {}", result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+    if (const auto result = ey_2d.init(nv_e_2d, static_cast<fp_t>(0.0)); !result.has_value()) {
+      const auto error = fmt::format("failed to initialize electric field y-component: {}", result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+    break;
+  case Mode::D2_TM:
+    if (const auto result = hx_2d.init(nv_h_2d, static_cast<fp_t>(0.0)); !result.has_value()) {
+      const auto error = fmt::format("failed to initialize magnetic field x-component: {}", result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+    if (const auto result = hy_2d.init(nv_h_2d, static_cast<fp_t>(0.0)); !result.has_value()) {
+      const auto error = fmt::format("failed to initialize magnetic field y-component: {}", result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+    if (const auto result = ez_2d.init(nv_e_2d, static_cast<fp_t>(0.0)); !result.has_value()) {
+      const auto error = fmt::format("failed to initialize electric field z-component: {}", result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+    break;
+  case Mode::RZ:
+    if (const auto result = cyl.init(cfg.num_modes, {nv_h.x, nv_h.z}, {d.x, d.z}); !result.has_value()) {
+      const auto error = fmt::format("failed to initialize cylindrical fields: {}", result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+    break;
+  case Mode::D1:
+    if (const auto result = hy_1d.init(Coord1<ui_t>{nv_h.x}, static_cast<fp_t>(0.0)); !result.has_value()) {
+      const auto error = fmt::format("failed to initialize magnetic field y-component: {}", result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+    if (const auto result = ez_1d.init(Coord1<ui_t>{nv_e.x}, static_cast<fp_t>(0.0)); !result.has_value()) {
+      const auto error = fmt::format("failed to initialize electric field z-component: {}", result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+    break;
+  }
+
+  SPDLOG_TRACE("exit World::init_fields");
+  return {};
+}
+
+std::expected<void, std::string> World::init_geometry() noexcept {
+  SPDLOG_TRACE("enter World::init_geometry");
+
+  if (cfg.objects.empty() && cfg.material_file.empty()) {
+    SPDLOG_TRACE("exit World::init_geometry");
+    return {};
+  }
+
+  const auto start_time = std::chrono::steady_clock::now();
+
+  if (const auto result = material.init(nv_h, static_cast<uint8_t>(0)); !result.has_value()) {
+    const auto error = fmt::format("failed to initialize material IDs: {}", result.error());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  if (!cfg.material_file.empty()) {
+    // NOTE: serialized against the HDF5 output of concurrent sweep runs
+    std::expected<void, std::string> result;
+#pragma omp critical(hdf5)
+    result = load_material_ids();
+    if (!result.has_value()) {
+      const auto error = fmt::format("failed to load material IDs: {}", result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+    SPDLOG_INFO("loaded material IDs in (s): {:.3e}",
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count());
+  }
+
+  // objects are voxelized in input deck order so later objects overwrite earlier ones
+  for (const auto &oc : cfg.objects) {
+    const auto named = std::ranges::find(cfg.materials, oc.material, &MaterialConfig::name);
+    const auto id = static_cast<uint8_t>(1 + std::distance(cfg.materials.begin(), named));
+
+    if (oc.shape != Shape::STL) {
+      voxelize_primitive(oc, material, id, d);
+      continue;
+    }
+
+    Mesh mesh;
+    if (const auto result = mesh.init(oc.path, oc.scale); !result.has_value()) {
+      const auto error = fmt::format("failed to read mesh: {}", result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    Bvh bvh;
+    if (const auto result = bvh.init(mesh); !result.has_value()) {
+      const auto error = fmt::format("failed to build bounding volume hierarchy: {}", result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    voxelize_mesh(mesh, bvh, material, id, d);
+  }
+
+  material_ea.assign(cfg.materials.size() + 1, static_cast<fp_t>(0.0));
+  material_eb.assign(cfg.materials.size() + 1, static_cast<fp_t>(0.0));
+
+  SPDLOG_INFO("voxelized {} geometry objects in (s): {:.3e}", cfg.objects.size(),
+              std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count());
+
+  SPDLOG_TRACE("exit World::init_geometry");
+  return {};
+}
+
+std::expected<void, std::string> World::load_material_ids() noexcept {
+  SPDLOG_TRACE("enter World::load_material_ids");
+
+  const auto path = cfg.material_file.string();
+
+  // errors are reported through return values below so the automatic HDF5 error stack printing is silenced
+  H5E_auto2_t func = nullptr;
+  void *client_data = nullptr;
+  H5Eget_auto2(H5E_DEFAULT, &func, &client_data);
+  H5Eset_auto2(H5E_DEFAULT, nullptr, nullptr);
+  const auto file = HDF5Obj(H5Fopen(path.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT), H5Fclose);
+  const auto set = HDF5Obj(file.get() >= 0 ? H5Dopen(file.get(), cfg.material_dataset.c_str(), H5P_DEFAULT) : -1,
+                           H5Dclose);
+  H5Eset_auto2(H5E_DEFAULT, func, client_data);
+
+  if (set.get() < 0) {
+    const auto error = fmt::format("unable to open dataset `{}` of `{}`", cfg.material_dataset, path);
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  const auto space = HDF5Obj(H5Dget_space(set.get()), H5Sclose);
+  hsize_t dims[3] = {0, 0, 0};
+  if (H5Sget_simple_extent_ndims(space.get()) != 3 || H5Sget_simple_extent_dims(space.get(), dims, nullptr) != 3 ||
+      dims[0] != nv_h.x || dims[1] != nv_h.y || dims[2] != nv_h.z) {
+    const auto error = fmt::format("dataset `{}` of `{}` must be a {} x {} x {} volume matching the voxel grid",
+                                   cfg.material_dataset, path, nv_h.x, nv_h.y, nv_h.z);
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  // HDF5 silently clips wider or signed integers while converting to uint8_t so only ids that already fit are accepted
+  const auto type = HDF5Obj(H5Dget_type(set.get()), H5Tclose);
+  if (type.get() < 0 || H5Tget_class(type.get()) != H5T_INTEGER || H5Tget_sign(type.get()) != H5T_SGN_NONE ||
+      H5Tget_size(type.get()) > sizeof(uint8_t)) {
+    const auto error = fmt::format("dataset `{}` of `{}` must hold 8 bit unsigned integer material ids",
+                                   cfg.material_dataset, path);
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  // the row-major dataset already matches the layout of material so it is read in place with a single call
+  if (H5Dread(set.get(), H5T_NATIVE_UINT8, H5S_ALL, H5S_ALL, H5P_DEFAULT, material.data) < 0) {
+    const auto error = fmt::format("unable to read dataset `{}` of `{}`", cfg.material_dataset, path);
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  const ui_t num = nv_h.x * nv_h.y * nv_h.z;
+  uint8_t max_id = 0;
+#pragma omp parallel for reduction(max : max_id) schedule(static)
+  for (ui_t n = 0; n < num; ++n) {
+    max_id = std::max(max_id, material.data[n]);
+  }
+
+  if (max_id > cfg.materials.size()) {
+    const auto error = fmt::format("dataset `{}` of `{}` holds material ID {} but only {} materials are configured",
+                                   cfg.material_dataset, path, max_id, cfg.materials.size());
+    SPDLOG_CRITICAL(error);
+    return std::unexpected(error);
+  }
+
+  SPDLOG_TRACE("exit World::load_material_ids");
+  return {};
+}
+
+std::expected<void, std::string> World::init_particles() noexcept {
+  SPDLOG_TRACE("enter World::init_particles");
+
+  // fixed seed so repeated runs of the same input deck load identical particles
+  std::mt19937_64 gen(0);
+
+  const ui_t num_vox = nv_h.x * nv_h.y * nv_h.z;
+
+  for (const auto &sc : cfg.species) {
+    Species s{sc.name, sc.charge, sc.mass, {}, {}, false};
+
+    if (const auto result = s.p.init(num_vox * sc.ppc); !result.has_value()) {
+      const auto error = fmt::format("failed to initialize species `{}`: {}", sc.name, result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    if (const auto result = load_plasma(s, sc, 0, gen); !result.has_value()) {
+      return std::unexpected(result.error());
+    }
+    SPDLOG_INFO("loaded {} macroparticles of species `{}`", s.p.num, s.name);
+
+    species.push_back(std::move(s));
+  }
+
+  nt = {(nv_h.x + cfg.tile_size - 1) / cfg.tile_size, (nv_h.y + cfg.tile_size - 1) / cfg.tile_size,
+        (nv_h.z + cfg.tile_size - 1) / cfg.tile_size};
+  SPDLOG_DEBUG("particle tile dimensions: {} x {} x {}", nt.x, nt.y, nt.z);
+
+  // tiles on opposite ends of a periodic axis are neighbors and must not share a color
+  if (cfg.deposit == Deposit::COLORED) {
+    const std::array<ui_t, 3> period = shape_period();
+    const std::array<ui_t, 3> tiles = {nt.x, nt.y, nt.z};
+    for (ui_t a = 0; a < 3; ++a) {
+      if (period[a] > 0 && tiles[a] > 1 && tiles[a] % 2 == 1) {
+        const auto error = fmt::format("`deposit` is `colored` which requires an even number of tiles along periodic "
+                                       "axes but axis {} has {} ... please correct `tile_size` and rerun",
+                                       a, tiles[a]);
+        SPDLOG_CRITICAL(error);
+        return std::unexpected(error);
+      }
+    }
+  }
+
+  if (cfg.task_graph) {
+    task_deps.assign(3 * num_tiles() + 1, 0);
+  }
+
+  // tiles start out evenly split across threads until costs have been measured
+  const auto num_threads = static_cast<ui_t>(omp_get_max_threads());
+  thread_tiles.resize(num_threads + 1);
+  for (ui_t t = 0; t <= num_threads; ++t) {
+    thread_tiles[t] = num_tiles() * t / num_threads;
+  }
+  thread_time.assign(num_threads, 0.0);
+  tile_cost.assign(num_tiles(), 0.0);
+
+  if (!species.empty()) {
+    if (const auto result = current.init(nv_e, static_cast<fp_t>(0.0)); !result.has_value()) {
+      const auto error = fmt::format("failed to initialize current density: {}", result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    if (cfg.deposit == Deposit::REDUCE) {
+      // particles drift at most one voxel per step away from the tile they were sorted into and their stencils reach
+      // a further shape_order / 2 + 2 voxels, stragglers past the halo fall back to atomic updates
+      current_halo = std::max(cfg.sort_period, static_cast<ui_t>(1)) + cfg.shape_order / 2 + 2;
+      const ui_t dim = cfg.tile_size + 2 * current_halo + 1;
+
+      current_private.resize(static_cast<ui_t>(omp_get_max_threads()));
+      for (auto &tc : current_private) {
+        if (const auto result = tc.j.init({dim, dim, dim}, static_cast<fp_t>(0.0)); !result.has_value()) {
+          const auto error = fmt::format("failed to initialize tile-private current density: {}", result.error());
+          SPDLOG_CRITICAL(error);
+          return std::unexpected(error);
+        }
+      }
+      SPDLOG_DEBUG("allocated {} tile-private current density buffers of {}^3 voxels", current_private.size(), dim);
+    }
+  }
+
+  SPDLOG_TRACE("exit World::init_particles");
+  return {};
+}
+
+std::expected<void, std::string> World::load_plasma(Species &s, const SpeciesConfig &sc, const ui_t i_lo,
+                                                   std::mt19937_64 &gen) noexcept {
+  SPDLOG_TRACE("enter World::load_plasma");
+
+  std::uniform_real_distribution<fp_t> unit(0.0, 1.0);
+
+  // number of physical particles per macroparticle
+  const fp_t weight = sc.density * d.x * d.y * d.z / static_cast<fp_t>(sc.ppc);
+  SPDLOG_DEBUG("species `{}` macroparticle weight: {:.3e}", sc.name, weight);
+
+  // (m/s) thermal velocity, temperatures are assumed non-relativistic so proper velocity is sampled as velocity
+  const fp_t v_th = std::sqrt(sc.temperature * ELEC_CHARGE / sc.mass);
+  SPDLOG_DEBUG("species `{}` thermal velocity (m/s): {:.3e}", sc.name, v_th);
+  std::normal_distribution<fp_t> maxwell(0.0, v_th > 0.0 ? v_th : static_cast<fp_t>(1.0));
+  const fp_t u_scale = v_th > 0.0 ? static_cast<fp_t>(1.0) : static_cast<fp_t>(0.0);
+
+  for (ui_t i = i_lo; i < nv_h.x; ++i) {
+    for (ui_t j = 0; j < nv_h.y; ++j) {
+      for (ui_t k = 0; k < nv_h.z; ++k) {
+        for (ui_t n = 0; n < sc.ppc; ++n) {
+          const fp_t x = (static_cast<fp_t>(i) + unit(gen)) * d.x;
+          const fp_t y = (static_cast<fp_t>(j) + unit(gen)) * d.y;
+          const fp_t z = (static_cast<fp_t>(k) + unit(gen)) * d.z;
+          const fp_t ux = u_scale * maxwell(gen);
+          const fp_t uy = u_scale * maxwell(gen);
+          const fp_t uz = u_scale * maxwell(gen);
+
+          if (const auto result = s.p.push({x, y, z, ux, uy, uz, weight}); !result.has_value()) {
+            const auto error = fmt::format("failed to load species `{}`: {}", sc.name, result.error());
+            SPDLOG_CRITICAL(error);
+            return std::unexpected(error);
+          }
+        }
+      }
+    }
+  }
+  s.sorted = false;
+  s.ordered = false;
+
+  SPDLOG_TRACE("exit World::load_plasma");
+  return {};
+}
+
+std::expected<void, std::string> World::init_collisions() noexcept {
+  SPDLOG_TRACE("enter World::init_collisions");
+
+  if (cfg.mcc.species.empty()) {
+    SPDLOG_TRACE("exit World::init_collisions");
+    return {};
+  }
+
+  if (const auto result = xs.init(cfg.mcc.cross_sections); !result.has_value()) {
+    SPDLOG_CRITICAL(result.error());
+    return std::unexpected(result.error());
+  }
+
+  const auto &s = *std::ranges::find(species, cfg.mcc.species, &Species::name);
+  nu_max = xs.max_frequency(s.mass, cfg.mcc.gas_density);
+  SPDLOG_DEBUG("maximum collision frequency (1/s): {:.3e}", nu_max);
+
+  SPDLOG_TRACE("exit World::init_collisions");
   return {};
 }
 
 // TODO add reset for IO
-void World::reset() noexcept {
+void World::reset(const bool keep_fields) noexcept {
   SPDLOG_TRACE("enter World::reset");
 
   cfg.reset();
+  datasets = Datasets();
+  dataspaces = Dataspaces();
+  h5 = HDF5Obj();
+  io_dir.clear();
   time = 0.0;
   ep = 0.0;
   mu = 0.0;
   d = Coord3<fp_t>(0, 0, 0);
   d_inv = Coord3<fp_t>(0, 0, 0);
-  e.reset();
-  h.reset();
+  nv_e = {0, 0, 0};
+  nv_h = {0, 0, 0};
+  if (!keep_fields) {
+    e.reset();
+    h.reset();
+  }
+  for (auto &s : species) {
+    s.p.reset();
+  }
+  species.clear();
+  current.reset();
+  for (auto &tc : current_private) {
+    tc.j.reset();
+  }
+  current_private.clear();
+  current_halo = 0;
+  nt = {0, 0, 0};
+  sort_keys.clear();
+  sort_dest.clear();
+  sort_src.clear();
+  sort_counts.clear();
+  thread_tiles.clear();
+  thread_time.clear();
+  tile_cost.clear();
+  xs.reset();
+  nu_max = 0.0;
+  mg.reset();
+  material.reset();
+  material_ea.clear();
+  material_eb.clear();
+  dispersive.reset();
+  ensemble.reset();
+  particle_sets.clear();
+  window_shifts = 0;
+  active_tiles.clear();
+  tile_energy.clear();
+  tile_live.clear();
+  task_deps.clear();
+  step_count = 0;
+  num_pushed = 0;
+  push_time = 0.0;
+  ex_2d.reset();
+  ey_2d.reset();
+  ez_2d.reset();
+  hx_2d.reset();
+  hy_2d.reset();
+  hz_2d.reset();
+  ez_1d.reset();
+  hy_1d.reset();
+  e_im.reset();
+  h_im.reset();
+  bloch_shift = {1.0, 1.0, 1.0};
+  hx_hi.reset();
+  hy_hi.reset();
+  hz_hi.reset();
+  cyl.reset();
+#if EPPIC_USE_PSATD
+  psatd.reset();
+#endif
 
   SPDLOG_TRACE("exit World::reset");
 }
@@ -152,16 +745,40 @@ std::expected<void, std::string> World::advance_by(const fp_t adv_t) {
   const fp_t dt = adv_t / static_cast<fp_t>(steps);
   SPDLOG_DEBUG("timestep (s): {:.3e}", dt);
 
-  // +2 comes from first and last timestep
-  const ui_t logged_steps = steps / cfg.ds_ratio + 2;
+  // number of steps between logging events
+  const ui_t ds_ratio = std::max<ui_t>(1, static_cast<ui_t>(cfg.log_period / dt));
+
+  // every ds_ratio-th step starting at the first plus the last step if it does not fall on the logging period
+  const ui_t logged_steps = (steps + ds_ratio - 2) / ds_ratio + 1;
 
-  const auto metadata_group = HDF5Obj(H5Gcreate(h5.get(), "metadata", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), H5Gclose);
-  log_metadata(metadata_group, dt, logged_steps);
+  // (J) largest and previously reduced field energy and number of consecutive reductions meeting the stop criterion
+  fp_t energy_peak = 0.0;
+  fp_t energy_prev = 0.0;
+  ui_t converged = 0;
 
-  setup_dataspaces(logged_steps);
+  // number of steps actually taken
+  ui_t taken = steps;
 
-  const auto data_group = HDF5Obj(H5Gcreate(h5.get(), "data", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), H5Gclose);
-  setup_datasets(data_group);
+  // NOTE: HDF5 is not thread safe so every call into it is serialized against concurrent runs of a sweep
+  // NOTE: a critical region may not be left early so its outcome is only checked once it is closed
+  std::expected<void, std::string> setup_result;
+#pragma omp critical(hdf5)
+  {
+    const auto metadata_group =
+        HDF5Obj(H5Gcreate(h5.get(), "metadata", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), H5Gclose);
+    log_metadata(metadata_group, dt, logged_steps);
+
+    setup_dataspaces(logged_steps);
+
+    const auto data_group = HDF5Obj(H5Gcreate(h5.get(), "data", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), H5Gclose);
+    setup_result = setup_datasets(data_group);
+    setup_particle_datasets(data_group);
+  }
+
+  if (!setup_result.has_value()) {
+    SPDLOG_CRITICAL(setup_result.error());
+    return std::unexpected(setup_result.error());
+  }
 
   // loop start time
   // NOTE only used if SPDLOG_ACTIVE_LEVEL=SPDLOG_LEVEL_INFO
@@ -173,26 +790,108 @@ std::expected<void, std::string> World::advance_by(const fp_t adv_t) {
     for (ui_t i = 0; i < steps; ++i) {
       SPDLOG_DEBUG("step: {}/{} elapsed time (s): {:.5e}/{:.5e}", i + 1, steps, time, init_time + adv_t);
 
+      // bound the number of particles per voxel
+      if (cfg.resample_period > 0 && i % cfg.resample_period == 0) {
+        if (const auto result = resample_particles(); !result.has_value()) {
+          SPDLOG_CRITICAL(result.error());
+          return std::unexpected(result.error());
+        }
+      }
+
+      // even out measured particle work across threads
+      if (cfg.balance_period > 0 && i > 0 && i % cfg.balance_period == 0) {
+        rebalance();
+      }
+
+      // skip field updates of tiles the wavefront has not reached yet or that have rung down
+      if (cfg.activity_period > 0 && i % cfg.activity_period == 0) {
+        update_activity();
+      }
+
+      // reorder particles by tile and voxel to keep gather and deposition cache friendly
+      if (cfg.sort_period > 0 && i % cfg.sort_period == 0) {
+        sort_particles();
+      }
+
       // advance by one step
       step(dt);
 
-      if (0 == i % cfg.ds_ratio || i == steps - 1) [[unlikely]] {
-        SPDLOG_DEBUG("begin data logging");
+      // collisions only change momenta between pushes so they do not contribute to the current
+      if (const auto result = collide(dt); !result.has_value()) {
+        SPDLOG_CRITICAL(result.error());
+        return std::unexpected(result.error());
+      }
+      coulomb_collide(dt);
+
+      // keep the window at (s) time * velocity behind the initial leading edge in whole voxels
+      while (cfg.window_velocity > 0.0 &&
+             time * cfg.window_velocity >= static_cast<fp_t>(window_shifts + 1) * d.x) [[unlikely]] {
+        if (const auto result = shift_window(); !result.has_value()) {
+          SPDLOG_CRITICAL(result.error());
+          return std::unexpected(result.error());
+        }
+      }
 
-        // hyperslab index to write to
-        ui_t hyperslab = i / cfg.ds_ratio;
+      // restore Gauss's law against accumulated deposition error
+      if (cfg.clean_period > 0 && !species.empty() && (i + 1) % cfg.clean_period == 0) {
+        if (const auto result = solve_gauss(); !result.has_value()) {
+          SPDLOG_CRITICAL(result.error());
+          return std::unexpected(result.error());
+        }
+      }
 
-        // case for the last timestep
-        if (i == steps - 1) [[unlikely]] {
-          hyperslab++;
+      // stop once the fields have rung down or settled rather than stepping on to the end time
+      bool last = i == steps - 1;
+      if (cfg.converge_period > 0 && (i + 1) % cfg.converge_period == 0 && !last) [[unlikely]] {
+        const fp_t energy = field_energy();
+        energy_peak = std::max(energy_peak, energy);
+        SPDLOG_DEBUG("field energy (J): {:.3e} peak (J): {:.3e}", energy, energy_peak);
+
+        const bool met = cfg.converge_criterion == Criterion::DECAY
+                             ? energy <= cfg.converge_threshold * energy_peak
+                             : std::abs(energy - energy_prev) <= cfg.converge_threshold * energy_prev;
+        energy_prev = energy;
+
+        // fields that were never excited have not converged to anything
+        converged = met && energy_peak > 0.0 ? converged + 1 : 0;
+        if (converged == cfg.converge_checks) {
+          SPDLOG_INFO("fields converged at step {}/{} time (s) {:.3e} ... stopping early", i + 1, steps, time);
+          last = true;
         }
+      }
+
+      if (0 == i % ds_ratio || last) [[unlikely]] {
+        SPDLOG_DEBUG("begin data logging");
+
+        // hyperslab index to write to, the last step rounds up to the slot after the latest periodic one
+        const ui_t hyperslab = (i + ds_ratio - 1) / ds_ratio;
 
         SPDLOG_DEBUG("hyperslab index: {}/{}", hyperslab, logged_steps - 1);
 
-        log(hyperslab, i);
+        std::expected<void, std::string> log_result;
+#pragma omp critical(hdf5)
+        {
+          log_result = log(hyperslab, i);
+          log_particles(step_count);
+
+          // datasets of runs stopping early only keep the logged steps
+          if (last && i < steps - 1) {
+            truncate_logs(hyperslab + 1);
+          }
+        }
+
+        if (!log_result.has_value()) {
+          SPDLOG_CRITICAL(log_result.error());
+          return std::unexpected(log_result.error());
+        }
 
         SPDLOG_DEBUG("end data logging");
       }
+
+      if (last) {
+        taken = i + 1;
+        break;
+      }
     }
   } catch (const std::runtime_error &err) {
     SPDLOG_CRITICAL("main time loop returned with error: {}", err.what());
@@ -203,12 +902,15 @@ std::expected<void, std::string> World::advance_by(const fp_t adv_t) {
   // NOTE only used if SPDLOG_ACTIVE_LEVEL=SPDLOG_LEVEL_INFO
   [[maybe_unused]] const auto end_time = std::chrono::high_resolution_clock::now();
   // NOTE only used if SPDLOG_ACTIVE_LEVEL=SPDLOG_LEVEL_INFO
-  [[maybe_unused]] const auto num_cells = 3 * (e.x.size() + h.x.size()) * steps;
+  [[maybe_unused]] const auto num_cells = num_field_points() * taken;
   // NOTE only used if SPDLOG_ACTIVE_LEVEL=SPDLOG_LEVEL_INFO
   [[maybe_unused]] const auto loop_time = end_time - start_time;
   SPDLOG_INFO("loop runtime: {:%H:%M:%S}", loop_time);
   SPDLOG_INFO("voxel compute rate (vox/s): {:.3e}",
               static_cast<double>(num_cells) / std::chrono::duration<double>(loop_time).count());
+  if (push_time > 0.0) {
+    SPDLOG_INFO("particle push rate (particles/s): {:.3e}", static_cast<double>(num_pushed) / push_time);
+  }
 
   SPDLOG_TRACE("exit World::advance_by");
 
@@ -219,7 +921,7 @@ ui_t World::calc_num_steps(const fp_t adv_t) const {
   SPDLOG_TRACE("enter World::calc_num_steps");
 
   // find maximum number of timesteps required for any solver
-  const ui_t max_num_steps = calc_cfl_steps(adv_t);
+  const ui_t max_num_steps = cfg.engine == Engine::PSATD ? calc_spectral_steps(adv_t) : calc_cfl_steps(adv_t);
   SPDLOG_DEBUG("maximum number of steps required by any solver: {}", max_num_steps);
 
   SPDLOG_TRACE("exit World::calc_num_steps");
@@ -229,8 +931,27 @@ ui_t World::calc_num_steps(const fp_t adv_t) const {
 ui_t World::calc_cfl_steps(const fp_t time_span) const {
   SPDLOG_TRACE("enter World::calc_cfl_steps");
 
-  const fp_t maximum_dt = static_cast<fp_t>(1.0 / (VAC_SPEED_OF_LIGHT / sqrt(cfg.ep_r * cfg.mu_r) *
-                                                   sqrt(pow(d_inv.x, 2) + pow(d_inv.y, 2) + pow(d_inv.z, 2))));
+  if (cfg.mode == Mode::RZ) {
+    const fp_t maximum_dt = cyl.max_dt(static_cast<fp_t>(VAC_SPEED_OF_LIGHT / sqrt(cfg.ep_r * cfg.mu_r)));
+    SPDLOG_DEBUG("maximum possible timestep to satisfy cylindrical CFL condition (s): {:.3e}", maximum_dt);
+
+    const auto num_steps = static_cast<ui_t>(ceil(time_span / maximum_dt));
+    SPDLOG_DEBUG("steps required to satisfy CFL condition: {}", num_steps);
+
+    SPDLOG_TRACE("exit World::calc_cfl_steps");
+    return num_steps;
+  }
+
+  // only the axes resolved by the configured mode constrain the time step
+  const fp_t d_inv_sq = pow(d_inv.x, 2) + (rank() >= 2 ? pow(d_inv.y, 2) : 0.0) + (rank() == 3 ? pow(d_inv.z, 2) : 0.0);
+
+  // ensemble members share one time step which is set by the fastest member
+  fp_t ep_mu_min = cfg.ep_r * cfg.mu_r;
+  for (const auto &ec : cfg.ensemble) {
+    ep_mu_min = std::min(ep_mu_min, ec.ep_r * ec.mu_r);
+  }
+
+  const fp_t maximum_dt = static_cast<fp_t>(1.0 / (VAC_SPEED_OF_LIGHT / sqrt(ep_mu_min) * sqrt(d_inv_sq)));
   SPDLOG_DEBUG("maximum possible timestep to satisfy CFL condition (s): {:.3e}", maximum_dt);
 
   const auto num_steps = static_cast<ui_t>(ceil(time_span / maximum_dt));
@@ -240,9 +961,55 @@ ui_t World::calc_cfl_steps(const fp_t time_span) const {
   return num_steps;
 }
 
+ui_t World::calc_spectral_steps(const fp_t time_span) const {
+  SPDLOG_TRACE("enter World::calc_spectral_steps");
+
+  const fp_t maximum_dt =
+      static_cast<fp_t>(1.0) / (static_cast<fp_t>(cfg.num_vox_min_wavelength) * cfg.max_frequency);
+  SPDLOG_DEBUG("maximum timestep to resolve maximum frequency (s): {:.3e}", maximum_dt);
+
+  const auto num_steps = static_cast<ui_t>(ceil(time_span / maximum_dt));
+  SPDLOG_DEBUG("steps required to resolve maximum frequency: {}", num_steps);
+
+  SPDLOG_TRACE("exit World::calc_spectral_steps");
+  return num_steps;
+}
+
 void World::step(const fp_t dt) {
   SPDLOG_TRACE("enter World::step");
 
+#if EPPIC_USE_PSATD
+  if (cfg.engine == Engine::PSATD) {
+    // analytic advance of both fields over the full step
+    psatd.advance(e, h, dt, ep, mu);
+
+    time += dt;
+    SPDLOG_TRACE("advance time step to (s): {:.5e}", time);
+
+    ++step_count;
+
+    SPDLOG_TRACE("exit World::step");
+    return;
+  }
+#endif
+
+  if (ensemble.num_members > 0) {
+    time += ONE_OVER_TWO * dt;
+    SPDLOG_TRACE("advance half time step to (s): {:.5e}", time);
+
+    // sources are sampled at the half step the electric update is centred on
+    ensemble.update_h(dt);
+    ensemble.update_e(dt, time);
+
+    time += ONE_OVER_TWO * dt;
+    SPDLOG_TRACE("advance half time step to (s): {:.5e}", time);
+
+    ++step_count;
+
+    SPDLOG_TRACE("exit World::step");
+    return;
+  }
+
   // TODO it would be nice to not need to recalculate these every time step is
   // TODO called, the performance penalty of this has yet to be assed however
 
@@ -254,6 +1021,17 @@ void World::step(const fp_t dt) {
   const auto eb = ep / dt - cfg.sigma / static_cast<fp_t>(2.0);
   SPDLOG_TRACE("eb loop constant: {:.3e}", eb);
 
+  // loop constants of every material where ID 0 is the bounding box material
+  if (material.data != nullptr) {
+    material_ea[0] = ea;
+    material_eb[0] = eb;
+    for (ui_t m = 0; m < cfg.materials.size(); ++m) {
+      const fp_t ep_m = cfg.materials[m].ep_r * VAC_PERMITTIVITY;
+      material_ea[m + 1] = static_cast<fp_t>(1.0) / (ep_m / dt + cfg.materials[m].sigma / static_cast<fp_t>(2.0));
+      material_eb[m + 1] = ep_m / dt - cfg.materials[m].sigma / static_cast<fp_t>(2.0);
+    }
+  }
+
   // magnetic field a loop constant for x-component
   const auto hxa = dt * d_inv.x / mu;
   SPDLOG_TRACE("hxa loop constant: {:.3e}", hxa);
@@ -270,132 +1048,1955 @@ void World::step(const fp_t dt) {
   time += ONE_OVER_TWO * dt;
   SPDLOG_TRACE("advance half time step to (s): {:.5e}", time);
 
-  // update magnetic fields
-  update_h(hxa, hya, hza);
+  if (cfg.task_graph) {
+    // without particles nothing has to see the whole magnetic field before the electric update starts
+    const bool chained = species.empty();
 
-  // half timestep update before updating electric fields
-  time += ONE_OVER_TWO * dt;
-  SPDLOG_TRACE("advance half time step to (s): {:.5e}", time);
+    // polarization currents are advanced with the electric field at the start of the step
+    if (chained) {
+      dispersive.update_current(e, dt);
+    }
+    update_graph(ea, eb, hxa, hya, hza, true, chained);
+
+    if (!chained) {
+      push_particles(dt);
+      dispersive.update_current(e, dt);
+      update_graph(ea, eb, hxa, hya, hza, false, true);
+    }
+    dispersive.apply(e, ea, material, material_ea);
+
+    time += ONE_OVER_TWO * dt;
+    SPDLOG_TRACE("advance half time step to (s): {:.5e}", time);
+
+    ++step_count;
+
+    SPDLOG_TRACE("exit World::step");
+    return;
+  }
+
+  // update magnetic fields
+  update_h(hxa, hya, hza);
+  if (cfg.wraps(true)) {
+    // internal kernels advance the imaginary parts of Bloch fields by swapping them in place of the real parts
+    swap_imaginary();
+    update_h(hxa, hya, hza);
+    swap_imaginary();
+  }
+
+  // advance particles with the electric field E^n at the start of the step and the magnetic field H^{n+1/2}
+  push_particles(dt);
+
+  // half timestep update before updating electric fields
+  time += ONE_OVER_TWO * dt;
+  SPDLOG_TRACE("advance half time step to (s): {:.5e}", time);
+
+  // polarization currents are advanced with the electric field at the start of the step
+  dispersive.update_current(e, dt);
+
+  // update electric fields
+  // NOTE: update_e_boundary advances both parts of Bloch fields on the outer shell so only internal kernels are swapped
+  update_e(ea, eb);
+  dispersive.apply(e, ea, material, material_ea);
+  if (cfg.wraps(true)) {
+    swap_imaginary();
+    update_ex(ea, eb);
+    update_ey(ea, eb);
+    update_ez(ea, eb);
+    swap_imaginary();
+  }
+
+  ++step_count;
+
+  SPDLOG_TRACE("exit World::step");
+}
+
+void World::update_e(const fp_t ea, const fp_t eb) const {
+  SPDLOG_TRACE("enter World::update_e");
+
+  switch (cfg.mode) {
+  case Mode::D3:
+    update_ex(ea, eb);
+    update_ey(ea, eb);
+    update_ez(ea, eb);
+    update_e_boundary(ea, eb);
+    break;
+  case Mode::D2_TE:
+    update_e_te(ea, eb);
+    break;
+  case Mode::D2_TM:
+    update_e_tm(ea, eb);
+    break;
+  case Mode::D1:
+    update_e_1d(ea, eb);
+    break;
+  case Mode::RZ:
+    cyl.update_e(ea, eb);
+    break;
+  }
+
+  SPDLOG_TRACE("exit World::update_e");
+}
+
+void World::update_h(const fp_t hxa, const fp_t hya, const fp_t hza) const {
+  SPDLOG_TRACE("enter World::update_h");
+
+  switch (cfg.mode) {
+  case Mode::D3:
+    update_hx(hya, hza);
+    update_hy(hxa, hza);
+    update_hz(hxa, hya);
+    update_h_boundary(hxa, hya, hza);
+    break;
+  case Mode::D2_TE:
+    update_h_te(hxa, hya);
+    break;
+  case Mode::D2_TM:
+    update_h_tm(hxa, hya);
+    break;
+  case Mode::D1:
+    update_h_1d(hxa);
+    break;
+  case Mode::RZ:
+    // hxa * dx recovers dt / mu
+    cyl.update_h(hxa * d.x);
+    break;
+  }
+
+  SPDLOG_TRACE("exit World::update_h");
+}
+
+void World::update_graph(const fp_t ea, const fp_t eb, const fp_t hxa, const fp_t hya, const fp_t hza,
+                         const bool do_h, const bool do_e) const {
+  SPDLOG_TRACE("enter World::update_graph");
+
+  const ui_t num = num_tiles();
+  const ui_t count = cfg.activity_period == 0 ? num : static_cast<ui_t>(active_tiles.size());
+  const std::array<ui_t, 3> h_hi = {h.x.extent(0), h.x.extent(1), h.x.extent(2)};
+  const std::array<ui_t, 3> e_hi = {e.x.extent(0) - 1, e.x.extent(1) - 1, e.x.extent(2) - 1};
+
+  // dependence objects of every magnetic component task followed by the magnetic boundary task
+  // NOTE: gcc does not count uses within depend clauses and would otherwise warn about hz_dep
+  const uint8_t *hx_dep = task_deps.data();
+  const uint8_t *hy_dep = hx_dep + num;
+  [[maybe_unused]] const uint8_t *hz_dep = hy_dep + num;
+
+#pragma omp parallel
+#pragma omp single
+  {
+    // magnetic components only read electric fields so every tile of every component is independent
+    if (do_h) {
+      for (ui_t n = 0; n < count; ++n) {
+        const ui_t t = cfg.activity_period == 0 ? n : active_tiles[n];
+        const auto [lo, hi] = tile_box(t, {0, 0, 0}, h_hi);
+
+#pragma omp task firstprivate(lo, hi) depend(out : hx_dep[t])
+        update_hx(hya, hza, lo, hi);
+#pragma omp task firstprivate(lo, hi) depend(out : hy_dep[t])
+        update_hy(hxa, hza, lo, hi);
+#pragma omp task firstprivate(lo, hi) depend(out : hz_dep[t])
+        update_hz(hxa, hya, lo, hi);
+      }
+
+#pragma omp task depend(out : hz_dep[num])
+      update_h_boundary(hxa, hya, hza);
+    }
+
+    if (do_e) {
+      for (ui_t n = 0; n < count; ++n) {
+        const ui_t t = cfg.activity_period == 0 ? n : active_tiles[n];
+        const auto [lo, hi] = tile_box(t, {1, 1, 1}, e_hi);
+        if (lo[0] >= hi[0] || lo[1] >= hi[1] || lo[2] >= hi[2]) {
+          continue;
+        }
+
+        // lower neighbors along each axis where tiles on a low face stand in for their missing neighbor
+        const ui_t tx = t >= nt.y * nt.z ? t - nt.y * nt.z : t;
+        const ui_t ty = t / nt.z % nt.y > 0 ? t - nt.z : t;
+        const ui_t tz = t % nt.z > 0 ? t - 1 : t;
+
+        // each electric component reads two magnetic components across its tile and lower neighbors, the same
+        // magnetic tasks are the only ones reading it across their upper faces so no anti-dependence is missed
+#pragma omp task firstprivate(lo, hi) depend(in : hz_dep[t], hz_dep[ty], hy_dep[t], hy_dep[tz])
+        update_ex(ea, eb, lo, hi);
+#pragma omp task firstprivate(lo, hi) depend(in : hx_dep[t], hx_dep[tz], hz_dep[t], hz_dep[tx])
+        update_ey(ea, eb, lo, hi);
+#pragma omp task firstprivate(lo, hi) depend(in : hy_dep[t], hy_dep[tx], hx_dep[t], hx_dep[ty])
+        update_ez(ea, eb, lo, hi);
+      }
+
+      // the outer shell reads magnetic fields along every face and is read by the magnetic boundary
+#pragma omp task depend(iterator(ui_t it = 0 : 3 * num + 1), in : hx_dep[it])
+      update_e_boundary(ea, eb);
+    }
+  }
+
+  SPDLOG_TRACE("exit World::update_graph");
+}
+
+void World::update_ex(const fp_t ea, const fp_t eb) const {
+  SPDLOG_TRACE("enter World::update_ex");
+
+  // the outer shell is left to update_e_boundary which keeps it zero on PEC faces
+  const std::array<ui_t, 3> last = {e.x.extent(0) - 1, e.x.extent(1) - 1, e.x.extent(2) - 1};
+  for_active({1, 1, 1}, last, [&](const auto &lo, const auto &hi) { update_ex(ea, eb, lo, hi); });
+
+  SPDLOG_TRACE("exit World::update_ex");
+}
+
+void World::update_ex(const fp_t ea, const fp_t eb, const std::array<ui_t, 3> &lo,
+                      const std::array<ui_t, 3> &hi) const {
+  SPDLOG_TRACE("enter World::update_ex box");
+
+  // current density is only allocated when particles are present, the branch is hoisted out of the loop
+  const bool sourced = current.x_data != nullptr;
+
+  // voxelized geometry selects loop constants per node, the branch is hoisted out of the loop as well
+  const bool voxelized = material.data != nullptr;
+
+  for (ui_t i = lo[0]; i < hi[0]; ++i) {
+    for (ui_t j = lo[1]; j < hi[1]; ++j) {
+      for (ui_t k = lo[2]; k < hi[2]; ++k) {
+        const fp_t a = voxelized ? material_ea[material.v[i, j, k]] : ea;
+        const fp_t b = voxelized ? material_eb[material.v[i, j, k]] : eb;
+        e.x[i, j, k] = a * (b * e.x[i, j, k] + d_inv.y * (h.z[i, j, k] - h.z[i, j - 1, k]) -
+                            d_inv.z * (h.y[i, j, k] - h.y[i, j, k - 1]) - (sourced ? current.x[i, j, k] : 0));
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit World::update_ex box");
+}
+
+void World::update_ey(const fp_t ea, const fp_t eb) const {
+  SPDLOG_TRACE("enter World::update_ey");
+
+  // the outer shell is left to update_e_boundary which keeps it zero on PEC faces
+  const std::array<ui_t, 3> last = {e.y.extent(0) - 1, e.y.extent(1) - 1, e.y.extent(2) - 1};
+  for_active({1, 1, 1}, last, [&](const auto &lo, const auto &hi) { update_ey(ea, eb, lo, hi); });
+
+  SPDLOG_TRACE("exit World::update_ey");
+}
+
+void World::update_ey(const fp_t ea, const fp_t eb, const std::array<ui_t, 3> &lo,
+                      const std::array<ui_t, 3> &hi) const {
+  SPDLOG_TRACE("enter World::update_ey box");
+
+  // current density is only allocated when particles are present, the branch is hoisted out of the loop
+  const bool sourced = current.x_data != nullptr;
+
+  // voxelized geometry selects loop constants per node, the branch is hoisted out of the loop as well
+  const bool voxelized = material.data != nullptr;
+
+  for (ui_t i = lo[0]; i < hi[0]; ++i) {
+    for (ui_t j = lo[1]; j < hi[1]; ++j) {
+      for (ui_t k = lo[2]; k < hi[2]; ++k) {
+        const fp_t a = voxelized ? material_ea[material.v[i, j, k]] : ea;
+        const fp_t b = voxelized ? material_eb[material.v[i, j, k]] : eb;
+        e.y[i, j, k] = a * (b * e.y[i, j, k] + d_inv.z * (h.x[i, j, k] - h.x[i, j, k - 1]) -
+                            d_inv.x * (h.z[i, j, k] - h.z[i - 1, j, k]) - (sourced ? current.y[i, j, k] : 0));
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit World::update_ey box");
+}
+
+void World::update_ez(const fp_t ea, const fp_t eb) const {
+  SPDLOG_TRACE("enter World::update_ez");
+
+  // the outer shell is left to update_e_boundary which keeps it zero on PEC faces
+  const std::array<ui_t, 3> last = {e.z.extent(0) - 1, e.z.extent(1) - 1, e.z.extent(2) - 1};
+  for_active({1, 1, 1}, last, [&](const auto &lo, const auto &hi) { update_ez(ea, eb, lo, hi); });
+
+  SPDLOG_TRACE("exit World::update_ez");
+}
+
+void World::update_ez(const fp_t ea, const fp_t eb, const std::array<ui_t, 3> &lo,
+                      const std::array<ui_t, 3> &hi) const {
+  SPDLOG_TRACE("enter World::update_ez box");
+
+  // current density is only allocated when particles are present, the branch is hoisted out of the loop
+  const bool sourced = current.x_data != nullptr;
+
+  // voxelized geometry selects loop constants per node, the branch is hoisted out of the loop as well
+  const bool voxelized = material.data != nullptr;
+
+  for (ui_t i = lo[0]; i < hi[0]; ++i) {
+    for (ui_t j = lo[1]; j < hi[1]; ++j) {
+      for (ui_t k = lo[2]; k < hi[2]; ++k) {
+        const fp_t a = voxelized ? material_ea[material.v[i, j, k]] : ea;
+        const fp_t b = voxelized ? material_eb[material.v[i, j, k]] : eb;
+        e.z[i, j, k] = a * (b * e.z[i, j, k] + d_inv.x * (h.y[i, j, k] - h.y[i - 1, j, k]) -
+                            d_inv.y * (h.x[i, j, k] - h.x[i, j - 1, k]) - (sourced ? current.z[i, j, k] : 0));
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit World::update_ez box");
+}
+
+void World::update_hx(const fp_t hya, const fp_t hza) const {
+  SPDLOG_TRACE("enter World::update_hx");
+
+  const std::array<ui_t, 3> last = {h.x.extent(0), h.x.extent(1), h.x.extent(2)};
+  for_active({0, 0, 0}, last, [&](const auto &lo, const auto &hi) { update_hx(hya, hza, lo, hi); });
+
+  SPDLOG_TRACE("exit World::update_hx");
+}
+
+void World::update_hx(const fp_t hya, const fp_t hza, const std::array<ui_t, 3> &lo,
+                      const std::array<ui_t, 3> &hi) const {
+  SPDLOG_TRACE("enter World::update_hx box");
+
+  for (ui_t i = lo[0]; i < hi[0]; ++i) {
+    for (ui_t j = lo[1]; j < hi[1]; ++j) {
+      for (ui_t k = lo[2]; k < hi[2]; ++k) {
+        h.x[i, j, k] += -hya * (e.z[i, j + 1, k] - e.z[i, j, k]) + hza * (e.y[i, j, k + 1] - e.y[i, j, k]);
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit World::update_hx box");
+}
+
+void World::update_hy(const fp_t hxa, const fp_t hza) const {
+  SPDLOG_TRACE("enter World::update_hy");
+
+  const std::array<ui_t, 3> last = {h.y.extent(0), h.y.extent(1), h.y.extent(2)};
+  for_active({0, 0, 0}, last, [&](const auto &lo, const auto &hi) { update_hy(hxa, hza, lo, hi); });
+
+  SPDLOG_TRACE("exit World::update_hy");
+}
+
+void World::update_hy(const fp_t hxa, const fp_t hza, const std::array<ui_t, 3> &lo,
+                      const std::array<ui_t, 3> &hi) const {
+  SPDLOG_TRACE("enter World::update_hy box");
+
+  for (ui_t i = lo[0]; i < hi[0]; ++i) {
+    for (ui_t j = lo[1]; j < hi[1]; ++j) {
+      for (ui_t k = lo[2]; k < hi[2]; ++k) {
+        h.y[i, j, k] += -hza * (e.x[i, j, k + 1] - e.x[i, j, k]) + hxa * (e.z[i + 1, j, k] - e.z[i, j, k]);
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit World::update_hy box");
+}
+
+void World::update_hz(const fp_t hxa, const fp_t hya) const {
+  SPDLOG_TRACE("enter World::update_hz");
+
+  const std::array<ui_t, 3> last = {h.z.extent(0), h.z.extent(1), h.z.extent(2)};
+  for_active({0, 0, 0}, last, [&](const auto &lo, const auto &hi) { update_hz(hxa, hya, lo, hi); });
+
+  SPDLOG_TRACE("exit World::update_hz");
+}
+
+void World::update_hz(const fp_t hxa, const fp_t hya, const std::array<ui_t, 3> &lo,
+                      const std::array<ui_t, 3> &hi) const {
+  SPDLOG_TRACE("enter World::update_hz box");
+
+  for (ui_t i = lo[0]; i < hi[0]; ++i) {
+    for (ui_t j = lo[1]; j < hi[1]; ++j) {
+      for (ui_t k = lo[2]; k < hi[2]; ++k) {
+        h.z[i, j, k] += -hxa * (e.y[i + 1, j, k] - e.y[i, j, k]) + hya * (e.x[i, j + 1, k] - e.x[i, j, k]);
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit World::update_hz box");
+}
+
+void World::update_e_boundary(const fp_t ea, const fp_t eb) const {
+  SPDLOG_TRACE("enter World::update_e_boundary");
+
+  // tangential electric fields on PEC faces are never updated and remain zero, wrapping axes only update their low
+  // face as the high face is a ghost copy of it
+  for (ui_t f = 0; f < cfg.boundary.size(); ++f) {
+    const bool wraps = cfg.boundary[f] == Boundary::PERIODIC || cfg.boundary[f] == Boundary::BLOCH;
+    if (cfg.boundary[f] == Boundary::PMC || (wraps && f % 2 == 0)) {
+      update_e_face(f / 2, f % 2 == 1, ea, eb);
+    }
+  }
+
+  update_e_ghosts();
+
+  SPDLOG_TRACE("exit World::update_e_boundary");
+}
+
+void World::update_e_face(const ui_t axis, const bool hi, const fp_t ea, const fp_t eb) const {
+  SPDLOG_TRACE("enter World::update_e_face");
+
+  const std::array<ui_t, 3> n = {nv_h.x, nv_h.y, nv_h.z};
+  const std::array<fp_t, 3> di = {d_inv.x, d_inv.y, d_inv.z};
+  const std::array ev = {e.x, e.y, e.z};
+  const std::array ev_im = {e_im.x, e_im.y, e_im.z};
+  const std::array jv = {current.x, current.y, current.z};
+  const bool bloch = e_im.x_data != nullptr;
+  const bool sourced = current.x_data != nullptr;
+
+  // voxelized geometry selects loop constants per node like the internal kernels, nodes on a high face have no voxel of
+  // their own and take the one just inside
+  const bool voxelized = material.data != nullptr;
+
+  const auto wraps = [this](const ui_t a) {
+    return cfg.boundary[2 * a] == Boundary::PERIODIC || cfg.boundary[2 * a] == Boundary::BLOCH;
+  };
+
+  for (ui_t c = 0; c < 3; ++c) {
+    // normal electric fields lie half a voxel inside of the face and are only owned by it when the axis wraps
+    if (c == axis && !wraps(axis)) {
+      continue;
+    }
+
+    // index ranges [lo, hi) where points shared with another non-PEC face are owned by the face of lowest axis
+    std::array<ui_t, 3> lo{}, up{};
+    for (ui_t a = 0; a < 3; ++a) {
+      if (a == axis) {
+        lo[a] = hi ? n[a] : 0;
+        up[a] = lo[a] + 1;
+      } else if (a < axis) {
+        lo[a] = 1;
+        up[a] = n[a];
+      } else if (a == c) {
+        lo[a] = wraps(a) ? 0 : 1;
+        up[a] = n[a];
+      } else {
+        lo[a] = cfg.boundary[2 * a] != Boundary::PEC ? 0 : 1;
+        up[a] = cfg.boundary[2 * a + 1] == Boundary::PMC ? n[a] + 1 : n[a];
+      }
+    }
+
+    // curl operands
+    const ui_t p = (c + 1) % 3;
+    const ui_t q = (c + 2) % 3;
+
+    for (ui_t i = lo[0]; i < up[0]; ++i) {
+      for (ui_t j = lo[1]; j < up[1]; ++j) {
+        for (ui_t k = lo[2]; k < up[2]; ++k) {
+          const std::array<si_t, 3> idx = {static_cast<si_t>(i), static_cast<si_t>(j), static_cast<si_t>(k)};
+          auto idx_p = idx;
+          --idx_p[p];
+          auto idx_q = idx;
+          --idx_q[q];
+
+          const std::complex<fp_t> curl =
+              di[p] * (h_at(q, idx) - h_at(q, idx_p)) - di[q] * (h_at(p, idx) - h_at(p, idx_q));
+
+          const uint8_t id =
+              voxelized ? material.v[std::min(i, n[0] - 1), std::min(j, n[1] - 1), std::min(k, n[2] - 1)] : 0;
+          const fp_t a = voxelized ? material_ea[id] : ea;
+          const fp_t b = voxelized ? material_eb[id] : eb;
+
+          ev[c][i, j, k] = a * (b * ev[c][i, j, k] + curl.real() - (sourced ? jv[c][i, j, k] : 0));
+          if (bloch) {
+            ev_im[c][i, j, k] = a * (b * ev_im[c][i, j, k] + curl.imag());
+          }
+        }
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit World::update_e_face");
+}
+
+std::expected<void, std::string> World::solve_gauss() {
+  SPDLOG_TRACE("enter World::solve_gauss");
+
+  const auto &fine = mg.levels.front();
+  const auto &f = fine.f.v;
+  const std::array<ui_t, 3> n = {nv_h.x, nv_h.y, nv_h.z};
+
+  std::fill_n(fine.f.data, f.extent(0) * f.extent(1) * f.extent(2), static_cast<fp_t>(0.0));
+
+  // charge is weighted with the shape of the esirkepov deposition so cleaning agrees with the continuity equation
+  switch (cfg.shape_order) {
+  case 0:
+    deposit_charge<0>();
+    break;
+  case 1:
+    deposit_charge<1>();
+    break;
+  case 2:
+    deposit_charge<2>();
+    break;
+  default:
+    deposit_charge<3>();
+    break;
+  }
+
+  // fold charge of the duplicate periodic node onto the first node and double charge on symmetry planes to account
+  // for the image outside of the domain
+  for (ui_t a = 0; a < 3; ++a) {
+    std::array<ui_t, 3> up = {n[0] + 1, n[1] + 1, n[2] + 1};
+    up[a] = 1;
+    for (ui_t i = 0; i < up[0]; ++i) {
+      for (ui_t j = 0; j < up[1]; ++j) {
+        for (ui_t k = 0; k < up[2]; ++k) {
+          std::array<ui_t, 3> g = {i, j, k};
+          g[a] = n[a];
+          if (mg.periodic[a]) {
+            f[i, j, k] += f[g[0], g[1], g[2]];
+            f[g[0], g[1], g[2]] = f[i, j, k];
+            continue;
+          }
+          if (cfg.boundary[2 * a] == Boundary::PMC) {
+            f[i, j, k] *= static_cast<fp_t>(2.0);
+          }
+          if (cfg.boundary[2 * a + 1] == Boundary::PMC) {
+            f[g[0], g[1], g[2]] *= static_cast<fp_t>(2.0);
+          }
+        }
+      }
+    }
+  }
+
+  // the solve targets the missing divergence so a field that already satisfies Gauss's law is left unchanged, normal
+  // fields mirror with opposite sign across symmetry planes
+  const std::array ev = {e.x, e.y, e.z};
+  const std::array<fp_t, 3> di = {d_inv.x, d_inv.y, d_inv.z};
+#pragma omp parallel for collapse(2)
+  for (ui_t i = fine.first[0]; i < fine.last[0]; ++i) {
+    for (ui_t j = fine.first[1]; j < fine.last[1]; ++j) {
+      for (ui_t k = fine.first[2]; k < fine.last[2]; ++k) {
+        const std::array<ui_t, 3> idx = {i, j, k};
+        fp_t div = 0.0;
+        for (ui_t a = 0; a < 3; ++a) {
+          std::array<ui_t, 3> lo = idx;
+          lo[a] = idx[a] > 0 ? idx[a] - 1 : n[a] - 1;
+          const fp_t e_below = ev[a][lo[0], lo[1], lo[2]];
+
+          // nodes on the upper symmetry plane only have an edge below and nodes on the lower one only above
+          if (idx[a] == n[a]) {
+            div -= static_cast<fp_t>(2.0) * di[a] * e_below;
+          } else if (idx[a] == 0 && !mg.periodic[a]) {
+            div += static_cast<fp_t>(2.0) * di[a] * ev[a][i, j, k];
+          } else {
+            div += di[a] * (ev[a][i, j, k] - e_below);
+          }
+        }
+        f[i, j, k] -= div;
+      }
+    }
+  }
+
+  std::fill_n(fine.phi.data, f.extent(0) * f.extent(1) * f.extent(2), static_cast<fp_t>(0.0));
+
+  if (const auto result = mg.solve(cfg.poisson_tolerance, cfg.poisson_cycles); result.has_value()) {
+    SPDLOG_DEBUG("gauss's law solved in {} multigrid cycles", result.value());
+  } else {
+    SPDLOG_CRITICAL(result.error());
+    return std::unexpected(result.error());
+  }
+
+  // remove the gradient of the correction potential from every edge
+  const auto &phi = fine.phi.v;
+#pragma omp parallel for collapse(2)
+  for (ui_t i = 0; i <= n[0]; ++i) {
+    for (ui_t j = 0; j <= n[1]; ++j) {
+      for (ui_t k = 0; k <= n[2]; ++k) {
+        if (i < n[0]) {
+          e.x[i, j, k] -= d_inv.x * (phi[i + 1, j, k] - phi[i, j, k]);
+        }
+        if (j < n[1]) {
+          e.y[i, j, k] -= d_inv.y * (phi[i, j + 1, k] - phi[i, j, k]);
+        }
+        if (k < n[2]) {
+          e.z[i, j, k] -= d_inv.z * (phi[i, j, k + 1] - phi[i, j, k]);
+        }
+      }
+    }
+  }
+
+  if (cfg.wraps(false)) {
+    update_e_ghosts();
+  }
+
+  SPDLOG_TRACE("exit World::solve_gauss");
+  return {};
+}
+
+template <ui_t O> void World::deposit_charge() const {
+  const auto &f = mg.levels.front().f.v;
+  const auto [px, py, pz] = shape_period();
+
+  for (const auto &s : species) {
+    const fp_t q = s.charge * d_inv.x * d_inv.y * d_inv.z / ep;
+
+#pragma omp parallel for schedule(static)
+    for (ui_t p = 0; p < s.p.num; ++p) {
+      const auto sx = stencil<O>(s.p.x[p] * d_inv.x, nv_e.x, px);
+      const auto sy = stencil<O>(s.p.y[p] * d_inv.y, nv_e.y, py);
+      const auto sz = stencil<O>(s.p.z[p] * d_inv.z, nv_e.z, pz);
+
+      const fp_t qw = q * s.p.w[p];
+      for (ui_t a = 0; a < Stencil<O>::N; ++a) {
+        for (ui_t b = 0; b < Stencil<O>::N; ++b) {
+          for (ui_t c = 0; c < Stencil<O>::N; ++c) {
+#pragma omp atomic
+            f[sx.idx[a], sy.idx[b], sz.idx[c]] += qw * sx.w[a] * sy.w[b] * sz.w[c];
+          }
+        }
+      }
+    }
+  }
+}
+
+void World::update_e_ghosts() const {
+  SPDLOG_TRACE("enter World::update_e_ghosts");
+
+  const std::array<ui_t, 3> n = {nv_h.x, nv_h.y, nv_h.z};
+  const std::array ev = {e.x, e.y, e.z};
+  const std::array ev_im = {e_im.x, e_im.y, e_im.z};
+  const bool bloch = e_im.x_data != nullptr;
+
+  // axes are copied in order so edges and corners pick up the phase of every axis they wrap across
+  for (ui_t a = 0; a < 3; ++a) {
+    if (cfg.boundary[2 * a] != Boundary::PERIODIC && cfg.boundary[2 * a] != Boundary::BLOCH) {
+      continue;
+    }
+
+    const std::complex<fp_t> shift = bloch_shift[a];
+
+    std::array<ui_t, 3> up = {nv_e.x, nv_e.y, nv_e.z};
+    up[a] = 1;
+
+    for (ui_t c = 0; c < 3; ++c) {
+      for (ui_t i = 0; i < up[0]; ++i) {
+        for (ui_t j = 0; j < up[1]; ++j) {
+          for (ui_t k = 0; k < up[2]; ++k) {
+            std::array<ui_t, 3> g = {i, j, k};
+            g[a] = n[a];
+
+            if (bloch) {
+              const std::complex<fp_t> val = shift * std::complex<fp_t>(ev[c][i, j, k], ev_im[c][i, j, k]);
+              ev[c][g[0], g[1], g[2]] = val.real();
+              ev_im[c][g[0], g[1], g[2]] = val.imag();
+            } else {
+              ev[c][g[0], g[1], g[2]] = ev[c][i, j, k];
+            }
+          }
+        }
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit World::update_e_ghosts");
+}
+
+void World::update_h_boundary(const fp_t hxa, const fp_t hya, const fp_t hza) const {
+  SPDLOG_TRACE("enter World::update_h_boundary");
+
+  // normal magnetic fields on high faces lie outside of the stored field and are only required by PMC faces
+  if (cfg.boundary[1] == Boundary::PMC) {
+    const ui_t i = nv_h.x;
+    for (ui_t j = 0; j < hx_hi.v.extent(0); ++j) {
+      for (ui_t k = 0; k < hx_hi.v.extent(1); ++k) {
+        hx_hi.v[j, k] += -hya * (e.z[i, j + 1, k] - e.z[i, j, k]) + hza * (e.y[i, j, k + 1] - e.y[i, j, k]);
+      }
+    }
+  }
+
+  if (cfg.boundary[3] == Boundary::PMC) {
+    const ui_t j = nv_h.y;
+    for (ui_t i = 0; i < hy_hi.v.extent(0); ++i) {
+      for (ui_t k = 0; k < hy_hi.v.extent(1); ++k) {
+        hy_hi.v[i, k] += -hza * (e.x[i, j, k + 1] - e.x[i, j, k]) + hxa * (e.z[i + 1, j, k] - e.z[i, j, k]);
+      }
+    }
+  }
+
+  if (cfg.boundary[5] == Boundary::PMC) {
+    const ui_t k = nv_h.z;
+    for (ui_t i = 0; i < hz_hi.v.extent(0); ++i) {
+      for (ui_t j = 0; j < hz_hi.v.extent(1); ++j) {
+        hz_hi.v[i, j] += -hxa * (e.y[i + 1, j, k] - e.y[i, j, k]) + hya * (e.x[i, j + 1, k] - e.x[i, j, k]);
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit World::update_h_boundary");
+}
+
+std::complex<fp_t> World::h_at(const ui_t c, std::array<si_t, 3> idx) const {
+  const std::array<si_t, 3> n = {static_cast<si_t>(nv_h.x), static_cast<si_t>(nv_h.y), static_cast<si_t>(nv_h.z)};
+
+  std::complex<fp_t> factor = 1.0;
+  for (ui_t a = 0; a < 3; ++a) {
+    if (a == c) {
+      continue;
+    }
+
+    // tangential magnetic fields are odd about a magnetic wall which places a zero on the face itself, wrapping axes
+    // read the last voxel with the phase shift undone
+    if (idx[a] < 0 && cfg.boundary[2 * a] == Boundary::PMC) {
+      idx[a] = 0;
+      factor = -factor;
+    } else if (idx[a] < 0) {
+      idx[a] = n[a] - 1;
+      factor *= std::conj(bloch_shift[a]);
+    } else if (idx[a] >= n[a]) {
+      idx[a] = n[a] - 1;
+      factor = -factor;
+    }
+  }
+
+  const auto i = static_cast<ui_t>(idx[0]);
+  const auto j = static_cast<ui_t>(idx[1]);
+  const auto k = static_cast<ui_t>(idx[2]);
+
+  // normal magnetic fields on high PMC faces are real as Bloch boundaries cannot be combined with PMC faces
+  if (idx[c] == n[c]) {
+    switch (c) {
+    case 0:
+      return factor * hx_hi.v[j, k];
+    case 1:
+      return factor * hy_hi.v[i, k];
+    default:
+      return factor * hz_hi.v[i, j];
+    }
+  }
+
+  const std::array hv = {h.x, h.y, h.z};
+  if (h_im.x_data == nullptr) {
+    return factor * hv[c][i, j, k];
+  }
+
+  const std::array hv_im = {h_im.x, h_im.y, h_im.z};
+  return factor * std::complex<fp_t>(hv[c][i, j, k], hv_im[c][i, j, k]);
+}
+
+void World::push_particles(const fp_t dt) {
+  SPDLOG_TRACE("enter World::push_particles");
+
+  if (species.empty()) {
+    SPDLOG_TRACE("exit World::push_particles");
+    return;
+  }
+
+  const auto start_time = std::chrono::high_resolution_clock::now();
+
+  zero_current(current);
+
+  for (auto &s : species) {
+    const fp_t qdt2m = s.charge * dt / (static_cast<fp_t>(2.0) * s.mass);
+    const ui_t num = s.p.num;
+
+    // removals invalidate tile offsets which colored and tile-private deposition rely on to group particles by tile
+    if (cfg.deposit != Deposit::ATOMIC && !s.sorted) {
+      sort_species(s);
+    }
+
+    if (cfg.deposit == Deposit::COLORED) {
+      // tiles of one parity along every axis never share current density elements
+      for (ui_t color = 0; color < 8; ++color) {
+#pragma omp parallel for schedule(dynamic)
+        for (ui_t t = 0; t < num_tiles(); ++t) {
+          const ui_t tk = t % nt.z;
+          const ui_t tj = t / nt.z % nt.y;
+          const ui_t ti = t / (nt.y * nt.z);
+          if (((ti & 1) << 2 | (tj & 1) << 1 | (tk & 1)) == color) {
+            push_tile(s, t, qdt2m, dt);
+          }
+        }
+      }
+    } else if (cfg.balance_period > 0 && !s.tile_offsets.empty() && s.tile_offsets.back() == num) {
+      // tile offsets partition the particles as long as none were added or removed since the last sort even if
+      // particles have since moved between tiles, so every thread pushes a contiguous range of tiles whose measured
+      // cost rebalance keeps even
+      const ui_t num_parts = thread_tiles.size() - 1;
+
+#pragma omp parallel num_threads(num_parts)
+      {
+        // a team smaller than requested picks up the remaining partitions in turn
+        const auto team = static_cast<ui_t>(omp_get_num_threads());
+        for (auto part = static_cast<ui_t>(omp_get_thread_num()); part < num_parts; part += team) {
+          const double part_start = omp_get_wtime();
+
+          for (ui_t t = thread_tiles[part]; t < thread_tiles[part + 1]; ++t) {
+            const double tile_start = omp_get_wtime();
+            push_tile(s, t, qdt2m, dt);
+            tile_cost[t] += omp_get_wtime() - tile_start;
+          }
+
+          thread_time[part] += omp_get_wtime() - part_start;
+        }
+      }
+    } else if (cfg.deposit == Deposit::REDUCE) {
+#pragma omp parallel for schedule(dynamic)
+      for (ui_t t = 0; t < num_tiles(); ++t) {
+        push_tile(s, t, qdt2m, dt);
+      }
+    } else {
+      const ui_t num_batches = (num + Particles::LINE - 1) / Particles::LINE;
+
+#pragma omp parallel for schedule(static)
+      for (ui_t b = 0; b < num_batches; ++b) {
+        push_range(s, b * Particles::LINE, std::min((b + 1) * Particles::LINE, num), qdt2m, dt);
+      }
+    }
+
+    num_pushed += num;
+    s.ordered = false;
+    apply_particle_boundaries(s);
+  }
+
+  push_time += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+
+  SPDLOG_TRACE("exit World::push_particles");
+}
+
+void World::push_range(const Species &s, const ui_t lo, const ui_t hi, const fp_t qdt2m, const fp_t dt,
+                       TileCurrent *tile) const {
+  for (ui_t first = lo; first < hi; first += Particles::LINE) {
+    const ui_t len = std::min(Particles::LINE, hi - first);
+
+    FieldBatch f;
+    gather(s.p, first, len, f);
+
+    PositionBatch r0;
+    std::copy_n(s.p.x + first, len, r0.x);
+    std::copy_n(s.p.y + first, len, r0.y);
+    std::copy_n(s.p.z + first, len, r0.z);
+
+    switch (cfg.pusher) {
+    case Pusher::BORIS:
+      push_batch<Pusher::BORIS>(s.p, first, len, f, qdt2m, dt);
+      break;
+    case Pusher::HIGUERA_CARY:
+      push_batch<Pusher::HIGUERA_CARY>(s.p, first, len, f, qdt2m, dt);
+      break;
+    }
+
+    deposit(s, first, len, r0, dt, tile);
+  }
+}
+
+void World::push_tile(const Species &s, const ui_t t, const fp_t qdt2m, const fp_t dt) {
+  if (cfg.deposit != Deposit::REDUCE) {
+    push_range(s, s.tile_offsets[t], s.tile_offsets[t + 1], qdt2m, dt);
+    return;
+  }
+
+  TileCurrent &tc = current_private[omp_get_thread_num()];
+  const std::array<ui_t, 3> ti = {t / (nt.y * nt.z), t / nt.z % nt.y, t % nt.z};
+  for (ui_t a = 0; a < 3; ++a) {
+    tc.origin[a] = static_cast<si_t>(ti[a] * cfg.tile_size) - static_cast<si_t>(current_halo);
+  }
+
+  push_range(s, s.tile_offsets[t], s.tile_offsets[t + 1], qdt2m, dt, &tc);
+  flush_tile(tc, current, {nv_e.x, nv_e.y, nv_e.z}, shape_period());
+}
+
+void World::rebalance() {
+  SPDLOG_TRACE("enter World::rebalance");
+
+  if (thread_time.empty()) {
+    SPDLOG_TRACE("exit World::rebalance");
+    return;
+  }
+
+  const ui_t num_threads = thread_time.size();
+  const double total = std::accumulate(thread_time.begin(), thread_time.end(), 0.0);
+  const double slowest = *std::ranges::max_element(thread_time);
+
+  // nothing was measured if no species used the tiled push since the last check
+  if (total <= 0.0) {
+    SPDLOG_TRACE("exit World::rebalance");
+    return;
+  }
+
+  const double imbalance = slowest * static_cast<double>(num_threads) / total;
+  SPDLOG_DEBUG("particle push imbalance (slowest / mean thread time): {:.3f}", imbalance);
+
+  if (imbalance > cfg.balance_threshold) {
+    // every tile is charged at least a small share of the mean so empty tiles still spread out
+    const double min_cost = 1e-3 * total / static_cast<double>(num_tiles());
+    const double cost = std::accumulate(tile_cost.begin(), tile_cost.end(), 0.0) + min_cost * num_tiles();
+
+    // cut the tile-major order where the running cost crosses every multiple of the cost per thread
+    double running = 0.0;
+    ui_t tid = 1;
+    for (ui_t t = 0; t < num_tiles() && tid < num_threads; ++t) {
+      running += tile_cost[t] + min_cost;
+      while (tid < num_threads && running >= cost * static_cast<double>(tid) / static_cast<double>(num_threads)) {
+        thread_tiles[tid++] = t + 1;
+      }
+    }
+    while (tid < num_threads) {
+      thread_tiles[tid++] = num_tiles();
+    }
+
+    SPDLOG_DEBUG("particle tiles repartitioned across {} threads", num_threads);
+  }
+
+  std::ranges::fill(tile_cost, 0.0);
+  std::ranges::fill(thread_time, 0.0);
+
+  SPDLOG_TRACE("exit World::rebalance");
+}
+
+void World::sort_particles() {
+  SPDLOG_TRACE("enter World::sort_particles");
+
+  for (auto &s : species) {
+    sort_species(s);
+  }
+
+  SPDLOG_TRACE("exit World::sort_particles");
+}
+
+void World::sort_species(Species &s) {
+  SPDLOG_TRACE("enter World::sort_species");
+
+  const ui_t num = s.p.num;
+  const ui_t tile = cfg.tile_size;
+  const ui_t tile_vol = tile * tile * tile;
+  const ui_t n_tiles = num_tiles();
+  const auto num_threads = static_cast<ui_t>(omp_get_max_threads());
+
+  sort_keys.resize(num);
+  sort_dest.resize(num);
+  sort_src.resize(num);
+  sort_counts.assign(num_threads * n_tiles, 0);
+  s.tile_offsets.resize(n_tiles + 1);
+
+#pragma omp parallel num_threads(num_threads)
+  {
+    const auto tid = static_cast<ui_t>(omp_get_thread_num());
+    const ui_t lo = num * tid / num_threads;
+    const ui_t hi = num * (tid + 1) / num_threads;
+    ui_t *counts = sort_counts.data() + tid * n_tiles;
+
+    for (ui_t n = lo; n < hi; ++n) {
+      sort_keys[n] = sort_key(s.p, n);
+      ++counts[sort_keys[n] / tile_vol];
+    }
+
+#pragma omp barrier
+#pragma omp single
+    {
+      // exclusive scan in (tile, thread) order keeps the sort stable and deterministic
+      ui_t running = 0;
+      for (ui_t t = 0; t < n_tiles; ++t) {
+        s.tile_offsets[t] = running;
+        for (ui_t th = 0; th < num_threads; ++th) {
+          const ui_t c = sort_counts[th * n_tiles + t];
+          sort_counts[th * n_tiles + t] = running;
+          running += c;
+        }
+      }
+      s.tile_offsets[n_tiles] = running;
+    }
+
+    for (ui_t n = lo; n < hi; ++n) {
+      const ui_t pos = counts[sort_keys[n] / tile_vol]++;
+      sort_dest[n] = pos;
+      sort_src[pos] = n;
+    }
+  }
+
+  // order particles by voxel within each tile
+#pragma omp parallel
+  {
+    std::vector<ui_t> offsets(tile_vol);
+
+#pragma omp for schedule(dynamic)
+    for (ui_t t = 0; t < n_tiles; ++t) {
+      std::ranges::fill(offsets, 0);
+      for (ui_t pos = s.tile_offsets[t]; pos < s.tile_offsets[t + 1]; ++pos) {
+        ++offsets[sort_keys[sort_src[pos]] % tile_vol];
+      }
+
+      ui_t running = s.tile_offsets[t];
+      for (auto &o : offsets) {
+        const ui_t c = o;
+        o = running;
+        running += c;
+      }
+
+      for (ui_t pos = s.tile_offsets[t]; pos < s.tile_offsets[t + 1]; ++pos) {
+        const ui_t n = sort_src[pos];
+        sort_dest[n] = offsets[sort_keys[n] % tile_vol]++;
+      }
+    }
+  }
+
+  s.p.permute(sort_dest.data());
+  s.sorted = true;
+  s.ordered = true;
+
+  SPDLOG_TRACE("exit World::sort_species");
+}
+
+void World::update_activity() {
+  SPDLOG_TRACE("enter World::update_activity");
+
+  const ui_t num = num_tiles();
+  tile_energy.assign(num, static_cast<fp_t>(0.0));
+  tile_live.assign(num, 0);
+
+  const bool bloch = e_im.x_data != nullptr;
+  const std::array<ui_t, 3> e_hi = {nv_e.x, nv_e.y, nv_e.z};
+  const std::array<ui_t, 3> h_hi = {nv_h.x, nv_h.y, nv_h.z};
+
+  // energies are only compared against each other so constant factors of the field energy density are dropped
+#pragma omp parallel for schedule(dynamic)
+  for (ui_t t = 0; t < num; ++t) {
+    fp_t energy = 0.0;
+
+    const auto [e_lo, e_up] = tile_box(t, {0, 0, 0}, e_hi);
+    for (ui_t i = e_lo[0]; i < e_up[0]; ++i) {
+      for (ui_t j = e_lo[1]; j < e_up[1]; ++j) {
+        for (ui_t k = e_lo[2]; k < e_up[2]; ++k) {
+          energy += ep * (e.x[i, j, k] * e.x[i, j, k] + e.y[i, j, k] * e.y[i, j, k] + e.z[i, j, k] * e.z[i, j, k]);
+          if (bloch) {
+            energy += ep * (e_im.x[i, j, k] * e_im.x[i, j, k] + e_im.y[i, j, k] * e_im.y[i, j, k] +
+                            e_im.z[i, j, k] * e_im.z[i, j, k]);
+          }
+        }
+      }
+    }
+
+    const auto [h_lo, h_up] = tile_box(t, {0, 0, 0}, h_hi);
+    for (ui_t i = h_lo[0]; i < h_up[0]; ++i) {
+      for (ui_t j = h_lo[1]; j < h_up[1]; ++j) {
+        for (ui_t k = h_lo[2]; k < h_up[2]; ++k) {
+          energy += mu * (h.x[i, j, k] * h.x[i, j, k] + h.y[i, j, k] * h.y[i, j, k] + h.z[i, j, k] * h.z[i, j, k]);
+          if (bloch) {
+            energy += mu * (h_im.x[i, j, k] * h_im.x[i, j, k] + h_im.y[i, j, k] * h_im.y[i, j, k] +
+                            h_im.z[i, j, k] * h_im.z[i, j, k]);
+          }
+        }
+      }
+    }
+
+    tile_energy[t] = energy;
+  }
+
+  // a zero threshold only leaves tiles without any field quiescent, which skips no work that would change a value
+  const fp_t cutoff = cfg.activity_threshold * std::ranges::max(tile_energy);
+  for (ui_t t = 0; t < num; ++t) {
+    tile_live[t] = tile_energy[t] > cutoff ? 1 : 0;
+  }
+
+  // particles source currents wherever they are regardless of the field
+  const ui_t tile_vol = cfg.tile_size * cfg.tile_size * cfg.tile_size;
+  for (const auto &s : species) {
+#pragma omp parallel for schedule(static)
+    for (ui_t n = 0; n < s.p.num; ++n) {
+#pragma omp atomic write
+      tile_live[sort_key(s.p, n) / tile_vol] = 1;
+    }
+  }
+
+  // live tiles and their neighbors are active as fields spread by less than a tile between updates
+  const std::array<ui_t, 3> n = {nt.x, nt.y, nt.z};
+  const std::array<bool, 3> wraps = {cfg.boundary[0] == Boundary::PERIODIC || cfg.boundary[0] == Boundary::BLOCH,
+                                     cfg.boundary[2] == Boundary::PERIODIC || cfg.boundary[2] == Boundary::BLOCH,
+                                     cfg.boundary[4] == Boundary::PERIODIC || cfg.boundary[4] == Boundary::BLOCH};
+  active_tiles.clear();
+  for (ui_t t = 0; t < num; ++t) {
+    const std::array<ui_t, 3> ti = {t / (n[1] * n[2]), t / n[2] % n[1], t % n[2]};
+
+    bool active = false;
+    for (si_t di = -1; di <= 1 && !active; ++di) {
+      for (si_t dj = -1; dj <= 1 && !active; ++dj) {
+        for (si_t dk = -1; dk <= 1 && !active; ++dk) {
+          const std::array<si_t, 3> off = {di, dj, dk};
+          std::array<ui_t, 3> nb = {0, 0, 0};
+          bool inside = true;
+          for (ui_t a = 0; a < 3; ++a) {
+            const si_t c = static_cast<si_t>(ti[a]) + off[a];
+            if (c >= 0 && c < static_cast<si_t>(n[a])) {
+              nb[a] = static_cast<ui_t>(c);
+            } else if (wraps[a]) {
+              nb[a] = c < 0 ? n[a] - 1 : 0;
+            } else {
+              inside = false;
+            }
+          }
+          active = inside && tile_live[(nb[0] * n[1] + nb[1]) * n[2] + nb[2]] == 1;
+        }
+      }
+    }
+
+    if (active) {
+      active_tiles.push_back(t);
+    }
+  }
+  SPDLOG_DEBUG("active field tiles: {}/{}", active_tiles.size(), num);
+
+  SPDLOG_TRACE("exit World::update_activity");
+}
+
+std::array<std::array<ui_t, 3>, 2> World::tile_box(const ui_t t, const std::array<ui_t, 3> &lo,
+                                                   const std::array<ui_t, 3> &hi) const noexcept {
+  const ui_t ts = cfg.tile_size;
+  const std::array<ui_t, 3> n = {nt.x, nt.y, nt.z};
+  const std::array<ui_t, 3> ti = {t / (n[1] * n[2]), t / n[2] % n[1], t % n[2]};
+
+  std::array<std::array<ui_t, 3>, 2> box;
+  for (ui_t a = 0; a < 3; ++a) {
+    box[0][a] = std::max(lo[a], ti[a] * ts);
+    box[1][a] = ti[a] == n[a] - 1 ? hi[a] : std::min(hi[a], (ti[a] + 1) * ts);
+  }
+  return box;
+}
+
+ui_t World::num_tiles() const noexcept { return nt.x * nt.y * nt.z; }
+
+ui_t World::sort_key(const Particles &p, const ui_t n) const noexcept {
+  const ui_t tile = cfg.tile_size;
+  const ui_t i = std::min(static_cast<ui_t>(std::max(p.x[n] * d_inv.x, static_cast<fp_t>(0.0))), nv_h.x - 1);
+  const ui_t j = std::min(static_cast<ui_t>(std::max(p.y[n] * d_inv.y, static_cast<fp_t>(0.0))), nv_h.y - 1);
+  const ui_t k = std::min(static_cast<ui_t>(std::max(p.z[n] * d_inv.z, static_cast<fp_t>(0.0))), nv_h.z - 1);
+  const ui_t t = (i / tile * nt.y + j / tile) * nt.z + k / tile;
+
+  // tile index followed by the voxel index within the tile
+  return t * tile * tile * tile + (i % tile * tile + j % tile) * tile + k % tile;
+}
+
+std::expected<void, std::string> World::collide(const fp_t dt) {
+  SPDLOG_TRACE("enter World::collide");
+
+  if (cfg.mcc.species.empty()) {
+    SPDLOG_TRACE("exit World::collide");
+    return {};
+  }
+
+  Species &s = *std::ranges::find(species, cfg.mcc.species, &Species::name);
+  Species *ion = cfg.mcc.ion_species.empty() ? nullptr
+                                             : &*std::ranges::find(species, cfg.mcc.ion_species, &Species::name);
+  Particles &p = s.p;
+
+  // particles are split into fixed chunks that each draw their own number of candidates, counters are built from the
+  // step, chunk, and candidate so results do not depend on the number of threads
+  constexpr ui_t CHUNK = 1024;
+  const ui_t num_chunks = (p.num + CHUNK - 1) / CHUNK;
+  const fp_t p_null = static_cast<fp_t>(1.0) - std::exp(-nu_max * dt);
+  const auto seed = static_cast<uint64_t>(cfg.mcc.seed);
+  const Philox rng{{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}};
+  const auto step_lo = static_cast<uint32_t>(step_count);
+
+  const fp_t e_ex = cfg.mcc.excitation_energy * ELEC_CHARGE;
+  const fp_t e_iz = cfg.mcc.ionization_energy * ELEC_CHARGE;
+  const fp_t ion_vth = ion != nullptr ? std::sqrt(cfg.mcc.gas_temperature * ELEC_CHARGE / ion->mass) : 0.0;
+  const fp_t mass_ratio = static_cast<fp_t>(2.0) * s.mass / cfg.mcc.gas_mass;
+  const fp_t e_max = xs.energy.back() * ELEC_CHARGE;
+
+  std::vector<std::vector<std::array<fp_t, Particles::NUM_COLUMNS>>> born_e(num_chunks);
+  std::vector<std::vector<std::array<fp_t, Particles::NUM_COLUMNS>>> born_i(num_chunks);
+  ui_t num_real = 0;
+
+#pragma omp parallel for schedule(dynamic) reduction(+ : num_real)
+  for (ui_t c = 0; c < num_chunks; ++c) {
+    const ui_t lo = c * CHUNK;
+    const ui_t count = std::min(CHUNK, p.num - lo);
+    const auto chunk_ctr = static_cast<uint32_t>(c);
+
+    // expected number of candidates rounded stochastically and spread evenly over the chunk with a random offset
+    const auto r = rng.uniform({chunk_ctr, 0, step_lo, 0});
+    const auto num_cand = std::min(static_cast<ui_t>(p_null * static_cast<fp_t>(count) + r[0]), count);
+
+    for (ui_t m = 0; m < num_cand; ++m) {
+      const auto offset = static_cast<ui_t>((static_cast<fp_t>(m + 1) - r[1]) * static_cast<fp_t>(count) /
+                                            static_cast<fp_t>(num_cand));
+      const ui_t n = lo + std::min(offset, count - 1);
+      const auto ra = rng.uniform({chunk_ctr, static_cast<uint32_t>(m + 1), step_lo, 1});
+
+      // frequencies above the tabulated range are evaluated at its end to stay below nu_max
+      const fp_t energy = kinetic_energy(p.ux[n], p.uy[n], p.uz[n], s.mass);
+      const fp_t e_eval = std::min(energy, e_max);
+      const auto sig = xs.at(e_eval / ELEC_CHARGE);
+      const fp_t u_eval = proper_speed(e_eval, s.mass);
+      const fp_t v_eval =
+          u_eval / std::sqrt(static_cast<fp_t>(1.0) + u_eval * u_eval / (VAC_SPEED_OF_LIGHT * VAC_SPEED_OF_LIGHT));
+      const fp_t nu_scale = cfg.mcc.gas_density * v_eval / nu_max;
+
+      const fp_t r_el = sig[0] * nu_scale;
+      const fp_t r_ex = r_el + sig[1] * nu_scale;
+      const fp_t r_iz = r_ex + sig[2] * nu_scale;
+      if (ra[0] > r_iz) {
+        // null collision
+        continue;
+      }
+      ++num_real;
+
+      std::array<fp_t, 3> u;
+      if (ra[0] <= r_el) {
+        // elastic scattering off a heavy neutral loses a fraction 2 m / M (1 - cos chi) of the energy
+        const auto dir = isotropic(static_cast<fp_t>(1.0), ra[1], ra[2]);
+        const fp_t u_old = std::sqrt(p.ux[n] * p.ux[n] + p.uy[n] * p.uy[n] + p.uz[n] * p.uz[n]);
+        const fp_t cos_chi =
+            u_old > 0.0 ? (dir[0] * p.ux[n] + dir[1] * p.uy[n] + dir[2] * p.uz[n]) / u_old : static_cast<fp_t>(0.0);
+        const fp_t loss = mass_ratio * (static_cast<fp_t>(1.0) - cos_chi);
+        const fp_t mag = proper_speed(energy * (static_cast<fp_t>(1.0) - loss), s.mass);
+        u = {mag * dir[0], mag * dir[1], mag * dir[2]};
+      } else if (ra[0] <= r_ex) {
+        u = isotropic(proper_speed(std::max(energy - e_ex, static_cast<fp_t>(0.0)), s.mass), ra[1], ra[2]);
+      } else {
+        // remaining energy is shared equally by the primary and the secondary electron
+        const fp_t share = static_cast<fp_t>(0.5) * std::max(energy - e_iz, static_cast<fp_t>(0.0));
+        const fp_t mag = proper_speed(share, s.mass);
+        u = isotropic(mag, ra[1], ra[2]);
+
+        const auto rb = rng.uniform({chunk_ctr, static_cast<uint32_t>(m + 1), step_lo, 2});
+        const auto u_sec = isotropic(mag, ra[3], rb[0]);
+        born_e[c].push_back({p.x[n], p.y[n], p.z[n], u_sec[0], u_sec[1], u_sec[2], p.w[n]});
+
+        if (ion != nullptr) {
+          // ions are born with the thermal velocity of the background gas from a Box-Muller transform
+          const fp_t g0 = ion_vth * std::sqrt(static_cast<fp_t>(-2.0) * std::log(rb[1]));
+          const fp_t g1 = ion_vth * std::sqrt(static_cast<fp_t>(-2.0) * std::log(rb[3]));
+          const fp_t phi = static_cast<fp_t>(2.0) * std::numbers::pi_v<fp_t> * rb[2];
+          const auto rc = rng.uniform({chunk_ctr, static_cast<uint32_t>(m + 1), step_lo, 3});
+          born_i[c].push_back({p.x[n], p.y[n], p.z[n], g0 * std::cos(phi), g0 * std::sin(phi),
+                               g1 * std::cos(static_cast<fp_t>(2.0) * std::numbers::pi_v<fp_t> * rc[0]), p.w[n]});
+        }
+      }
+
+      p.ux[n] = u[0];
+      p.uy[n] = u[1];
+      p.uz[n] = u[2];
+    }
+  }
+
+  // products are appended in chunk order so particle order is reproducible as well
+  for (ui_t c = 0; c < num_chunks; ++c) {
+    for (const auto &b : born_e[c]) {
+      if (const auto result = p.push(b); !result.has_value()) {
+        SPDLOG_CRITICAL(result.error());
+        return std::unexpected(result.error());
+      }
+    }
+    if (ion != nullptr) {
+      for (const auto &b : born_i[c]) {
+        if (const auto result = ion->p.push(b); !result.has_value()) {
+          SPDLOG_CRITICAL(result.error());
+          return std::unexpected(result.error());
+        }
+      }
+    }
+  }
+
+  if (std::ranges::any_of(born_e, [](const auto &b) { return !b.empty(); })) {
+    s.sorted = false;
+    s.ordered = false;
+    if (ion != nullptr) {
+      ion->sorted = false;
+      ion->ordered = false;
+    }
+  }
+
+  SPDLOG_DEBUG("collisions of species `{}`: {} real collisions", s.name, num_real);
+
+  SPDLOG_TRACE("exit World::collide");
+  return {};
+}
+
+ui_t World::voxel_end(const Particles &p, const ui_t lo, const ui_t hi) const noexcept {
+  // particles of one voxel share a key and are adjacent once sorted
+  const ui_t key = sort_key(p, lo);
+  ui_t end = lo + 1;
+  while (end < hi && sort_key(p, end) == key) {
+    ++end;
+  }
+
+  return end;
+}
 
-  // update electric fields
-  update_e(ea, eb);
+void World::coulomb_collide(const fp_t dt) {
+  SPDLOG_TRACE("enter World::coulomb_collide");
 
-  SPDLOG_TRACE("exit World::step");
+  for (ui_t c = 0; c < cfg.coulomb.size(); ++c) {
+    const auto &cc = cfg.coulomb[c];
+    if (step_count % cc.period != 0) {
+      continue;
+    }
+
+    Species &a = *std::ranges::find(species, cc.species_a, &Species::name);
+    Species &b = *std::ranges::find(species, cc.species_b, &Species::name);
+    // pairing walks voxel runs of both species in ascending key order which only holds until the next push
+    if (!a.ordered) {
+      sort_species(a);
+    }
+    if (!b.ordered) {
+      sort_species(b);
+    }
+
+    // q_a^2 q_b^2 ln(Lambda) dt / (8 pi ep_0^2 m_r^2) over one collision period, times n / u^3 gives the variance of
+    // tan(theta / 2) of a pair
+    const fp_t m_r = a.mass * b.mass / (a.mass + b.mass);
+    const fp_t coef = a.charge * a.charge * b.charge * b.charge * cc.coulomb_log * dt * static_cast<fp_t>(cc.period) /
+                      (static_cast<fp_t>(8.0) * std::numbers::pi_v<fp_t> * VAC_PERMITTIVITY * VAC_PERMITTIVITY * m_r *
+                       m_r);
+    const fp_t vol_inv = d_inv.x * d_inv.y * d_inv.z;
+
+    // counters are built from the step, voxel, and pair so results do not depend on the number of threads
+    const Philox rng{{static_cast<uint32_t>(c), 0}};
+    const auto step_lo = static_cast<uint32_t>(step_count);
+
+    // collides particle i of a with particle j of b
+    const auto pair = [&](const ui_t i, const ui_t j, const fp_t coef_n, const std::array<uint32_t, 4> &ctr) {
+      const std::array<fp_t, 3> u = {a.p.ux[i] - b.p.ux[j], a.p.uy[i] - b.p.uy[j], a.p.uz[i] - b.p.uz[j]};
+      const fp_t u_mag = std::sqrt(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
+      if (u_mag == 0.0) {
+        return;
+      }
+
+      const auto r = rng.uniform(ctr);
+      const fp_t g = std::sqrt(static_cast<fp_t>(-2.0) * std::log(r[0])) *
+                     std::cos(static_cast<fp_t>(2.0) * std::numbers::pi_v<fp_t> * r[1]);
+      const auto du = coulomb_delta(u, coef_n / (u_mag * u_mag * u_mag), g, r[2]);
+
+      // particles of unequal weight are updated with probability w_other / w_self capped at one so momentum and
+      // energy are conserved on average
+      const fp_t wa = a.p.w[i];
+      const fp_t wb = b.p.w[j];
+      if (r[3] * wa <= wb) {
+        a.p.ux[i] += m_r / a.mass * du[0];
+        a.p.uy[i] += m_r / a.mass * du[1];
+        a.p.uz[i] += m_r / a.mass * du[2];
+      }
+      if (r[3] * wb <= wa) {
+        b.p.ux[j] -= m_r / b.mass * du[0];
+        b.p.uy[j] -= m_r / b.mass * du[1];
+        b.p.uz[j] -= m_r / b.mass * du[2];
+      }
+    };
+
+    // random permutation of the particles of one voxel
+    const auto shuffle = [&](std::vector<ui_t> &idx, const ui_t lo, const ui_t hi, const ui_t key, const uint32_t tag) {
+      idx.resize(hi - lo);
+      std::iota(idx.begin(), idx.end(), lo);
+      for (ui_t k = idx.size(); k > 1; --k) {
+        const auto r = rng.uniform({static_cast<uint32_t>(key), static_cast<uint32_t>(k), step_lo, tag});
+        std::swap(idx[k - 1], idx[std::min(static_cast<ui_t>(r[0] * static_cast<fp_t>(k)), k - 1)]);
+      }
+    };
+
+    const auto density = [&](const Species &s, const std::vector<ui_t> &idx) {
+      fp_t w = 0.0;
+      for (const ui_t n : idx) {
+        w += s.p.w[n];
+      }
+      return w * vol_inv;
+    };
+
+#pragma omp parallel
+    {
+      std::vector<ui_t> ia;
+      std::vector<ui_t> ib;
+
+#pragma omp for schedule(dynamic)
+      for (ui_t t = 0; t < num_tiles(); ++t) {
+        ui_t la = a.tile_offsets[t];
+        ui_t lb = b.tile_offsets[t];
+        const ui_t ea = a.tile_offsets[t + 1];
+        const ui_t eb = b.tile_offsets[t + 1];
+
+        if (&a == &b) {
+          // intra-species collisions pair shuffled particles, an odd particle out forms a triple whose three pairs
+          // each collide for half the period
+          while (la < ea) {
+            const ui_t ha = voxel_end(a.p, la, ea);
+            const ui_t key = sort_key(a.p, la);
+            if (ha - la > 1) {
+              shuffle(ia, la, ha, key, 0x10000);
+              const fp_t coef_n = coef * density(a, ia);
+
+              ui_t first = 0;
+              if (ia.size() % 2 == 1) {
+                const fp_t half = static_cast<fp_t>(0.5) * coef_n;
+                pair(ia[0], ia[1], half, {static_cast<uint32_t>(key), 0, step_lo, 0x20000});
+                pair(ia[1], ia[2], half, {static_cast<uint32_t>(key), 1, step_lo, 0x20000});
+                pair(ia[2], ia[0], half, {static_cast<uint32_t>(key), 2, step_lo, 0x20000});
+                first = 3;
+              }
+              for (ui_t k = first; k < ia.size(); k += 2) {
+                pair(ia[k], ia[k + 1], coef_n,
+                     {static_cast<uint32_t>(key), static_cast<uint32_t>(k), step_lo, 0x20000});
+              }
+            }
+            la = ha;
+          }
+          continue;
+        }
+
+        // inter-species collisions walk the voxels of both species together
+        while (la < ea && lb < eb) {
+          const ui_t ka = sort_key(a.p, la);
+          const ui_t kb = sort_key(b.p, lb);
+          if (ka < kb) {
+            la = voxel_end(a.p, la, ea);
+            continue;
+          }
+          if (kb < ka) {
+            lb = voxel_end(b.p, lb, eb);
+            continue;
+          }
+
+          const ui_t ha = voxel_end(a.p, la, ea);
+          const ui_t hb = voxel_end(b.p, lb, eb);
+          shuffle(ia, la, ha, ka, 0x10000);
+          shuffle(ib, lb, hb, ka, 0x18000);
+
+          // every particle of the more numerous species collides once and particles of the other are reused, with
+          // the lower density setting the variance (Takizuka and Abe 1977)
+          const fp_t coef_n = coef * std::min(density(a, ia), density(b, ib));
+          const ui_t num = std::max(ia.size(), ib.size());
+          for (ui_t k = 0; k < num; ++k) {
+            pair(ia[k % ia.size()], ib[k % ib.size()], coef_n,
+                 {static_cast<uint32_t>(ka), static_cast<uint32_t>(k), step_lo, 0x20000});
+          }
+
+          la = ha;
+          lb = hb;
+        }
+      }
+    }
+  }
+
+  SPDLOG_TRACE("exit World::coulomb_collide");
 }
 
-void World::update_e(const fp_t ea, const fp_t eb) const {
-  SPDLOG_TRACE("enter World::update_e");
+std::expected<void, std::string> World::resample_particles() {
+  SPDLOG_TRACE("enter World::resample_particles");
 
-  update_ex(ea, eb);
-  update_ey(ea, eb);
-  update_ez(ea, eb);
+  for (auto &s : species) {
+    [[maybe_unused]] const ui_t before = s.p.num;
 
-  SPDLOG_TRACE("exit World::update_e");
+    if (const auto result = resample_species(s); !result.has_value()) {
+      const auto error = fmt::format("failed to resample species `{}`: {}", s.name, result.error());
+      SPDLOG_CRITICAL(error);
+      return std::unexpected(error);
+    }
+
+    SPDLOG_DEBUG("resampled species `{}` from {} to {} particles", s.name, before, s.p.num);
+  }
+
+  SPDLOG_TRACE("exit World::resample_particles");
+  return {};
 }
 
-void World::update_h(const fp_t hxa, const fp_t hya, const fp_t hza) const {
-  SPDLOG_TRACE("enter World::update_h");
+std::expected<void, std::string> World::resample_species(Species &s) {
+  SPDLOG_TRACE("enter World::resample_species");
 
-  update_hx(hya, hza);
-  update_hy(hxa, hza);
-  update_hz(hxa, hya);
+  // voxels must be contiguous which the sort only guarantees until particles are pushed again
+  if (!s.ordered) {
+    sort_species(s);
+  }
 
-  SPDLOG_TRACE("exit World::update_h");
+  Particles &p = s.p;
+  const std::array<fp_t, 3> ds = {d.x, d.y, d.z};
+  const std::array<fp_t, 3> di = {d_inv.x, d_inv.y, d_inv.z};
+
+  // halves are collected per tile and appended in tile order so particle order does not depend on the thread count
+  std::vector<std::vector<std::array<fp_t, Particles::NUM_COLUMNS>>> halves(num_tiles());
+
+#pragma omp parallel
+  {
+    std::array<std::vector<ui_t>, 8> octants;
+
+#pragma omp for schedule(dynamic)
+    for (ui_t t = 0; t < num_tiles(); ++t) {
+      auto &added = halves[t];
+      ui_t lo = s.tile_offsets[t];
+      while (lo < s.tile_offsets[t + 1]) {
+        const ui_t hi = voxel_end(p, lo, s.tile_offsets[t + 1]);
+        const ui_t count = hi - lo;
+
+        if (count > cfg.merge_above) {
+          // particles are only merged with others moving into the same momentum octant to limit distortion of the
+          // velocity distribution
+          for (auto &o : octants) {
+            o.clear();
+          }
+          for (ui_t n = lo; n < hi; ++n) {
+            octants[(p.ux[n] < 0.0) << 2 | (p.uy[n] < 0.0) << 1 | (p.uz[n] < 0.0)].push_back(n);
+          }
+          for (const auto &o : octants) {
+            if (o.size() > 2) {
+              merge_particles(p, o.data(), o.size());
+            }
+          }
+        } else if (count < cfg.split_below) {
+          // halves are displaced symmetrically along a voxel diagonal by up to a quarter voxel per axis without leaving
+          // the voxel of the original, so a particle resting on a voxel face still spreads along the other axes, the
+          // diagonal alternates with the particle index so splits favor no direction
+          for (ui_t n = lo; n < std::min(hi, lo + cfg.split_below - count); ++n) {
+            const std::array<fp_t, 3> r = {p.x[n], p.y[n], p.z[n]};
+            std::array<fp_t, 3> off{};
+            for (ui_t a = 0; a < 3; ++a) {
+              const fp_t r_lo = std::floor(r[a] * di[a]) * ds[a];
+              const fp_t dr = std::min({static_cast<fp_t>(0.25) * ds[a], static_cast<fp_t>(0.5) * (r[a] - r_lo),
+                                        static_cast<fp_t>(0.5) * (r_lo + ds[a] - r[a])});
+              off[a] = ((n >> a) & 1 ? static_cast<fp_t>(-1.0) : static_cast<fp_t>(1.0)) *
+                       std::max(dr, static_cast<fp_t>(0.0));
+            }
+            added.push_back(split_particle(p, n, off));
+          }
+        }
+
+        lo = hi;
+      }
+    }
+  }
+
+  // merged particles were marked with zero weight
+  sort_keys.resize(p.num);
+#pragma omp parallel for schedule(static)
+  for (ui_t n = 0; n < p.num; ++n) {
+    sort_keys[n] = p.w[n] == 0.0;
+  }
+  compact_particles(p);
+
+  for (const auto &added : halves) {
+    for (const auto &half : added) {
+      if (const auto result = p.push(half); !result.has_value()) {
+        SPDLOG_CRITICAL(result.error());
+        return std::unexpected(result.error());
+      }
+    }
+  }
+
+  s.sorted = false;
+
+  s.ordered = false;
+
+  SPDLOG_TRACE("exit World::resample_species");
+  return {};
 }
 
-void World::update_ex(const fp_t ea, const fp_t eb) const {
-  SPDLOG_TRACE("enter World::update_ex");
+void World::deposit(const Species &s, const ui_t first, const ui_t len, const PositionBatch &r0, const fp_t dt,
+                    TileCurrent *tile) const {
+  const bool atomic = cfg.deposit == Deposit::ATOMIC;
+
+  switch (cfg.shape_order) {
+  case 0:
+    atomic ? deposit_shape<0, true>(tile, s, first, len, r0, dt) : deposit_shape<0, false>(tile, s, first, len, r0, dt);
+    break;
+  case 1:
+    atomic ? deposit_shape<1, true>(tile, s, first, len, r0, dt) : deposit_shape<1, false>(tile, s, first, len, r0, dt);
+    break;
+  case 2:
+    atomic ? deposit_shape<2, true>(tile, s, first, len, r0, dt) : deposit_shape<2, false>(tile, s, first, len, r0, dt);
+    break;
+  default:
+    atomic ? deposit_shape<3, true>(tile, s, first, len, r0, dt) : deposit_shape<3, false>(tile, s, first, len, r0, dt);
+    break;
+  }
+}
 
-  // assumes PEC outer boundary
-  for (ui_t i = 1; i < e.x.extent(0) - 1; ++i) {
-    for (ui_t j = 1; j < e.x.extent(1) - 1; ++j) {
-      for (ui_t k = 1; k < e.x.extent(2) - 1; ++k) {
-        e.x[i, j, k] = ea * (eb * e.x[i, j, k] + d_inv.y * (h.z[i, j, k] - h.z[i, j - 1, k]) -
-                             d_inv.z * (h.y[i, j, k] - h.y[i, j, k - 1]));
+template <ui_t O, bool ATOMIC>
+void World::deposit_shape(TileCurrent *tile, const Species &s, const ui_t first, const ui_t len,
+                          const PositionBatch &r0, const fp_t dt) const {
+  const std::array<ui_t, 3> extent = {nv_e.x, nv_e.y, nv_e.z};
+  const std::array<ui_t, 3> period = shape_period();
+
+  // -q / (dt * area normal to each axis), multiplied by the weight of each particle below
+  const std::array<fp_t, 3> q_area = {-s.charge / (dt * d.y * d.z), -s.charge / (dt * d.x * d.z),
+                                      -s.charge / (dt * d.x * d.y)};
+
+  for (ui_t n = 0; n < len; ++n) {
+    const fp_t w = s.p.w[first + n];
+    const std::array<fp_t, 3> v0 = {r0.x[n] * d_inv.x, r0.y[n] * d_inv.y, r0.z[n] * d_inv.z};
+    const std::array<fp_t, 3> v1 = {s.p.x[first + n] * d_inv.x, s.p.y[first + n] * d_inv.y,
+                                    s.p.z[first + n] * d_inv.z};
+    const std::array<fp_t, 3> coef = {w * q_area[0], w * q_area[1], w * q_area[2]};
+
+    if (tile == nullptr) {
+      deposit_esirkepov<O, ATOMIC>(current, extent, period, v0, v1, coef);
+    } else if (!deposit_tile<O>(*tile, v0, v1, coef)) {
+      deposit_esirkepov<O, true>(current, extent, period, v0, v1, coef);
+    }
+  }
+}
+
+void World::zero_current(const Vector3<fp_t> &v) const {
+  const ui_t n = nv_e.x * nv_e.y * nv_e.z;
+
+#pragma omp parallel for schedule(static)
+  for (ui_t idx = 0; idx < n; ++idx) {
+    v.x_data[idx] = 0.0;
+    v.y_data[idx] = 0.0;
+    v.z_data[idx] = 0.0;
+  }
+}
+
+std::array<ui_t, 3> World::shape_period() const noexcept {
+  // species are rejected with bloch boundaries so only periodic axes wrap
+  std::array<ui_t, 3> period = {nv_h.x, nv_h.y, nv_h.z};
+  for (ui_t a = 0; a < 3; ++a) {
+    if (cfg.boundary[2 * a] != Boundary::PERIODIC) {
+      period[a] = 0;
+    }
+  }
+  return period;
+}
+
+void World::gather(const Particles &p, const ui_t first, const ui_t len, FieldBatch &f) const {
+  switch (cfg.shape_order) {
+  case 0:
+    gather_shape<0>(p, first, len, f);
+    break;
+  case 1:
+    gather_shape<1>(p, first, len, f);
+    break;
+  case 2:
+    gather_shape<2>(p, first, len, f);
+    break;
+  default:
+    gather_shape<3>(p, first, len, f);
+    break;
+  }
+}
+
+template <ui_t O>
+void World::gather_shape(const Particles &p, const ui_t first, const ui_t len, FieldBatch &f) const {
+  const auto [px, py, pz] = shape_period();
+
+  for (ui_t n = 0; n < len; ++n) {
+    // particle position in units of voxels, components are either nodal or staggered by half a voxel along each axis
+    const fp_t xi = p.x[first + n] * d_inv.x;
+    const fp_t yi = p.y[first + n] * d_inv.y;
+    const fp_t zi = p.z[first + n] * d_inv.z;
+
+    const auto ex_n = stencil<O>(xi, nv_e.x, px), ex_s = stencil<O>(xi - ONE_OVER_TWO, nv_e.x, px);
+    const auto ey_n = stencil<O>(yi, nv_e.y, py), ey_s = stencil<O>(yi - ONE_OVER_TWO, nv_e.y, py);
+    const auto ez_n = stencil<O>(zi, nv_e.z, pz), ez_s = stencil<O>(zi - ONE_OVER_TWO, nv_e.z, pz);
+    const auto hx_n = stencil<O>(xi, nv_h.x, px), hx_s = stencil<O>(xi - ONE_OVER_TWO, nv_h.x, px);
+    const auto hy_n = stencil<O>(yi, nv_h.y, py), hy_s = stencil<O>(yi - ONE_OVER_TWO, nv_h.y, py);
+    const auto hz_n = stencil<O>(zi, nv_h.z, pz), hz_s = stencil<O>(zi - ONE_OVER_TWO, nv_h.z, pz);
+
+    f.ex[n] = interpolate<O>(e.x, ex_s, ey_n, ez_n);
+    f.ey[n] = interpolate<O>(e.y, ex_n, ey_s, ez_n);
+    f.ez[n] = interpolate<O>(e.z, ex_n, ey_n, ez_s);
+    f.bx[n] = mu * interpolate<O>(h.x, hx_n, hy_s, hz_s);
+    f.by[n] = mu * interpolate<O>(h.y, hx_s, hy_n, hz_s);
+    f.bz[n] = mu * interpolate<O>(h.z, hx_s, hy_s, hz_n);
+  }
+}
+
+void World::apply_particle_boundaries(Species &s) {
+  SPDLOG_TRACE("enter World::apply_particle_boundaries");
+
+  Particles &p = s.p;
+
+  const ui_t num = p.num;
+  const std::array<fp_t *, 3> pos = {p.x, p.y, p.z};
+  const std::array<fp_t *, 3> mom = {p.ux, p.uy, p.uz};
+  const std::array<fp_t, 3> len = {cfg.len.x, cfg.len.y, cfg.len.z};
+
+  sort_keys.resize(num);
+
+  bool moved = false;
+
+  // wrapping axes fold particles back into the bounding box, PMC faces mirror them like the fields they bound and
+  // every other face absorbs them
+#pragma omp parallel for schedule(static) reduction(|| : moved)
+  for (ui_t n = 0; n < num; ++n) {
+    bool absorbed = false;
+    for (ui_t a = 0; a < 3; ++a) {
+      fp_t &r = pos[a][n];
+      if (r >= static_cast<fp_t>(0.0) && r < len[a]) {
+        continue;
+      }
+      moved = true;
+      const Boundary face = cfg.boundary[r < static_cast<fp_t>(0.0) ? 2 * a : 2 * a + 1];
+      if (face == Boundary::PERIODIC || face == Boundary::BLOCH) {
+        r -= len[a] * std::floor(r / len[a]);
+      } else if (face == Boundary::PMC) {
+        // a particle exactly on the far face would stay on it so it is nudged just inside
+        r = r < static_cast<fp_t>(0.0)
+                ? -r
+                : std::min(static_cast<fp_t>(2.0) * len[a] - r, std::nextafter(len[a], static_cast<fp_t>(0.0)));
+        mom[a][n] = -mom[a][n];
+      } else {
+        absorbed = true;
       }
     }
+    sort_keys[n] = absorbed;
   }
 
-  SPDLOG_TRACE("exit World::update_ex");
+  compact_particles(p);
+
+  if (moved) {
+    s.sorted = false;
+    s.ordered = false;
+  }
+
+  SPDLOG_TRACE("exit World::apply_particle_boundaries");
 }
 
-void World::update_ey(const fp_t ea, const fp_t eb) const {
-  SPDLOG_TRACE("enter World::update_ey");
+void World::compact_particles(Particles &p) {
+  SPDLOG_TRACE("enter World::compact_particles");
 
-  // assumes PEC outer boundary
-  for (ui_t i = 1; i < e.y.extent(0) - 1; ++i) {
-    for (ui_t j = 1; j < e.y.extent(1) - 1; ++j) {
-      for (ui_t k = 1; k < e.y.extent(2) - 1; ++k) {
-        e.y[i, j, k] = ea * (eb * e.y[i, j, k] + d_inv.z * (h.x[i, j, k] - h.x[i, j, k - 1]) -
-                             d_inv.x * (h.z[i, j, k] - h.z[i - 1, j, k]));
+  const ui_t num = p.num;
+  const auto num_threads = static_cast<ui_t>(omp_get_max_threads());
+
+  sort_dest.resize(num);
+  sort_counts.assign(num_threads + 1, 0);
+
+  ui_t kept = num;
+
+#pragma omp parallel num_threads(num_threads)
+  {
+    const auto tid = static_cast<ui_t>(omp_get_thread_num());
+    const auto team = static_cast<ui_t>(omp_get_num_threads());
+    const ui_t lo = num * tid / team;
+    const ui_t hi = num * (tid + 1) / team;
+
+    ui_t count = 0;
+    for (ui_t n = lo; n < hi; ++n) {
+      count += sort_keys[n] == 0;
+    }
+    sort_counts[tid + 1] = count;
+
+#pragma omp barrier
+#pragma omp single
+    {
+      // inclusive scan over threads so thread t keeps its particles from sort_counts[t]
+      for (ui_t th = 0; th < team; ++th) {
+        sort_counts[th + 1] += sort_counts[th];
       }
+      kept = sort_counts[team];
+    }
+
+    // survivors are compacted stably to the front and removed particles move behind them
+    ui_t front = sort_counts[tid];
+    ui_t back = sort_counts[team] + lo - sort_counts[tid];
+    for (ui_t n = lo; n < hi; ++n) {
+      sort_dest[n] = sort_keys[n] != 0 ? back++ : front++;
     }
   }
 
-  SPDLOG_TRACE("exit World::update_ey");
+  if (kept < num) {
+    p.permute(sort_dest.data());
+    p.num = kept;
+  }
+
+  SPDLOG_TRACE("exit World::compact_particles");
 }
 
-void World::update_ez(const fp_t ea, const fp_t eb) const {
-  SPDLOG_TRACE("enter World::update_ez");
+void World::swap_imaginary() noexcept {
+  std::swap(e, e_im);
+  std::swap(h, h_im);
+}
+
+void World::update_e_te(const fp_t ea, const fp_t eb) const {
+  SPDLOG_TRACE("enter World::update_e_te");
 
   // assumes PEC outer boundary
-  for (ui_t i = 1; i < e.z.extent(0) - 1; ++i) {
-    for (ui_t j = 1; j < e.z.extent(1) - 1; ++j) {
-      for (ui_t k = 1; k < e.z.extent(2) - 1; ++k) {
-        e.z[i, j, k] = ea * (eb * e.z[i, j, k] + d_inv.x * (h.y[i, j, k] - h.y[i - 1, j, k]) -
-                             d_inv.y * (h.x[i, j, k] - h.x[i, j - 1, k]));
-      }
+  for (ui_t i = 1; i < ex_2d.v.extent(0) - 1; ++i) {
+    for (ui_t j = 1; j < ex_2d.v.extent(1) - 1; ++j) {
+      ex_2d.v[i, j] = ea * (eb * ex_2d.v[i, j] + d_inv.y * (hz_2d.v[i, j] - hz_2d.v[i, j - 1]));
     }
   }
 
-  SPDLOG_TRACE("exit World::update_ez");
+  // assumes PEC outer boundary
+  for (ui_t i = 1; i < ey_2d.v.extent(0) - 1; ++i) {
+    for (ui_t j = 1; j < ey_2d.v.extent(1) - 1; ++j) {
+      ey_2d.v[i, j] = ea * (eb * ey_2d.v[i, j] - d_inv.x * (hz_2d.v[i, j] - hz_2d.v[i - 1, j]));
+    }
+  }
+
+  SPDLOG_TRACE("exit World::update_e_te");
 }
 
-void World::update_hx(const fp_t hya, const fp_t hza) const {
-  SPDLOG_TRACE("enter World::update_hx");
+void World::update_h_te(const fp_t hxa, const fp_t hya) const {
+  SPDLOG_TRACE("enter World::update_h_te");
 
-  for (ui_t i = 0; i < h.x.extent(0); ++i) {
-    for (ui_t j = 0; j < h.x.extent(1); ++j) {
-      for (ui_t k = 0; k < h.x.extent(2); ++k) {
-        h.x[i, j, k] += -hya * (e.z[i, j + 1, k] - e.z[i, j, k]) + hza * (e.y[i, j, k + 1] - e.y[i, j, k]);
-      }
+  for (ui_t i = 0; i < hz_2d.v.extent(0); ++i) {
+    for (ui_t j = 0; j < hz_2d.v.extent(1); ++j) {
+      hz_2d.v[i, j] += -hxa * (ey_2d.v[i + 1, j] - ey_2d.v[i, j]) + hya * (ex_2d.v[i, j + 1] - ex_2d.v[i, j]);
     }
   }
 
-  SPDLOG_TRACE("exit World::update_hx");
+  SPDLOG_TRACE("exit World::update_h_te");
 }
 
-void World::update_hy(const fp_t hxa, const fp_t hza) const {
-  SPDLOG_TRACE("enter World::update_hy");
+void World::update_e_tm(const fp_t ea, const fp_t eb) const {
+  SPDLOG_TRACE("enter World::update_e_tm");
 
-  for (ui_t i = 0; i < h.y.extent(0); ++i) {
-    for (ui_t j = 0; j < h.y.extent(1); ++j) {
-      for (ui_t k = 0; k < h.y.extent(2); ++k) {
-        h.y[i, j, k] += -hza * (e.x[i, j, k + 1] - e.x[i, j, k]) + hxa * (e.z[i + 1, j, k] - e.z[i, j, k]);
-      }
+  // assumes PEC outer boundary
+  for (ui_t i = 1; i < ez_2d.v.extent(0) - 1; ++i) {
+    for (ui_t j = 1; j < ez_2d.v.extent(1) - 1; ++j) {
+      ez_2d.v[i, j] = ea * (eb * ez_2d.v[i, j] + d_inv.x * (hy_2d.v[i, j] - hy_2d.v[i - 1, j]) -
+                            d_inv.y * (hx_2d.v[i, j] - hx_2d.v[i, j - 1]));
     }
   }
 
-  SPDLOG_TRACE("exit World::update_hy");
+  SPDLOG_TRACE("exit World::update_e_tm");
 }
 
-void World::update_hz(const fp_t hxa, const fp_t hya) const {
-  SPDLOG_TRACE("enter World::update_hz");
+void World::update_h_tm(const fp_t hxa, const fp_t hya) const {
+  SPDLOG_TRACE("enter World::update_h_tm");
 
-  for (ui_t i = 0; i < h.z.extent(0); ++i) {
-    for (ui_t j = 0; j < h.z.extent(1); ++j) {
-      for (ui_t k = 0; k < h.z.extent(2); ++k) {
-        h.z[i, j, k] += -hxa * (e.y[i + 1, j, k] - e.y[i, j, k]) + hya * (e.x[i, j + 1, k] - e.x[i, j, k]);
+  for (ui_t i = 0; i < hx_2d.v.extent(0); ++i) {
+    for (ui_t j = 0; j < hx_2d.v.extent(1); ++j) {
+      hx_2d.v[i, j] += -hya * (ez_2d.v[i, j + 1] - ez_2d.v[i, j]);
+    }
+  }
+
+  for (ui_t i = 0; i < hy_2d.v.extent(0); ++i) {
+    for (ui_t j = 0; j < hy_2d.v.extent(1); ++j) {
+      hy_2d.v[i, j] += hxa * (ez_2d.v[i + 1, j] - ez_2d.v[i, j]);
+    }
+  }
+
+  SPDLOG_TRACE("exit World::update_h_tm");
+}
+
+void World::update_e_1d(const fp_t ea, const fp_t eb) const {
+  SPDLOG_TRACE("enter World::update_e_1d");
+
+  // assumes PEC outer boundary
+  for (ui_t i = 1; i < ez_1d.v.extent(0) - 1; ++i) {
+    ez_1d.v[i] = ea * (eb * ez_1d.v[i] + d_inv.x * (hy_1d.v[i] - hy_1d.v[i - 1]));
+  }
+
+  SPDLOG_TRACE("exit World::update_e_1d");
+}
+
+void World::update_h_1d(const fp_t hxa) const {
+  SPDLOG_TRACE("enter World::update_h_1d");
+
+  for (ui_t i = 0; i < hy_1d.v.extent(0); ++i) {
+    hy_1d.v[i] += hxa * (ez_1d.v[i + 1] - ez_1d.v[i]);
+  }
+
+  SPDLOG_TRACE("exit World::update_h_1d");
+}
+
+ui_t World::rank() const noexcept {
+  switch (cfg.mode) {
+  case Mode::D3:
+    return 3;
+  case Mode::D2_TE:
+  case Mode::D2_TM:
+  case Mode::RZ:
+    return 2;
+  case Mode::D1:
+    return 1;
+  }
+  return 3;
+}
+
+ui_t World::num_field_points() const noexcept {
+  switch (cfg.mode) {
+  case Mode::D3:
+    return 3 * (e.x.size() + h.x.size()) + ensemble.num_field_points();
+  case Mode::D2_TE:
+    return ex_2d.v.size() + ey_2d.v.size() + hz_2d.v.size();
+  case Mode::D2_TM:
+    return ez_2d.v.size() + hx_2d.v.size() + hy_2d.v.size();
+  case Mode::D1:
+    return ez_1d.v.size() + hy_1d.v.size();
+  case Mode::RZ:
+    return cyl.num_field_points();
+  }
+  return 0;
+}
+
+std::array<const fp_t *, 6> World::field_data() const noexcept {
+  switch (cfg.mode) {
+  case Mode::D3:
+    return {e.x.data_handle(), e.y.data_handle(), e.z.data_handle(),
+            h.x.data_handle(), h.y.data_handle(), h.z.data_handle()};
+  case Mode::D2_TE:
+    return {ex_2d.data, ey_2d.data, nullptr, nullptr, nullptr, hz_2d.data};
+  case Mode::D2_TM:
+    return {nullptr, nullptr, ez_2d.data, hx_2d.data, hy_2d.data, nullptr};
+  case Mode::D1:
+    return {nullptr, nullptr, ez_1d.data, nullptr, hy_1d.data, nullptr};
+  case Mode::RZ:
+    // cylindrical fields are complex valued per azimuthal mode and logged by Cylindrical
+    return {};
+  }
+  return {};
+}
+
+fp_t World::field_energy() const {
+  SPDLOG_TRACE("enter World::field_energy");
+
+  const auto data = field_data();
+  const ui_t points_e = nv_e.x * nv_e.y * nv_e.z;
+  const ui_t points_h = nv_h.x * nv_h.y * nv_h.z;
+
+  // accumulated in double so late-time energies are not lost against the sum in single precision builds
+  double sum_e = 0.0;
+  double sum_h = 0.0;
+  for (ui_t c = 0; c < 6; ++c) {
+    if (data[c] == nullptr) {
+      continue;
+    }
+
+    const fp_t *f = data[c];
+    const ui_t n = c < 3 ? points_e : points_h;
+    double sum = 0.0;
+#pragma omp parallel for simd reduction(+ : sum)
+    for (ui_t i = 0; i < n; ++i) {
+      sum += static_cast<double>(f[i]) * f[i];
+    }
+    (c < 3 ? sum_e : sum_h) += sum;
+  }
+
+  const double dv = static_cast<double>(d.x) * d.y * d.z;
+  const double energy = 0.5 * dv * (ep * sum_e + mu * sum_h);
+
+  // cylindrical modes are not exposed through field_data
+  const fp_t energy_rz = cfg.mode == Mode::RZ ? cyl.field_energy(ep, mu) : static_cast<fp_t>(0.0);
+
+  SPDLOG_TRACE("exit World::field_energy");
+  return static_cast<fp_t>(energy) + energy_rz + ensemble.field_energy();
+}
+
+void World::truncate_logs(const ui_t num) const {
+  SPDLOG_TRACE("enter World::truncate_logs");
+
+  const HDF5Obj *sets[8] = {&datasets.time, &datasets.step, &datasets.ex, &datasets.ey,
+                            &datasets.ez,   &datasets.hx,   &datasets.hy, &datasets.hz};
+  for (const auto *set : sets) {
+    if (set->get() >= 0) {
+      truncate_rows(*set, num);
+    }
+  }
+  for (const auto &set : ensemble.sets) {
+    if (set.get() >= 0) {
+      truncate_rows(set, num);
+    }
+  }
+  for (const auto &set : cyl.sets) {
+    if (set.get() >= 0) {
+      truncate_rows(set, num);
+    }
+  }
+
+  // particle datasets grow by one row per logging event and only shrink if rows were appended past the last event
+  for (const auto &ps : particle_sets) {
+    const HDF5Obj *rows[5] = {&ps.step, &ps.count, &ps.samples, &ps.phase, &ps.spectrum};
+    for (const auto *set : rows) {
+      if (set->get() >= 0) {
+        truncate_rows(*set, num);
       }
     }
   }
 
-  SPDLOG_TRACE("exit World::update_hz");
+  const auto number_logs = HDF5Obj(H5Dopen(h5.get(), "metadata/logged_steps", H5P_DEFAULT), H5Dclose);
+  const ui_t num_logs[1] = {num};
+  H5Dwrite(number_logs.get(), H5T_NATIVE_UINT64, H5S_ALL, H5S_ALL, H5P_DEFAULT, num_logs);
+
+  SPDLOG_TRACE("exit World::truncate_logs");
 }
 
-void World::log(const ui_t hyperslab, const ui_t step) const {
+std::expected<void, std::string> World::log(const ui_t hyperslab, const ui_t step) const {
   SPDLOG_TRACE("enter World::log");
 
+  // field datasets have one leading time dimension followed by the spatial dimensions of the configured mode
+  const auto field_rank = static_cast<int>(rank() + 1);
+
   constexpr hsize_t scalar_count[1] = {1};
   const hsize_t e_count[4] = {1, static_cast<hsize_t>(nv_e.x), static_cast<hsize_t>(nv_e.y),
                               static_cast<hsize_t>(nv_e.z)};
@@ -410,8 +3011,8 @@ void World::log(const ui_t hyperslab, const ui_t step) const {
   H5Sselect_hyperslab(dataspaces.h.get(), H5S_SELECT_SET, field_offset, nullptr, h_count, nullptr);
 
   const auto scalar_memspace = HDF5Obj(H5Screate_simple(1, scalar_count, nullptr), H5Sclose);
-  const auto e_memspace = HDF5Obj(H5Screate_simple(4, e_count, nullptr), H5Sclose);
-  const auto h_memspace = HDF5Obj(H5Screate_simple(4, h_count, nullptr), H5Sclose);
+  const auto e_memspace = HDF5Obj(H5Screate_simple(field_rank, e_count, nullptr), H5Sclose);
+  const auto h_memspace = HDF5Obj(H5Screate_simple(field_rank, h_count, nullptr), H5Sclose);
 
   const fp_t time_arr[1] = {time};
   const ui_t step_arr[1] = {step};
@@ -419,14 +3020,33 @@ void World::log(const ui_t hyperslab, const ui_t step) const {
   H5Dwrite(datasets.time.get(), h5_fp_t<fp_t>(), scalar_memspace.get(), dataspaces.scalar.get(), H5P_DEFAULT, time_arr);
   H5Dwrite(datasets.step.get(), H5T_NATIVE_UINT64, scalar_memspace.get(), dataspaces.scalar.get(), H5P_DEFAULT,
            step_arr);
-  H5Dwrite(datasets.ex.get(), h5_fp_t<fp_t>(), e_memspace.get(), dataspaces.e.get(), H5P_DEFAULT, e.x.data_handle());
-  H5Dwrite(datasets.ey.get(), h5_fp_t<fp_t>(), e_memspace.get(), dataspaces.e.get(), H5P_DEFAULT, e.y.data_handle());
-  H5Dwrite(datasets.ez.get(), h5_fp_t<fp_t>(), e_memspace.get(), dataspaces.e.get(), H5P_DEFAULT, e.z.data_handle());
-  H5Dwrite(datasets.hx.get(), h5_fp_t<fp_t>(), h_memspace.get(), dataspaces.h.get(), H5P_DEFAULT, h.x.data_handle());
-  H5Dwrite(datasets.hy.get(), h5_fp_t<fp_t>(), h_memspace.get(), dataspaces.h.get(), H5P_DEFAULT, h.y.data_handle());
-  H5Dwrite(datasets.hz.get(), h5_fp_t<fp_t>(), h_memspace.get(), dataspaces.h.get(), H5P_DEFAULT, h.z.data_handle());
+
+  const auto data = field_data();
+  const HDF5Obj *field_sets[6] = {&datasets.ex, &datasets.ey, &datasets.ez, &datasets.hx, &datasets.hy, &datasets.hz};
+
+  // only components allocated by the configured mode are written
+  for (ui_t c = 0; c < 6; ++c) {
+    if (data[c] == nullptr) {
+      continue;
+    }
+
+    const auto &memspace = c < 3 ? e_memspace : h_memspace;
+    const auto &dataspace = c < 3 ? dataspaces.e : dataspaces.h;
+    H5Dwrite(field_sets[c]->get(), h5_fp_t<fp_t>(), memspace.get(), dataspace.get(), H5P_DEFAULT, data[c]);
+  }
+
+  if (cfg.mode == Mode::RZ) {
+    cyl.log(hyperslab);
+  }
+
+  if (ensemble.num_members > 0) {
+    if (const auto result = ensemble.log(hyperslab); !result.has_value()) {
+      return std::unexpected(result.error());
+    }
+  }
 
   SPDLOG_TRACE("exit World::log");
+  return {};
 }
 
 void World::log_metadata(const HDF5Obj &group, const double dt, const ui_t num) const {
@@ -459,7 +3079,8 @@ void World::log_metadata(const HDF5Obj &group, const double dt, const ui_t num)
   SPDLOG_TRACE("exit World::log_metadata");
 }
 
-std::expected<std::filesystem::path, std::string> World::init_filesystem(const std::string &id) const noexcept {
+std::expected<std::filesystem::path, std::string> World::init_filesystem(const std::filesystem::path &out,
+                                                                         const std::string &id) noexcept {
   SPDLOG_TRACE("enter World::init_filesystem");
 
   std::filesystem::path io_dir;
@@ -494,6 +3115,9 @@ std::expected<std::filesystem::path, std::string> World::init_filesystem(const s
 void World::setup_dataspaces(const ui_t num) {
   SPDLOG_TRACE("enter World::setup_dataspaces");
 
+  // field datasets have one leading time dimension followed by the spatial dimensions of the configured mode
+  const auto field_rank = static_cast<int>(rank() + 1);
+
   const hsize_t dims_scalar[1] = {num};
   const hsize_t dims_e[4] = {static_cast<hsize_t>(num), static_cast<hsize_t>(nv_e.x), static_cast<hsize_t>(nv_e.y),
                              static_cast<hsize_t>(nv_e.z)};
@@ -505,39 +3129,236 @@ void World::setup_dataspaces(const ui_t num) {
   };
 
   dataspaces.scalar = HDF5Obj(H5Screate_simple(1, dims_scalar, nullptr), H5Sclose);
-  dataspaces.e = HDF5Obj(H5Screate_simple(4, dims_e, nullptr), H5Sclose);
-  dataspaces.h = HDF5Obj(H5Screate_simple(4, dims_h, nullptr), H5Sclose);
+  dataspaces.e = HDF5Obj(H5Screate_simple(field_rank, dims_e, nullptr), H5Sclose);
+  dataspaces.h = HDF5Obj(H5Screate_simple(field_rank, dims_h, nullptr), H5Sclose);
 
   SPDLOG_TRACE("exit World::setup_dataspaces");
 }
 
-void World::setup_datasets(const HDF5Obj &group) {
+std::expected<void, std::string> World::setup_datasets(const HDF5Obj &group) {
   SPDLOG_TRACE("enter World::setup_datasets");
 
-  datasets.time = HDF5Obj(
-      H5Dcreate(group.get(), "time", h5_fp_t<fp_t>(), dataspaces.scalar.get(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT),
-      H5Dclose);
-  datasets.step = HDF5Obj(
-      H5Dcreate(group.get(), "step", H5T_NATIVE_UINT64, dataspaces.scalar.get(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT),
-      H5Dclose);
-  datasets.ex =
-      HDF5Obj(H5Dcreate(group.get(), "ex", h5_fp_t<fp_t>(), dataspaces.e.get(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT),
-              H5Dclose);
-  datasets.ey =
-      HDF5Obj(H5Dcreate(group.get(), "ey", h5_fp_t<fp_t>(), dataspaces.e.get(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT),
-              H5Dclose);
-  datasets.ez =
-      HDF5Obj(H5Dcreate(group.get(), "ez", h5_fp_t<fp_t>(), dataspaces.e.get(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT),
-              H5Dclose);
-  datasets.hx =
-      HDF5Obj(H5Dcreate(group.get(), "hx", h5_fp_t<fp_t>(), dataspaces.h.get(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT),
-              H5Dclose);
-  datasets.hy =
-      HDF5Obj(H5Dcreate(group.get(), "hy", h5_fp_t<fp_t>(), dataspaces.h.get(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT),
-              H5Dclose);
-  datasets.hz =
-      HDF5Obj(H5Dcreate(group.get(), "hz", h5_fp_t<fp_t>(), dataspaces.h.get(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT),
-              H5Dclose);
+  // runs that may stop early chunk their datasets by logged step so unused steps can be cut off
+  const bool shrinkable = cfg.converge_period > 0;
+  const auto scalar_props = row_props(dataspaces.scalar, shrinkable);
+  const auto e_props = row_props(dataspaces.e, shrinkable);
+  const auto h_props = row_props(dataspaces.h, shrinkable);
+
+  datasets.time = HDF5Obj(H5Dcreate(group.get(), "time", h5_fp_t<fp_t>(), dataspaces.scalar.get(), H5P_DEFAULT,
+                                    scalar_props.get(), H5P_DEFAULT),
+                          H5Dclose);
+  datasets.step = HDF5Obj(H5Dcreate(group.get(), "step", H5T_NATIVE_UINT64, dataspaces.scalar.get(), H5P_DEFAULT,
+                                    scalar_props.get(), H5P_DEFAULT),
+                          H5Dclose);
+
+  const auto data = field_data();
+  constexpr const char *names[6] = {"ex", "ey", "ez", "hx", "hy", "hz"};
+  HDF5Obj *field_sets[6] = {&datasets.ex, &datasets.ey, &datasets.ez, &datasets.hx, &datasets.hy, &datasets.hz};
+
+  // only components allocated by the configured mode get a dataset
+  for (ui_t c = 0; c < 6; ++c) {
+    if (data[c] == nullptr) {
+      continue;
+    }
+
+    const auto &dataspace = c < 3 ? dataspaces.e : dataspaces.h;
+    const auto &props = c < 3 ? e_props : h_props;
+    *field_sets[c] = HDF5Obj(
+        H5Dcreate(group.get(), names[c], h5_fp_t<fp_t>(), dataspace.get(), H5P_DEFAULT, props.get(), H5P_DEFAULT),
+        H5Dclose);
+  }
+
+  if (cfg.mode == Mode::RZ) {
+    cyl.setup_datasets(group, static_cast<ui_t>(H5Sget_simple_extent_npoints(dataspaces.scalar.get())), shrinkable);
+  }
+
+  if (ensemble.num_members > 0) {
+    if (const auto result = ensemble.setup_datasets(
+            group, static_cast<ui_t>(H5Sget_simple_extent_npoints(dataspaces.scalar.get())), shrinkable);
+        !result.has_value()) {
+      return std::unexpected(result.error());
+    }
+  }
 
   SPDLOG_TRACE("exit World::setup_datasets");
+  return {};
+}
+
+std::expected<void, std::string> World::shift_window() {
+  SPDLOG_TRACE("enter World::shift_window");
+
+  e.shift(static_cast<fp_t>(0.0));
+  h.shift(static_cast<fp_t>(0.0));
+  if (e_im.x_data != nullptr) {
+    e_im.shift(static_cast<fp_t>(0.0));
+    h_im.shift(static_cast<fp_t>(0.0));
+  }
+
+  // magnetic walls on y_hi and z_hi are indexed by x and are small enough to copy
+  for (const auto *wall : {&hy_hi, &hz_hi}) {
+    if (wall->data == nullptr) {
+      continue;
+    }
+    const ui_t row = wall->v.extent(1);
+    const ui_t n = wall->v.extent(0) * row;
+    std::memmove(wall->data, wall->data + row, sizeof(fp_t) * (n - row));
+    std::fill(wall->data + n - row, wall->data + n, static_cast<fp_t>(0.0));
+  }
+
+  // particles keep their position relative to the window, those falling behind it are absorbed and fresh plasma is
+  // loaded into the exposed leading plane with a generator seeded by the shift so runs remain reproducible
+  ++window_shifts;
+  std::mt19937_64 gen(window_shifts);
+  for (ui_t si = 0; si < species.size(); ++si) {
+    auto &s = species[si];
+#pragma omp parallel for schedule(static)
+    for (ui_t n = 0; n < s.p.num; ++n) {
+      s.p.x[n] -= d.x;
+    }
+    apply_particle_boundaries(s);
+
+    if (const auto result = load_plasma(s, cfg.species[si], nv_h.x - 1, gen); !result.has_value()) {
+      SPDLOG_CRITICAL(result.error());
+      return std::unexpected(result.error());
+    }
+  }
+
+  // active tiles were found for the unshifted fields and particles
+  if (cfg.activity_period > 0) {
+    update_activity();
+  }
+
+  SPDLOG_TRACE("exit World::shift_window");
+  return {};
+}
+
+void World::setup_particle_datasets(const HDF5Obj &group) {
+  SPDLOG_TRACE("enter World::setup_particle_datasets");
+
+  particle_sets.clear();
+  if (species.empty()) {
+    SPDLOG_TRACE("exit World::setup_particle_datasets");
+    return;
+  }
+
+  const auto particle_group =
+      HDF5Obj(H5Gcreate(group.get(), "particles", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), H5Gclose);
+
+  for (const auto &s : species) {
+    ParticleDatasets sets;
+    sets.group =
+        HDF5Obj(H5Gcreate(particle_group.get(), s.name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), H5Gclose);
+    sets.step = create_extendible(sets.group, "step", H5T_NATIVE_UINT64, {});
+    if (cfg.sampling != Sampling::NONE) {
+      sets.count = create_extendible(sets.group, "count", H5T_NATIVE_UINT64, {});
+      sets.samples =
+          create_extendible(sets.group, "samples", h5_fp_t<fp_t>(), {cfg.max_samples, Particles::NUM_COLUMNS});
+    }
+    sets.phase = create_extendible(sets.group, "x_ux", h5_fp_t<fp_t>(), {cfg.bins, cfg.bins});
+    sets.spectrum = create_extendible(sets.group, "energy", h5_fp_t<fp_t>(), {cfg.bins});
+    particle_sets.push_back(std::move(sets));
+  }
+
+  SPDLOG_TRACE("exit World::setup_particle_datasets");
+}
+
+void World::log_particles(const ui_t step) const {
+  SPDLOG_TRACE("enter World::log_particles");
+
+  const ui_t bins = cfg.bins;
+  const fp_t x_scale = static_cast<fp_t>(bins) / cfg.len.x;
+  const fp_t u_scale = static_cast<fp_t>(bins) / (static_cast<fp_t>(2.0) * cfg.u_max);
+  const fp_t e_scale = static_cast<fp_t>(bins) / (cfg.energy_max * ELEC_CHARGE);
+
+  for (ui_t si = 0; si < species.size(); ++si) {
+    const auto &s = species[si];
+    const auto &p = s.p;
+    const auto &sets = particle_sets[si];
+
+    const uint64_t step_arr[1] = {step};
+    append_row(sets.step, H5T_NATIVE_UINT64, step_arr);
+
+    if (cfg.sampling != Sampling::NONE) {
+      // rows hold max_samples particles so the stored size per event does not depend on the particle count, unused
+      // slots are zero and count holds the number of valid samples
+      std::vector<fp_t> row(cfg.max_samples * Particles::NUM_COLUMNS, static_cast<fp_t>(0.0));
+      const auto cols = p.columns();
+      ui_t count = 0;
+
+      const auto keep = [&](const ui_t n, const ui_t slot) {
+        for (ui_t c = 0; c < Particles::NUM_COLUMNS; ++c) {
+          row[slot * Particles::NUM_COLUMNS + c] = cols[c][n];
+        }
+      };
+
+      if (cfg.sampling == Sampling::STRIDE) {
+        const ui_t stride = std::max((p.num + cfg.max_samples - 1) / cfg.max_samples, static_cast<ui_t>(1));
+        for (ui_t n = 0; n < p.num && count < cfg.max_samples; n += stride) {
+          keep(n, count++);
+        }
+      } else {
+        // reservoir sampling keeps every particle with probability max_samples / num whatever its index, particle n
+        // replaces a random slot with probability max_samples / (n + 1) using draws addressed by step and particle
+        const Philox rng{{static_cast<uint32_t>(si), 0x5a3b1e}};
+        for (ui_t n = 0; n < p.num; ++n) {
+          if (n < cfg.max_samples) {
+            keep(n, count++);
+            continue;
+          }
+
+          const auto r =
+              rng.uniform({static_cast<uint32_t>(n), static_cast<uint32_t>(static_cast<uint64_t>(n) >> 32),
+                           static_cast<uint32_t>(step), static_cast<uint32_t>(static_cast<uint64_t>(step) >> 32)});
+          const auto slot = std::min(static_cast<ui_t>(r[0] * static_cast<fp_t>(n + 1)), n);
+          if (slot < cfg.max_samples) {
+            keep(n, slot);
+          }
+        }
+      }
+
+      const uint64_t count_arr[1] = {count};
+      append_row(sets.count, H5T_NATIVE_UINT64, count_arr);
+      append_row(sets.samples, h5_fp_t<fp_t>(), row.data());
+    }
+
+    // weighted histograms accumulate into thread-private copies that are summed once per thread, particles outside
+    // of the histogram bounds are left out
+    std::vector<fp_t> phase(bins * bins, static_cast<fp_t>(0.0));
+    std::vector<fp_t> spectrum(bins, static_cast<fp_t>(0.0));
+
+#pragma omp parallel
+    {
+      std::vector<fp_t> phase_private(bins * bins, static_cast<fp_t>(0.0));
+      std::vector<fp_t> spectrum_private(bins, static_cast<fp_t>(0.0));
+
+#pragma omp for schedule(static)
+      for (ui_t n = 0; n < p.num; ++n) {
+        const fp_t bx = p.x[n] * x_scale;
+        const fp_t bu = (p.ux[n] + cfg.u_max) * u_scale;
+        if (bx >= 0.0 && bx < static_cast<fp_t>(bins) && bu >= 0.0 && bu < static_cast<fp_t>(bins)) {
+          phase_private[static_cast<ui_t>(bx) * bins + static_cast<ui_t>(bu)] += p.w[n];
+        }
+
+        const fp_t be = kinetic_energy(p.ux[n], p.uy[n], p.uz[n], s.mass) * e_scale;
+        if (be < static_cast<fp_t>(bins)) {
+          spectrum_private[static_cast<ui_t>(be)] += p.w[n];
+        }
+      }
+
+#pragma omp critical
+      {
+        for (ui_t b = 0; b < bins * bins; ++b) {
+          phase[b] += phase_private[b];
+        }
+        for (ui_t b = 0; b < bins; ++b) {
+          spectrum[b] += spectrum_private[b];
+        }
+      }
+    }
+
+    append_row(sets.phase, h5_fp_t<fp_t>(), phase.data());
+    append_row(sets.spectrum, h5_fp_t<fp_t>(), spectrum.data());
+  }
+
+  SPDLOG_TRACE("exit World::log_particles");
 }
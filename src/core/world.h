@@ -18,16 +18,38 @@
 #ifndef CORE_WORLD_H
 #define CORE_WORLD_H
 
+#include <array>
+#include <complex>
 #include <expected>
+#include <filesystem>
 #include <fmt/chrono.h>
+#include <random>
 #include <spdlog/spdlog.h>
 #include <string>
+#include <vector>
 
+#include "collision.h"
 #include "config.h"
+#include "deposit.h"
+#include "cylindrical.h"
+#include "dispersive.h"
+#include "ensemble.h"
 #include "io.h"
+#include "multigrid.h"
 #include "numeric.h"
+#include "particle.h"
 #include "physical.h"
+#include "pusher.h"
+#include "random.h"
+#include "resample.h"
+#include "scalar.h"
+#include "shape.h"
 #include "vector.h"
+#include "voxelize.h"
+
+#if EPPIC_USE_PSATD
+#include "spectral.h"
+#endif
 
 /*!
  * EPPIC World object
@@ -36,9 +58,12 @@ struct World {
   /// configuration from file
   Config cfg;
 
-  /// output HDF5 file
+  /// output HDF5 file or, for sweep runs, this run's group within the shared sweep file
   HDF5Obj h5;
 
+  /// unique output directory of this run
+  std::filesystem::path io_dir;
+
   /// dataspaces for writable data
   Dataspaces dataspaces;
 
@@ -60,6 +85,14 @@ struct World {
   /// (m) inverse spatial increments in all directions
   Coord3<fp_t> d_inv = {0.0, 0.0, 0.0};
 
+  /// electric field voxel dimensions
+  /// NOTE: invariant axes of reduced dimensionality modes have a single voxel
+  Coord3<ui_t> nv_e = {0, 0, 0};
+
+  /// magnetic field voxel dimensions
+  /// NOTE: invariant axes of reduced dimensionality modes have a single voxel
+  Coord3<ui_t> nv_h = {0, 0, 0};
+
   /// (V/m) electric field vector
   /// NOTE: as configured e wraps h to make it easier to manage boundary conditions
   Vector3<fp_t> e;
@@ -67,6 +100,155 @@ struct World {
   /// (A/m) magnetic field vector
   Vector3<fp_t> h;
 
+  /// (V/m) electric field x-component in 2D TE mode
+  Scalar2<fp_t> ex_2d;
+
+  /// (V/m) electric field y-component in 2D TE mode
+  Scalar2<fp_t> ey_2d;
+
+  /// (V/m) electric field z-component in 2D TM mode
+  Scalar2<fp_t> ez_2d;
+
+  /// (A/m) magnetic field x-component in 2D TM mode
+  Scalar2<fp_t> hx_2d;
+
+  /// (A/m) magnetic field y-component in 2D TM mode
+  Scalar2<fp_t> hy_2d;
+
+  /// (A/m) magnetic field z-component in 2D TE mode
+  Scalar2<fp_t> hz_2d;
+
+  /// (V/m) electric field z-component in 1D mode
+  Scalar1<fp_t> ez_1d;
+
+  /// (A/m) magnetic field y-component in 1D mode
+  Scalar1<fp_t> hy_1d;
+
+  /// (V/m) imaginary part of electric field vector
+  /// NOTE: only allocated with Bloch boundaries where e holds the real part
+  Vector3<fp_t> e_im;
+
+  /// (A/m) imaginary part of magnetic field vector
+  /// NOTE: only allocated with Bloch boundaries where h holds the real part
+  Vector3<fp_t> h_im;
+
+  /// Bloch phase factors exp(i phase) along {x, y, z}, unity for periodic and non-wrapping axes
+  std::array<std::complex<fp_t>, 3> bloch_shift = {1.0, 1.0, 1.0};
+
+  /// (A/m) magnetic field x-component on the x_hi face
+  /// NOTE: only allocated when x_hi is PMC as normal magnetic fields on high faces are otherwise not stored
+  Scalar2<fp_t> hx_hi;
+
+  /// (A/m) magnetic field y-component on the y_hi face
+  Scalar2<fp_t> hy_hi;
+
+  /// (A/m) magnetic field z-component on the z_hi face
+  Scalar2<fp_t> hz_hi;
+
+  /// azimuthal mode fields in RZ mode
+  Cylindrical cyl;
+
+  /// material IDs of every magnetic field voxel where 0 is the bounding box material
+  /// NOTE: only allocated when geometry objects are configured, electric field nodes take the ID of the voxel whose
+  /// lower corner they share and the outer shell keeps the bounding box material
+  Scalar3<uint8_t> material;
+
+  /// electric field a loop constants indexed by material ID
+  std::vector<fp_t> material_ea;
+
+  /// electric field b loop constants indexed by material ID
+  std::vector<fp_t> material_eb;
+
+  /// dispersive material poles
+  Dispersive dispersive;
+
+  /// field-only ensemble members advanced in place of e and h
+  /// NOTE: e and h are left unallocated when members are configured
+  Ensemble ensemble;
+
+  /// particle species
+  std::vector<Species> species;
+
+  /// (A/m^2) current density vector with electric field layout
+  /// NOTE: only allocated when particles are present
+  Vector3<fp_t> current;
+
+  /// (A/m^2) thread-private current density buffers that each cover the tile a thread is pushing and a halo around it
+  /// NOTE: only allocated for the REDUCE deposition strategy
+  std::vector<TileCurrent> current_private;
+
+  /// number of voxels tile-private current density buffers extend past each tile face
+  ui_t current_halo = 0;
+
+  /// number of particle tiles along each axis
+  Coord3<ui_t> nt = {0, 0, 0};
+
+  /// particle sort keys reused across sorts
+  std::vector<ui_t> sort_keys;
+
+  /// particle sort destinations reused across sorts
+  std::vector<ui_t> sort_dest;
+
+  /// inverse of tile level sort destinations reused across sorts
+  std::vector<ui_t> sort_src;
+
+  /// per-thread tile histograms reused across sorts
+  std::vector<ui_t> sort_counts;
+
+  /// number of voxels the moving window has shifted along x
+  ui_t window_shifts = 0;
+
+  /// particle diagnostic datasets of every species
+  std::vector<ParticleDatasets> particle_sets;
+
+  /// multigrid solver for Gauss's law on voxel nodes
+  Multigrid mg;
+
+  /// electron-neutral cross-sections
+  CrossSections xs;
+
+  /// (1/s) upper bound of the total electron-neutral collision frequency
+  fp_t nu_max = 0.0;
+
+  /// number of steps taken which addresses random draws
+  ui_t step_count = 0;
+
+  /// first tile pushed by every thread with one trailing entry holding the number of tiles
+  std::vector<ui_t> thread_tiles;
+
+  /// (s) time every thread spent pushing particles since the last rebalance
+  std::vector<double> thread_time;
+
+  /// (s) time spent pushing the particles of every tile since the last rebalance
+  std::vector<double> tile_cost;
+
+  /// tiles whose fields are updated, i.e. tiles holding particles or field energy above the activity threshold and
+  /// their neighbors
+  /// NOTE: only used when the activity mask is enabled
+  std::vector<ui_t> active_tiles;
+
+  /// field energy of every tile reused across activity updates
+  std::vector<fp_t> tile_energy;
+
+  /// flags of tiles holding particles or field energy above the activity threshold
+  std::vector<uint8_t> tile_live;
+
+  /// dependence objects of the field task graph in {hx, hy, hz} tile order followed by the magnetic boundary
+  /// NOTE: only their addresses are used and only when the task graph is enabled
+  std::vector<uint8_t> task_deps;
+
+  /// number of particle pushes performed
+  ui_t num_pushed = 0;
+
+  /// (s) wall time spent pushing particles
+  double push_time = 0.0;
+
+#if EPPIC_USE_PSATD
+  /// pseudo-spectral field solver
+  /// NOTE: only initialized when the configured engine is PSATD
+  Spectral psatd;
+#endif
+
   /*!
    * initializes World
    * @param input_file_path input file path as std::string
@@ -76,10 +258,74 @@ struct World {
   [[nodiscard]] std::expected<void, std::string> init(const std::string &input_file_path,
                                                       const std::string &id) noexcept;
 
+  /*!
+   * initializes World from an already parsed input deck and writes into an existing HDF5 group
+   * @param config toml configuration
+   * @param group HDF5 group (or file) that receives this run's metadata and data
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   * @note group is only taken over on success and field buffers kept by reset(true) are reused on matching grids
+   */
+  [[nodiscard]] std::expected<void, std::string> init(const toml::basic_value<toml::type_config> &config,
+                                                      HDF5Obj &&group) noexcept;
+
+  /*!
+   * derives the grid from the configuration and initializes every simulation component
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init_state() noexcept;
+
+  /*!
+   * allocates the field components required by the configured mode
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init_fields() noexcept;
+
+  /*!
+   * assigns per-voxel material IDs from a precomputed volume and configured geometry objects
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init_geometry() noexcept;
+
+  /*!
+   * reads precomputed material IDs from the configured HDF5 dataset
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> load_material_ids() noexcept;
+
+  /*!
+   * loads configured particle species uniformly over the bounding box with Maxwellian momenta
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init_particles() noexcept;
+
+  /*!
+   * loads a uniform Maxwellian plasma of a configured species into x-planes of voxels
+   * @param s species to load into
+   * @param sc configuration of species
+   * @param i_lo first x-plane of voxels to load where loading continues to the last plane
+   * @param gen random number generator
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> load_plasma(Species &s, const SpeciesConfig &sc, ui_t i_lo,
+                                                             std::mt19937_64 &gen) noexcept;
+
+  /*!
+   * loads cross-sections of configured electron-neutral collisions
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> init_collisions() noexcept;
+
   /*!
    * resets World to default state
+   * @param keep_fields keeps the 3D electric and magnetic field allocations for reuse by the next init
    */
-  void reset() noexcept;
+  void reset(bool keep_fields = false) noexcept;
+
+  /*!
+   * unique output directory getter
+   * @return unique output directory of this run
+   */
+  [[nodiscard]] const std::filesystem::path &get_output_dir() const noexcept { return io_dir; }
 
   /*!
    * advances internal state to `end_time` parameter as defined in configuration file
@@ -118,6 +364,14 @@ struct World {
    */
   [[nodiscard]] ui_t calc_cfl_steps(fp_t time_span) const;
 
+  /*!
+   * calculates the number of steps required by the PSATD engine to model a given time span
+   * @param time_span (s) time span to be modeled
+   * @return number of steps required to sample the maximum frequency as finely as the grid samples its wavelength
+   * @note PSATD has no Courant limit so the step is set by temporal resolution alone
+   */
+  [[nodiscard]] ui_t calc_spectral_steps(fp_t time_span) const;
+
   /*!
    * advances internal field state by one time step
    * @param dt (s) time step
@@ -140,12 +394,34 @@ struct World {
    */
   void update_h(fp_t hxa, fp_t hya, fp_t hza) const;
 
+  /*!
+   * advances fields as a graph of per tile component tasks that start as soon as the tasks they read from finish
+   * @param ea electric field a loop constant
+   * @param eb electric field b loop constant
+   * @param hxa magnetic field a loop constant for x-component
+   * @param hya magnetic field a loop constant for y-component
+   * @param hza magnetic field a loop constant for z-component
+   * @param do_h whether magnetic fields are advanced
+   * @param do_e whether electric fields are advanced after the magnetic fields
+   * @note only 3d yee fields are supported, outer shells run as one task each behind the tiles they read
+   */
+  void update_graph(fp_t ea, fp_t eb, fp_t hxa, fp_t hya, fp_t hza, bool do_h, bool do_e) const;
+
   /*!
    * advances internal electric field x-component state by one time step
    * @param ea electric field a loop constant
    * @param eb electric field b loop constant
    */
   void update_ex(fp_t ea, fp_t eb) const;
+
+  /*!
+   * advances internal electric field x-component state within an index box by one time step
+   * @param ea electric field a loop constant
+   * @param eb electric field b loop constant
+   * @param lo lower corner of index box
+   * @param hi upper (exclusive) corner of index box
+   */
+  void update_ex(fp_t ea, fp_t eb, const std::array<ui_t, 3> &lo, const std::array<ui_t, 3> &hi) const;
   /*!
    * advances internal electric field y-component state by one time step
    * @param ea electric field a loop constant
@@ -153,6 +429,15 @@ struct World {
    */
   void update_ey(fp_t ea, fp_t eb) const;
 
+  /*!
+   * advances internal electric field y-component state within an index box by one time step
+   * @param ea electric field a loop constant
+   * @param eb electric field b loop constant
+   * @param lo lower corner of index box
+   * @param hi upper (exclusive) corner of index box
+   */
+  void update_ey(fp_t ea, fp_t eb, const std::array<ui_t, 3> &lo, const std::array<ui_t, 3> &hi) const;
+
   /*!
    * advances internal electric field z-component state by one time step
    * @param ea electric field a loop constant
@@ -160,6 +445,15 @@ struct World {
    */
   void update_ez(fp_t ea, fp_t eb) const;
 
+  /*!
+   * advances internal electric field z-component state within an index box by one time step
+   * @param ea electric field a loop constant
+   * @param eb electric field b loop constant
+   * @param lo lower corner of index box
+   * @param hi upper (exclusive) corner of index box
+   */
+  void update_ez(fp_t ea, fp_t eb, const std::array<ui_t, 3> &lo, const std::array<ui_t, 3> &hi) const;
+
   /*!
    * advances internal magnetic field x-component state by one time step
    * @param hya magnetic field a loop constant for y-component
@@ -167,6 +461,15 @@ struct World {
    */
   void update_hx(fp_t hya, fp_t hza) const;
 
+  /*!
+   * advances internal magnetic field x-component state within an index box by one time step
+   * @param hya magnetic field a loop constant for y-component
+   * @param hza magnetic field a loop constant for z-component
+   * @param lo lower corner of index box
+   * @param hi upper (exclusive) corner of index box
+   */
+  void update_hx(fp_t hya, fp_t hza, const std::array<ui_t, 3> &lo, const std::array<ui_t, 3> &hi) const;
+
   /*!
    * advances internal magnetic field y-component state by one time step
    * @param hxa magnetic field a loop constant for x-component
@@ -174,6 +477,15 @@ struct World {
    */
   void update_hy(fp_t hxa, fp_t hza) const;
 
+  /*!
+   * advances internal magnetic field y-component state within an index box by one time step
+   * @param hxa magnetic field a loop constant for x-component
+   * @param hza magnetic field a loop constant for z-component
+   * @param lo lower corner of index box
+   * @param hi upper (exclusive) corner of index box
+   */
+  void update_hy(fp_t hxa, fp_t hza, const std::array<ui_t, 3> &lo, const std::array<ui_t, 3> &hi) const;
+
   /*!
    * advances internal magnetic field z-component state by one time step
    * @param hxa magnetic field a loop constant for x-component
@@ -181,6 +493,374 @@ struct World {
    */
   void update_hz(fp_t hxa, fp_t hya) const;
 
+  /*!
+   * advances internal magnetic field z-component state within an index box by one time step
+   * @param hxa magnetic field a loop constant for x-component
+   * @param hya magnetic field a loop constant for y-component
+   * @param lo lower corner of index box
+   * @param hi upper (exclusive) corner of index box
+   */
+  void update_hz(fp_t hxa, fp_t hya, const std::array<ui_t, 3> &lo, const std::array<ui_t, 3> &hi) const;
+
+  /*!
+   * advances tangential electric fields on non-PEC faces by one time step
+   * @param ea electric field a loop constant
+   * @param eb electric field b loop constant
+   * @note runs after the internal kernels which never touch the outer shell
+   */
+  void update_e_boundary(fp_t ea, fp_t eb) const;
+
+  /*!
+   * advances electric fields on one face by one time step
+   * @param axis normal axis of face as {0, 1, 2} for {x, y, z}
+   * @param hi {true, false} for {high, low} face respectively
+   * @param ea electric field a loop constant
+   * @param eb electric field b loop constant
+   * @note edges shared by two non-PEC faces are owned by the face with the lower normal axis, faces of wrapping axes
+   * also own the normal component half a voxel inside of them which internal kernels skip
+   * @note voxelized objects and material volumes override ea and eb per node so materials reaching a face keep their
+   * loop constants on it
+   */
+  void update_e_face(ui_t axis, bool hi, fp_t ea, fp_t eb) const;
+
+  /*!
+   * copies the low electric field plane of each wrapping axis onto its high ghost plane with the Bloch phase applied
+   */
+  void update_e_ghosts() const;
+
+  /*!
+   * advances all particle species by one time step
+   * @param dt (s) time step
+   * @note particles are pushed in cache line sized batches so the pusher loop vectorizes
+   */
+  void push_particles(fp_t dt);
+
+  /*!
+   * shape function period of each axis
+   * @return number of voxels along each periodic axis and 0 along axes bounded by walls
+   * @note nodes at index nv_h of periodic axes are ghost copies of index 0 so both field layouts share one period
+   */
+  [[nodiscard]] std::array<ui_t, 3> shape_period() const noexcept;
+
+  /*!
+   * interpolates fields to a batch of particles with the configured shape order
+   * @param p particles
+   * @param first index of first particle in batch
+   * @param len number of particles in batch
+   * @param f fields at particle positions
+   */
+  void gather(const Particles &p, ui_t first, ui_t len, FieldBatch &f) const;
+
+  /*!
+   * interpolates fields to a batch of particles
+   * @tparam O shape order as {0, 1, 2, 3} for {NGP, CIC, TSC, cubic}
+   * @param p particles
+   * @param first index of first particle in batch
+   * @param len number of particles in batch
+   * @param f fields at particle positions
+   * @note reads stay within a few voxels of each other when particles are sorted by voxel
+   */
+  template <ui_t O> void gather_shape(const Particles &p, ui_t first, ui_t len, FieldBatch &f) const;
+
+  /*!
+   * gathers, pushes, and deposits particles [lo, hi) of a species in batches
+   * @param s species of particles
+   * @param lo index of first particle
+   * @param hi index one past the last particle
+   * @param qdt2m (C s / kg) charge * time step / (2 * mass)
+   * @param dt (s) time step
+   * @param tile tile-private current density to deposit into or nullptr to deposit into the shared current density
+   */
+  void push_range(const Species &s, ui_t lo, ui_t hi, fp_t qdt2m, fp_t dt, TileCurrent *tile = nullptr) const;
+
+  /*!
+   * gathers, pushes, and deposits the particles of one tile of a sorted species
+   * @param s species of particles
+   * @param t tile index
+   * @param qdt2m (C s / kg) charge * time step / (2 * mass)
+   * @param dt (s) time step
+   * @note the REDUCE strategy deposits into the tile-private buffer of the calling thread and flushes it afterwards
+   */
+  void push_tile(const Species &s, ui_t t, fp_t qdt2m, fp_t dt);
+
+  /*!
+   * repartitions tiles across threads by their measured push cost if thread times are imbalanced
+   * @note thread and tile timers are reset after every check
+   */
+  void rebalance();
+
+  /*!
+   * moves the window one voxel along x by shifting fields and particles and injecting plasma at the leading edge
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> shift_window();
+
+  /*!
+   * sorts all particle species by tile and voxel
+   */
+  void sort_particles();
+
+  /*!
+   * sorts particles of a species by tile and then by voxel within each tile with a parallel counting sort
+   * @param s species to sort
+   * @note particle columns are permuted one at a time through the spare column of the particle arena and tile
+   * offsets are updated for tile-wise processing
+   */
+  void sort_species(Species &s);
+
+  /*!
+   * rebuilds the list of active tiles from tile field energies and particle positions
+   */
+  void update_activity();
+
+  /*!
+   * clips an index box to a tile
+   * @param t tile index
+   * @param lo lower corner of index box
+   * @param hi upper (exclusive) corner of index box
+   * @return lower and upper (exclusive) corners of the clipped box, empty boxes have a corner with lo >= hi
+   * @note the last tile along each axis extends to the end of the box so field nodes past the last voxel are covered
+   */
+  [[nodiscard]] std::array<std::array<ui_t, 3>, 2> tile_box(ui_t t, const std::array<ui_t, 3> &lo,
+                                                            const std::array<ui_t, 3> &hi) const noexcept;
+
+  /*!
+   * runs a kernel over the parts of an index box that lie in active tiles
+   * @tparam F kernel type taking the lower and upper (exclusive) corners of a box
+   * @param lo lower corner of index box
+   * @param hi upper (exclusive) corner of index box
+   * @param f kernel
+   * @note the whole box is passed at once when the activity mask is disabled
+   */
+  template <typename F> void for_active(const std::array<ui_t, 3> &lo, const std::array<ui_t, 3> &hi, F &&f) const {
+    if (cfg.activity_period == 0) {
+      f(lo, hi);
+      return;
+    }
+
+    for (const ui_t t : active_tiles) {
+      const auto [a, b] = tile_box(t, lo, hi);
+      if (a[0] < b[0] && a[1] < b[1] && a[2] < b[2]) {
+        f(a, b);
+      }
+    }
+  }
+
+  /*!
+   * total number of particle tiles
+   * @return number of particle tiles
+   */
+  [[nodiscard]] ui_t num_tiles() const noexcept;
+
+  /*!
+   * sort key of a particle
+   * @param p particles
+   * @param n index of particle
+   * @return tile index times voxels per tile plus the voxel index within the tile
+   */
+  [[nodiscard]] ui_t sort_key(const Particles &p, ui_t n) const noexcept;
+
+  /*!
+   * corrects the electric field so it satisfies Gauss's law for the charge of all particles
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   * @note charge is weighted to the voxel nodes with the shape used by the current deposition and
+   * -laplacian(psi) = rho / ep - div(e) is solved with multigrid before e is replaced by e - grad(psi), starting from
+   * e = 0 this is the electrostatic field
+   */
+  [[nodiscard]] std::expected<void, std::string> solve_gauss();
+
+  /*!
+   * adds the charge of all particles scaled to rho / ep to the right hand side of the finest multigrid level
+   * @tparam O shape order as {0, 1, 2, 3} for {NGP, CIC, TSC, cubic}
+   */
+  template <ui_t O> void deposit_charge() const;
+
+  /*!
+   * collides the configured species with the background gas using the null-collision method
+   * @param dt (s) time step
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   * @note only the fraction 1 - exp(-nu_max dt) of particles is tested each step, elastic and excitation collisions
+   * scatter isotropically and ionization adds a secondary electron and optionally an ion at the primary position
+   */
+  [[nodiscard]] std::expected<void, std::string> collide(fp_t dt);
+
+  /*!
+   * end of the run of particles sharing the voxel of a particle in sorted order
+   * @param p particles
+   * @param lo index of first particle of the run
+   * @param hi index one past the last particle that may belong to the run
+   * @return index one past the last particle in the voxel of particle lo
+   */
+  [[nodiscard]] ui_t voxel_end(const Particles &p, ui_t lo, ui_t hi) const noexcept;
+
+  /*!
+   * collides configured pairs of species with binary Coulomb collisions in every voxel
+   * @param dt (s) time step
+   * @note pairs collide every period steps over period time steps using the scheme of Takizuka and Abe (1977) on the
+   * sorted layout, proper velocities are treated as velocities so collisions are non-relativistic
+   */
+  void coulomb_collide(fp_t dt);
+
+  /*!
+   * resamples all particle species
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   */
+  [[nodiscard]] std::expected<void, std::string> resample_particles();
+
+  /*!
+   * merges particles in crowded voxels and splits particles in sparse voxels of a species
+   * @param s species to resample
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   * @note voxels with more than merge_above particles are reduced to at most a pair per momentum octant, voxels with
+   * fewer than split_below particles are split up to split_below particles, charge, momentum, and energy are conserved
+   */
+  [[nodiscard]] std::expected<void, std::string> resample_species(Species &s);
+
+  /*!
+   * deposits the current of a batch of pushed particles with the configured shape order and strategy
+   * @param s species of particles
+   * @param first index of first particle in batch
+   * @param len number of particles in batch
+   * @param r0 (m) particle positions at the start of the step
+   * @param dt (s) time step
+   * @param tile tile-private current density to deposit into or nullptr to deposit into the shared current density
+   */
+  void deposit(const Species &s, ui_t first, ui_t len, const PositionBatch &r0, fp_t dt, TileCurrent *tile) const;
+
+  /*!
+   * deposits the current of a batch of pushed particles
+   * @tparam O shape order as {0, 1, 2, 3} for {NGP, CIC, TSC, cubic}
+   * @tparam ATOMIC {true, false} if the shared current density {is, is not} updated by concurrent threads
+   * @param tile tile-private current density to deposit into or nullptr to deposit into the shared current density
+   * @param s species of particles
+   * @param first index of first particle in batch
+   * @param len number of particles in batch
+   * @param r0 (m) particle positions at the start of the step
+   * @param dt (s) time step
+   * @note particles whose stencils leave the tile-private buffer are deposited into the shared current density with
+   * atomic updates
+   */
+  template <ui_t O, bool ATOMIC>
+  void deposit_shape(TileCurrent *tile, const Species &s, ui_t first, ui_t len, const PositionBatch &r0,
+                     fp_t dt) const;
+
+  /*!
+   * zeroes a current density buffer
+   * @param v (A/m^2) current density buffer
+   */
+  void zero_current(const Vector3<fp_t> &v) const;
+
+  /*!
+   * wraps particles across periodic axes, reflects them off PMC faces and removes particles that left through any
+   * other face
+   * @param s species of particles
+   * @note survivors keep their relative order but wrapping, reflection, and removal invalidate the sort of the species
+   */
+  void apply_particle_boundaries(Species &s);
+
+  /*!
+   * removes particles marked by a nonzero entry of sort_keys in parallel
+   * @param p particles whose marks fill the first p.num entries of sort_keys
+   * @note survivors keep their relative order so the permutation does not depend on the thread count
+   */
+  void compact_particles(Particles &p);
+
+  /*!
+   * swaps real and imaginary parts of Bloch fields so internal kernels can advance either
+   */
+  void swap_imaginary() noexcept;
+
+  /*!
+   * advances normal magnetic fields on high PMC faces by one time step
+   * @param hxa magnetic field a loop constant for x-component
+   * @param hya magnetic field a loop constant for y-component
+   * @param hza magnetic field a loop constant for z-component
+   */
+  void update_h_boundary(fp_t hxa, fp_t hya, fp_t hza) const;
+
+  /*!
+   * magnetic field component at an index that may lie one step outside of the stored field
+   * @param c component as {0, 1, 2} for {x, y, z}
+   * @param idx signed index
+   * @return (A/m) stored value, odd mirror across PMC faces or phase shifted wrap across Bloch faces for tangential
+   * components, or high face normal value
+   */
+  [[nodiscard]] std::complex<fp_t> h_at(ui_t c, std::array<si_t, 3> idx) const;
+
+  /*!
+   * advances internal 2D TE electric field state by one time step
+   * @param ea electric field a loop constant
+   * @param eb electric field b loop constant
+   */
+  void update_e_te(fp_t ea, fp_t eb) const;
+
+  /*!
+   * advances internal 2D TE magnetic field state by one time step
+   * @param hxa magnetic field a loop constant for x-component
+   * @param hya magnetic field a loop constant for y-component
+   */
+  void update_h_te(fp_t hxa, fp_t hya) const;
+
+  /*!
+   * advances internal 2D TM electric field state by one time step
+   * @param ea electric field a loop constant
+   * @param eb electric field b loop constant
+   */
+  void update_e_tm(fp_t ea, fp_t eb) const;
+
+  /*!
+   * advances internal 2D TM magnetic field state by one time step
+   * @param hxa magnetic field a loop constant for x-component
+   * @param hya magnetic field a loop constant for y-component
+   */
+  void update_h_tm(fp_t hxa, fp_t hya) const;
+
+  /*!
+   * advances internal 1D electric field state by one time step
+   * @param ea electric field a loop constant
+   * @param eb electric field b loop constant
+   */
+  void update_e_1d(fp_t ea, fp_t eb) const;
+
+  /*!
+   * advances internal 1D magnetic field state by one time step
+   * @param hxa magnetic field a loop constant for x-component
+   */
+  void update_h_1d(fp_t hxa) const;
+
+  /*!
+   * number of spatial dimensions resolved by the configured mode
+   * @return {3, 2, 1} for {3D, 2D or RZ, 1D} modes respectively
+   */
+  [[nodiscard]] ui_t rank() const noexcept;
+
+  /*!
+   * number of field points advanced every time step across all allocated components
+   * @return number of field points
+   */
+  [[nodiscard]] ui_t num_field_points() const noexcept;
+
+  /*!
+   * reduces the electromagnetic field energy of the configured mode
+   * @return (J) field energy
+   * @note the bounding box material weighs every voxel so the result tracks convergence rather than the exact energy
+   * of heterogeneous geometries
+   */
+  [[nodiscard]] fp_t field_energy() const;
+
+  /*!
+   * shrinks the time dimension of field datasets to the steps logged so far and records their number in the metadata
+   * @param num number of logged steps
+   * @note requires datasets set up for a run with early termination enabled
+   */
+  void truncate_logs(ui_t num) const;
+
+  /*!
+   * data handles of all six field components in {ex, ey, ez, hx, hy, hz} order
+   * @return data handles where components that are not allocated in the configured mode are nullptr
+   */
+  [[nodiscard]] std::array<const fp_t *, 6> field_data() const noexcept;
+
   /*!
    * logs runtime data to out
    *
@@ -188,8 +868,10 @@ struct World {
    *
    * @param hyperslab hyperslab index to write to
    * @param step current time step
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   * @note only failures of the ensemble output are reported so far
    */
-  void log(ui_t hyperslab, ui_t step) const;
+  [[nodiscard]] std::expected<void, std::string> log(ui_t hyperslab, ui_t step) const;
 
   /*!
    * logs metadata required for gen_xdmf.py
@@ -204,11 +886,13 @@ struct World {
 
   /*!
    * sets up output filesystem at out
+   * @param out output root directory
    * @param id unique identifier
    * @return std::expected<std::filesystem::path, std::string> for {success, error} cases respectively
    * @note std::filesystem::path is a path to a unique output folder which is used to store data from a given run
    */
-  [[nodiscard]] std::expected<std::filesystem::path, std::string> init_filesystem(const std::string &id) const noexcept;
+  [[nodiscard]] static std::expected<std::filesystem::path, std::string>
+  init_filesystem(const std::filesystem::path &out, const std::string &id) noexcept;
 
   /*!
    * sets up dataspaces for logging
@@ -225,8 +909,28 @@ struct World {
    * todo improve error handling
    *
    * @param group group to create datasets within
+   * @return std::expected<void, std::string> for {success, error} cases respectively
+   * @note only failures of the ensemble output are reported so far
+   */
+  [[nodiscard]] std::expected<void, std::string> setup_datasets(const HDF5Obj &group);
+
+  /*!
+   * creates extendible particle diagnostic datasets of every species
+   *
+   * todo improve error handling
+   *
+   * @param group group to create datasets within
+   */
+  void setup_particle_datasets(const HDF5Obj &group);
+
+  /*!
+   * appends sub-sampled particles and weighted x-ux and energy histograms of every species
+   *
+   * todo improve error handling
+   *
+   * @param step number of steps taken since the start of the run
    */
-  void setup_datasets(const HDF5Obj &group);
+  void log_particles(ui_t step) const;
 };
 
 #endif // CORE_WORLD_H
@@ -22,6 +22,7 @@
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/spdlog.h>
 
+#include "sweep.h"
 #include "world.h"
 
 /*!
@@ -66,17 +67,26 @@ int main(const int argc, char **argv) {
 
   const auto id = fmt::format("{:%Y-%m-%d_%H:%M:%S}", start_time);
 
-  std::unique_ptr<World> world;
-  try {
-    world = std::make_unique<World>(argv[1], id);
-  } catch (const std::exception &err) {
-    SPDLOG_CRITICAL("failed to configure World object: {}", err.what());
+  Sweep sweep;
+  if (const auto result = sweep.init(argv[1], id); !result.has_value()) {
+    SPDLOG_CRITICAL("failed to configure sweep: {}", result.error());
     return EXIT_FAILURE;
   }
 
+  // input decks without a `[sweep]` table describe a single run
+  const auto world = std::make_unique<World>();
+  if (sweep.runs.empty()) {
+    if (const auto result = world->init(argv[1], id); !result.has_value()) {
+      SPDLOG_CRITICAL("failed to configure World object: {}", result.error());
+      return EXIT_FAILURE;
+    }
+  }
+
+  const auto output_dir = sweep.runs.empty() ? world->get_output_dir() : sweep.io_dir;
+
 #if SPDLOG_ACTIVE_LEVEL < SPDLOG_LEVEL_OFF
   try {
-    const auto log_dir = world->get_output_dir() / "log";
+    const auto log_dir = output_dir / "log";
 
     std::filesystem::rename(tmp_log_dir, log_dir);
     SPDLOG_DEBUG("moved {} to {}", tmp_log_dir.string(), log_dir.string());
@@ -90,7 +100,7 @@ int main(const int argc, char **argv) {
 
   } catch (const std::filesystem::filesystem_error &err) {
     SPDLOG_CRITICAL("unable to move `{}` directory to `{}`: {}", tmp_log_dir.string(),
-                    (world->get_output_dir() / "log").string(), err.what());
+                    (output_dir / "log").string(), err.what());
     return EXIT_FAILURE;
   }
 
@@ -101,7 +111,7 @@ int main(const int argc, char **argv) {
   SPDLOG_INFO("begin EPPIC run");
 #endif
 
-  if (const auto result = world->run(); !result.has_value()) {
+  if (const auto result = sweep.runs.empty() ? world->run() : sweep.run(); !result.has_value()) {
     SPDLOG_CRITICAL("EPPIC run failed: {}", result.error());
     return EXIT_FAILURE;
   }